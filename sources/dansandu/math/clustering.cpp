@@ -4,20 +4,24 @@
 
 #include <algorithm>
 #include <limits>
+#include <numeric>
 #include <random>
 
+using dansandu::math::matrix::balanceCompressedRanges;
 using dansandu::math::matrix::ConstantMatrixView;
+using dansandu::math::matrix::CsrMatrix;
 using dansandu::math::matrix::distance;
 using dansandu::math::matrix::dynamic;
 using dansandu::math::matrix::Matrix;
 using dansandu::math::matrix::MatrixView;
 using dansandu::math::matrix::sliceRow;
+using dansandu::math::matrix::sparseParallelThreshold;
+using dansandu::math::thread_pool::Executor;
 
 namespace dansandu::math::clustering
 {
 
-std::vector<int> kMeans(const ConstantMatrixView<float> samples, const MatrixView<float> centroids,
-                        const int iterations)
+static void validateCentroids(const MatrixView<float> centroids, const int sampleColumns)
 {
     if (centroids.rowCount() <= 0)
     {
@@ -25,11 +29,17 @@ std::vector<int> kMeans(const ConstantMatrixView<float> samples, const MatrixVie
               " -- centroids row count must be greater than zero");
     }
 
-    if (centroids.columnCount() != samples.columnCount())
+    if (centroids.columnCount() != sampleColumns)
     {
         THROW(std::invalid_argument, "centroids column count ", centroids.columnCount(),
-              " does not match samples column count ", samples.columnCount());
+              " does not match samples column count ", sampleColumns);
     }
+}
+
+std::vector<int> kMeans(const ConstantMatrixView<float> samples, const MatrixView<float> centroids,
+                        const int iterations)
+{
+    validateCentroids(centroids, samples.columnCount());
 
     auto labels = std::vector<int>(samples.rowCount());
     auto newCentroids = Matrix<float>{centroids.rowCount(), centroids.columnCount()};
@@ -65,4 +75,141 @@ std::vector<int> kMeans(const ConstantMatrixView<float> samples, const MatrixVie
     return labels;
 }
 
+std::vector<int> kMeans(const CsrMatrix<float>& samples, const MatrixView<float> centroids, const int iterations,
+                        const Executor& executor)
+{
+    validateCentroids(centroids, samples.columnCount());
+
+    const auto& offsets = samples.offsets();
+    const auto& indices = samples.indices();
+    const auto& values = samples.values();
+    const auto clusters = centroids.rowCount();
+    const auto dimensions = centroids.columnCount();
+    const auto sampleCount = samples.rowCount();
+
+    const auto multiplyAdds = static_cast<long long>(samples.nonZeroCount()) * clusters;
+    const auto threads = multiplyAdds < sparseParallelThreshold ? 1 : executor.threadCount();
+    const auto ranges = balanceCompressedRanges(offsets, 4 * threads);
+    const auto rangeCount = static_cast<int>(ranges.size()) - 1;
+    const auto run = [&](int tasks, const auto& task)
+    {
+        if (threads == 1)
+        {
+            for (auto index = 0; index < tasks; ++index)
+            {
+                task(index);
+            }
+        }
+        else
+        {
+            executor.parallelFor(tasks, task);
+        }
+    };
+
+    auto sampleNorms = std::vector<float>(sampleCount);
+    run(rangeCount,
+        [&](int range)
+        {
+            for (auto s = ranges[range]; s < ranges[range + 1]; ++s)
+            {
+                auto norm = 0.0f;
+                for (auto position = offsets[s]; position < offsets[s + 1]; ++position)
+                {
+                    norm += values[position] * values[position];
+                }
+                sampleNorms[s] = norm;
+            }
+        });
+
+    // The centroids are transposed so that the dot products of a sample with all of them accumulate over contiguous
+    // rows, one per non-zero of the sample.
+    auto transposedCentroids = Matrix<float>{dimensions, clusters, dansandu::math::matrix::uninitialized};
+    auto centroidNorms = std::vector<float>(clusters);
+    auto labels = std::vector<int>(sampleCount);
+    auto members = std::vector<int>(sampleCount);
+    auto firstMembers = std::vector<int>(clusters + 1);
+    for (auto iteration = 0; iteration < iterations; ++iteration)
+    {
+        for (auto c = 0; c < clusters; ++c)
+        {
+            auto norm = 0.0f;
+            for (auto d = 0; d < dimensions; ++d)
+            {
+                const auto value = centroids.unsafeSubscript(c, d);
+                transposedCentroids.unsafeSubscript(d, c) = value;
+                norm += value * value;
+            }
+            centroidNorms[c] = norm;
+        }
+
+        run(rangeCount,
+            [&](int range)
+            {
+                auto dots = std::vector<float>(clusters);
+                for (auto s = ranges[range]; s < ranges[range + 1]; ++s)
+                {
+                    std::fill(dots.begin(), dots.end(), 0.0f);
+                    for (auto position = offsets[s]; position < offsets[s + 1]; ++position)
+                    {
+                        const auto value = values[position];
+                        const auto row = transposedCentroids.data() + indices[position] * clusters;
+                        for (auto c = 0; c < clusters; ++c)
+                        {
+                            dots[c] += value * row[c];
+                        }
+                    }
+                    auto label = 0;
+                    auto minimumDistance = std::numeric_limits<float>::max();
+                    for (auto c = 0; c < clusters; ++c)
+                    {
+                        const auto d = sampleNorms[s] - 2.0f * dots[c] + centroidNorms[c];
+                        if (d < minimumDistance)
+                        {
+                            label = c;
+                            minimumDistance = d;
+                        }
+                    }
+                    labels[s] = label;
+                }
+            });
+
+        // The samples are grouped by label so that every centroid is recomputed by a single task from its own
+        // members, which needs no private copies of the centroids.
+        std::fill(firstMembers.begin(), firstMembers.end(), 0);
+        for (const auto label : labels)
+        {
+            ++firstMembers[label + 1];
+        }
+        std::partial_sum(firstMembers.cbegin(), firstMembers.cend(), firstMembers.begin());
+        auto next = std::vector<int>(firstMembers.cbegin(), firstMembers.cend() - 1);
+        for (auto s = 0; s < sampleCount; ++s)
+        {
+            members[next[labels[s]]++] = s;
+        }
+
+        run(clusters,
+            [&](int c)
+            {
+                const auto count = firstMembers[c + 1] - firstMembers[c];
+                if (count == 0)
+                {
+                    return;
+                }
+                auto centroid = sliceRow(centroids, c);
+                std::fill(centroid.begin(), centroid.end(), 0.0f);
+                for (auto member = firstMembers[c]; member < firstMembers[c + 1]; ++member)
+                {
+                    const auto s = members[member];
+                    for (auto position = offsets[s]; position < offsets[s + 1]; ++position)
+                    {
+                        centroid.unsafeSubscript(0, indices[position]) += values[position];
+                    }
+                }
+                centroid /= static_cast<float>(count);
+            });
+    }
+
+    return labels;
+}
+
 }
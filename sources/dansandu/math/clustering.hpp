@@ -1,6 +1,7 @@
 #pragma once
 
 #include "dansandu/math/matrix.hpp"
+#include "dansandu/math/thread_pool.hpp"
 
 #include <vector>
 
@@ -10,4 +11,13 @@ namespace dansandu::math::clustering
 PRALINE_EXPORT std::vector<int> kMeans(const dansandu::math::matrix::ConstantMatrixView<float> samples,
                                        const dansandu::math::matrix::MatrixView<float> centroids, const int iterations);
 
+// Clusters the rows of a sparse sample matrix around dense centroids. Distances are expanded as |x|^2 - 2 x.c + |c|^2,
+// so an iteration costs the number of non-zeros times the cluster count plus a pass over the centroids instead of the
+// number of samples times the dimensions. Samples are assigned and centroids recomputed on the executor threads. A
+// centroid that attracts no samples keeps its position.
+PRALINE_EXPORT std::vector<int>
+kMeans(const dansandu::math::matrix::CsrMatrix<float>& samples,
+       const dansandu::math::matrix::MatrixView<float> centroids, const int iterations,
+       const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{});
+
 }
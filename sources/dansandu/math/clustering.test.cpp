@@ -1,12 +1,20 @@
 #include "dansandu/math/clustering.hpp"
 #include "catchorg/catch/catch.hpp"
 #include "dansandu/math/matrix.hpp"
+#include "dansandu/math/thread_pool.hpp"
 #include "dansandu/range/range.hpp"
 
+#include <random>
+#include <vector>
+
 using dansandu::math::clustering::kMeans;
 using dansandu::math::matrix::close;
+using dansandu::math::matrix::CsrMatrix;
 using dansandu::math::matrix::Matrix;
 using dansandu::math::matrix::sliceRow;
+using dansandu::math::matrix::Triplet;
+using dansandu::math::thread_pool::Executor;
+using dansandu::math::thread_pool::ThreadPool;
 
 using namespace dansandu::range::range;
 
@@ -46,4 +54,52 @@ TEST_CASE("clustering")
 
         REQUIRE(close(expectedCentroids, centroids, epsilon));
     }
+
+    SECTION("sparse k-means")
+    {
+        // Every cluster lives on its own block of dimensions, which all of its samples share the first of, so the
+        // clusters are far apart while each sample sets only a few of the dimensions of its block.
+        const auto clusters = 4;
+        const auto samplesPerCluster = 500;
+        const auto blockDimensions = 40;
+        auto generator = std::minstd_rand{3};
+        auto dimension = std::uniform_int_distribution<int>{0, blockDimensions - 1};
+        auto value = std::uniform_real_distribution<float>{1.0f, 2.0f};
+        auto triplets = std::vector<Triplet<float>>{};
+        auto expectedLabels = std::vector<int>{};
+        for (auto sample = 0; sample < clusters * samplesPerCluster; ++sample)
+        {
+            const auto cluster = sample % clusters;
+            triplets.push_back({sample, cluster * blockDimensions, 5.0f});
+            for (auto nonZero = 0; nonZero < 4; ++nonZero)
+            {
+                triplets.push_back({sample, cluster * blockDimensions + dimension(generator), value(generator)});
+            }
+            expectedLabels.push_back(cluster);
+        }
+        const auto samples = CsrMatrix<float>{clusters * samplesPerCluster, clusters * blockDimensions, triplets};
+        const auto denseSamples = samples.toDense();
+        auto sparseCentroids = Matrix<float>{clusters, clusters * blockDimensions, 0.0f};
+        for (auto cluster = 0; cluster < clusters; ++cluster)
+        {
+            sliceRow(sparseCentroids, cluster).deepCopy(sliceRow(denseSamples, cluster));
+        }
+        auto denseCentroids = sparseCentroids;
+
+        auto pool = ThreadPool{4};
+        const auto labels = kMeans(samples, sparseCentroids, 5, Executor{pool, 4});
+
+        REQUIRE(labels == expectedLabels);
+
+        REQUIRE(kMeans(denseSamples, denseCentroids, 5) == expectedLabels);
+
+        REQUIRE(close(sparseCentroids, denseCentroids, 1.0e-5f));
+
+        auto emptyCluster = Matrix<float>{{{1.0f, 1.0f}, {100.0f, 100.0f}}};
+
+        REQUIRE(kMeans(CsrMatrix<float>{Matrix<float>{{{1.0f, 0.0f}, {0.0f, 1.0f}}}}, emptyCluster, 2) ==
+                std::vector<int>{0, 0});
+
+        REQUIRE(close(emptyCluster, Matrix<float>{{{0.5f, 0.5f}, {100.0f, 100.0f}}}, 1.0e-6f));
+    }
 }
@@ -25,6 +25,15 @@ struct Subtract
     }
 };
 
+struct Negate
+{
+    template<typename A>
+    constexpr auto operator()(A&& a) const
+    {
+        return -std::forward<A>(a);
+    }
+};
+
 struct Multiply
 {
     template<typename A, typename B>
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "dansandu/math/internal/matrix/arena.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dansandu::math::matrix
+{
+
+constexpr auto cacheLineBytes = static_cast<std::size_t>(64);
+
+// Allocates on cache line boundaries so that vector loads from the start of a row never straddle two lines. The
+// allocator captures the arena of the current thread when it is created and keeps drawing from it, so a matrix built
+// inside an arena scope lives in the arena, while copies take the arena current at the time of the copy.
+template<typename T>
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    AlignedAllocator() noexcept : arena_{getCurrentArena()}
+    {
+    }
+
+    explicit AlignedAllocator(Arena* arena) noexcept : arena_{arena}
+    {
+    }
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U>& other) noexcept : arena_{other.arena()}
+    {
+    }
+
+    T* allocate(std::size_t count)
+    {
+        if (arena_)
+        {
+            return static_cast<T*>(arena_->allocate(count * sizeof(T), static_cast<std::size_t>(alignment)));
+        }
+        return static_cast<T*>(::operator new(count * sizeof(T), alignment));
+    }
+
+    void deallocate(T* pointer, std::size_t count)
+    {
+        if (arena_)
+        {
+            arena_->deallocate(pointer, count * sizeof(T));
+        }
+        else
+        {
+            ::operator delete(pointer, alignment);
+        }
+    }
+
+    // Default-inserted elements are default-initialized rather than value-initialized, which leaves arithmetic types
+    // unwritten until the storage is filled.
+    template<typename U>
+    void construct(U* pointer) noexcept(std::is_nothrow_default_constructible_v<U>)
+    {
+        ::new (static_cast<void*>(pointer)) U;
+    }
+
+    template<typename U, typename... Arguments>
+    void construct(U* pointer, Arguments&&... arguments)
+    {
+        ::new (static_cast<void*>(pointer)) U(std::forward<Arguments>(arguments)...);
+    }
+
+    AlignedAllocator select_on_container_copy_construction() const
+    {
+        return AlignedAllocator{};
+    }
+
+    Arena* arena() const
+    {
+        return arena_;
+    }
+
+private:
+    static constexpr auto alignment = std::align_val_t{alignof(T) > cacheLineBytes ? alignof(T) : cacheLineBytes};
+
+    Arena* arena_;
+};
+
+template<typename T, typename U>
+bool operator==(const AlignedAllocator<T>& a, const AlignedAllocator<U>& b)
+{
+    return a.arena() == b.arena();
+}
+
+template<typename T, typename U>
+bool operator!=(const AlignedAllocator<T>& a, const AlignedAllocator<U>& b)
+{
+    return a.arena() != b.arena();
+}
+
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Rounds the row length up to whole cache lines, adding one more line when rows would start at a multiple of 4K
+// apart, since loads from consecutive rows would then alias in the L1 cache and the store forwarding logic.
+template<typename T>
+size_type getPaddedLeadingDimension(size_type columns)
+{
+    if (cacheLineBytes % sizeof(T) != 0)
+    {
+        return columns;
+    }
+
+    const auto lineLength = static_cast<size_type>(cacheLineBytes / sizeof(T));
+    auto leadingDimension = (columns + lineLength - 1) / lineLength * lineLength;
+    if (leadingDimension > 0 && leadingDimension * sizeof(T) % 4096 == 0)
+    {
+        leadingDimension += lineLength;
+    }
+    return leadingDimension;
+}
+
+}
@@ -0,0 +1,89 @@
+#include "dansandu/math/internal/matrix/arena.hpp"
+#include "dansandu/math/internal/matrix/aligned_allocator.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace dansandu::math::matrix
+{
+
+static thread_local Arena* currentArena = nullptr;
+
+Arena::Arena(std::size_t capacity) : offset_{0}, used_{0}, capacity_{0}
+{
+    pushBlock(std::max<std::size_t>(capacity, cacheLineBytes));
+}
+
+Arena::~Arena()
+{
+    releaseBlocks();
+}
+
+void* Arena::allocate(std::size_t bytes, std::size_t alignment)
+{
+    auto& block = blocks_.back();
+    auto start = (offset_ + alignment - 1) / alignment * alignment;
+    if (start + bytes > block.size)
+    {
+        used_ += offset_;
+        pushBlock(std::max(block.size * 2, bytes + alignment));
+        start = 0;
+    }
+    offset_ = start + bytes;
+    return blocks_.back().memory + start;
+}
+
+void Arena::deallocate(void* pointer, std::size_t bytes)
+{
+    const auto top = blocks_.back().memory + offset_;
+    if (static_cast<std::byte*>(pointer) + bytes == top)
+    {
+        offset_ = static_cast<std::size_t>(static_cast<std::byte*>(pointer) - blocks_.back().memory);
+    }
+}
+
+void Arena::reset()
+{
+    if (blocks_.size() > 1)
+    {
+        const auto capacity = capacity_;
+        releaseBlocks();
+        pushBlock(capacity);
+    }
+    offset_ = 0;
+    used_ = 0;
+}
+
+void Arena::pushBlock(std::size_t size)
+{
+    const auto memory = static_cast<std::byte*>(::operator new(size, std::align_val_t{cacheLineBytes}));
+    blocks_.push_back({memory, size});
+    capacity_ += size;
+}
+
+void Arena::releaseBlocks()
+{
+    for (const auto& block : blocks_)
+    {
+        ::operator delete(block.memory, std::align_val_t{cacheLineBytes});
+    }
+    blocks_.clear();
+    capacity_ = 0;
+}
+
+ArenaScope::ArenaScope(Arena& arena) : previous_{currentArena}
+{
+    currentArena = &arena;
+}
+
+ArenaScope::~ArenaScope()
+{
+    currentArena = previous_;
+}
+
+Arena* getCurrentArena()
+{
+    return currentArena;
+}
+
+}
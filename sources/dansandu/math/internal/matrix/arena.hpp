@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace dansandu::math::matrix
+{
+
+// Hands out memory by bumping an offset into large blocks so that the short-lived matrices of a request cost no calls
+// to the global allocator. Freeing the most recent allocation rolls the offset back, every other free is deferred
+// until the arena is reset. After a reset that needed more than one block the blocks are merged into a single one
+// large enough for the whole previous request.
+class PRALINE_EXPORT Arena
+{
+public:
+    explicit Arena(std::size_t capacity = 1 << 20);
+
+    Arena(const Arena&) = delete;
+
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena();
+
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    void deallocate(void* pointer, std::size_t bytes);
+
+    // Releases every allocation at once. Matrices allocated from the arena must not be used afterwards.
+    void reset();
+
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    std::size_t used() const
+    {
+        return used_ + offset_;
+    }
+
+private:
+    struct Block
+    {
+        std::byte* memory;
+        std::size_t size;
+    };
+
+    void pushBlock(std::size_t size);
+
+    void releaseBlocks();
+
+    std::vector<Block> blocks_;
+    std::size_t offset_;
+    std::size_t used_;
+    std::size_t capacity_;
+};
+
+// Makes heap matrices constructed on the current thread take their storage from the arena while the scope is alive.
+// Scopes nest and restore the previous arena on destruction. A matrix keeps the allocator it was created with, so
+// assigning an arena temporary to a matrix created outside the scope copies the elements out of the arena.
+class PRALINE_EXPORT ArenaScope
+{
+public:
+    explicit ArenaScope(Arena& arena);
+
+    ArenaScope(const ArenaScope&) = delete;
+
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    ~ArenaScope();
+
+private:
+    Arena* previous_;
+};
+
+// Returns the arena of the innermost scope alive on the current thread or nullptr if there is none.
+PRALINE_EXPORT Arena* getCurrentArena();
+
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/matrix.hpp"
+#include "dansandu/math/internal/matrix/slicer.hpp"
+#include "dansandu/math/internal/matrix/trsm.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+namespace dansandu::math::matrix
+{
+
+// Columns are factored in blocks of this width. The block column below is solved with trsm and the trailing matrix
+// is updated with gemm.
+constexpr auto choleskyBlock = 64;
+
+// The lower triangular factor of A = L * L'.
+template<typename T>
+struct CholeskyDecomposition
+{
+    Matrix<T> lower;
+};
+
+// Factors the diagonal block [k, k + width) in place by the unblocked algorithm.
+template<typename T>
+void factorCholeskyBlock(const MatrixView<T> a, size_type k, size_type width)
+{
+    for (auto j = k; j < k + width; ++j)
+    {
+        auto diagonal = a.unsafeSubscript(j, j);
+        for (auto p = k; p < j; ++p)
+        {
+            diagonal -= a.unsafeSubscript(j, p) * a.unsafeSubscript(j, p);
+        }
+        if (!(diagonal > dansandu::math::common::additiveIdentity<T>))
+        {
+            THROW(std::logic_error, "cannot Cholesky decompose a ", a.rowCount(), "x", a.columnCount(),
+                  " matrix -- the matrix is not positive definite (pivot ", j, " is ", diagonal, ")");
+        }
+        diagonal = std::sqrt(diagonal);
+        a.unsafeSubscript(j, j) = diagonal;
+
+        for (auto i = j + 1; i < k + width; ++i)
+        {
+            auto sum = a.unsafeSubscript(i, j);
+            for (auto p = k; p < j; ++p)
+            {
+                sum -= a.unsafeSubscript(i, p) * a.unsafeSubscript(j, p);
+            }
+            a.unsafeSubscript(i, j) = sum / diagonal;
+        }
+    }
+}
+
+// Overwrites the symmetric positive-definite matrix with its lower Cholesky factor and zeroes the strict upper
+// triangle. Only the lower triangle of the input is read. The factorization is right-looking: after each diagonal
+// block, the block column below it is solved with trsm and the lower half of the trailing matrix is updated one block
+// column at a time with gemm, which is where nearly all the work is and what runs on the executor threads. Throws
+// std::logic_error if the matrix is not positive definite.
+template<typename T>
+void choleskyDecomposeInPlace(const MatrixView<T> a,
+                              const dansandu::math::thread_pool::Executor& executor =
+                                  dansandu::math::thread_pool::Executor{})
+{
+    static_assert(std::is_floating_point_v<T>, "Cholesky decomposition requires floating point matrices");
+
+    const auto n = a.rowCount();
+    if (a.columnCount() != n)
+    {
+        THROW(std::logic_error, "cannot Cholesky decompose a ", a.rowCount(), "x", a.columnCount(),
+              " matrix -- the matrix must be square");
+    }
+
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    for (auto k = 0; k < n; k += choleskyBlock)
+    {
+        const auto width = std::min(choleskyBlock, n - k);
+        factorCholeskyBlock(a, k, width);
+
+        const auto trailing = n - k - width;
+        if (trailing > 0)
+        {
+            const auto l21 = unsafeSlice(a, k + width, k, trailing, width);
+            trsm(Side::right, Triangle::lower, Transposition::transposed, Diagonal::nonUnit, one,
+                 unsafeSlice(a, k, k, width, width), l21, executor);
+            for (auto j = 0; j < trailing; j += choleskyBlock)
+            {
+                const auto columns = std::min(choleskyBlock, trailing - j);
+                gemm(-one, unsafeSlice(l21, j, 0, trailing - j, width), Transposition::none,
+                     unsafeSlice(l21, j, 0, columns, width), Transposition::transposed, one,
+                     unsafeSlice(a, k + width + j, k + width + j, trailing - j, columns), executor);
+            }
+        }
+    }
+
+    for (auto i = 0; i < n; ++i)
+    {
+        for (auto j = i + 1; j < n; ++j)
+        {
+            a.unsafeSubscript(i, j) = dansandu::math::common::additiveIdentity<T>;
+        }
+    }
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+CholeskyDecomposition<T> choleskyDecompose(const MatrixImplementation<T, M, N, S>& a,
+                                           const dansandu::math::thread_pool::Executor& executor =
+                                               dansandu::math::thread_pool::Executor{})
+{
+    auto lower = Matrix<T>{a};
+    choleskyDecomposeInPlace<T>(lower, executor);
+    return {std::move(lower)};
+}
+
+// Solves L * L' * x = b for every column of b at once and overwrites b with x, where lower is a factor produced by
+// choleskyDecompose or choleskyDecomposeInPlace.
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+void choleskySolveInPlace(const MatrixImplementation<T, M, N, S>& lower, const MatrixView<std::common_type_t<T>> b,
+                          const dansandu::math::thread_pool::Executor& executor =
+                              dansandu::math::thread_pool::Executor{})
+{
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    trsm(Side::left, Triangle::lower, Transposition::none, Diagonal::nonUnit, one, lower, b, executor);
+    trsm(Side::left, Triangle::lower, Transposition::transposed, Diagonal::nonUnit, one, lower, b, executor);
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+Matrix<T> solve(const CholeskyDecomposition<T>& cholesky, const MatrixImplementation<T, M, N, S>& b,
+                const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    auto x = Matrix<T>{b};
+    choleskySolveInPlace(cholesky.lower, x, executor);
+    return x;
+}
+
+}
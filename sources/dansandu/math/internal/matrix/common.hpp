@@ -11,10 +11,61 @@ enum class DataStorageStrategy
 {
     stack,
     heap,
+    smallBuffer,
+    columnMajorHeap,
     view,
     constantView
 };
 
+// The order in which the elements of a matrix are laid out in memory. Views of either layout are expressed through
+// their row and column strides, so they can be converted into one another without copying.
+enum class Layout
+{
+    rowMajor,
+    columnMajor
+};
+
+// Padding::cacheLine rounds the row stride of heap matrices up to whole cache lines.
+enum class Padding
+{
+    none,
+    cacheLine
+};
+
+// Tags the constructors that leave the elements unspecified, for results that are written in full right afterwards.
+// Large heap matrices then skip a pass over memory and their pages are first touched by the kernel writing them.
+struct Uninitialized
+{
+};
+
+constexpr auto uninitialized = Uninitialized{};
+
+enum class Transposition
+{
+    none,
+    transposed
+};
+
+// Selects the operand side and the triangle of the triangular solves and factorizations. Diagonal::unit treats the
+// diagonal as all ones without reading it, which lets the unit lower factor share storage with another factor.
+enum class Side
+{
+    left,
+    right
+};
+
+enum class Triangle
+{
+    lower,
+    upper
+};
+
+enum class Diagonal
+{
+    nonUnit,
+    unit
+};
+
 template<typename T, size_type M, size_type N, DataStorageStrategy S>
 class DataStorage;
 
@@ -40,12 +91,19 @@ constexpr auto vectorsOfEqualLength(const MatrixImplementation<T, M, N, S>& a,
 
 constexpr auto isContainer(DataStorageStrategy strategy)
 {
-    return strategy == DataStorageStrategy::stack || strategy == DataStorageStrategy::heap;
+    return strategy == DataStorageStrategy::stack || strategy == DataStorageStrategy::heap ||
+           strategy == DataStorageStrategy::smallBuffer || strategy == DataStorageStrategy::columnMajorHeap;
 }
 
 constexpr auto isHeapContainer(DataStorageStrategy strategy)
 {
-    return strategy == DataStorageStrategy::heap;
+    return strategy == DataStorageStrategy::heap || strategy == DataStorageStrategy::smallBuffer ||
+           strategy == DataStorageStrategy::columnMajorHeap;
+}
+
+constexpr auto isColumnMajor(DataStorageStrategy strategy)
+{
+    return strategy == DataStorageStrategy::columnMajorHeap;
 }
 
 constexpr auto isView(DataStorageStrategy strategy)
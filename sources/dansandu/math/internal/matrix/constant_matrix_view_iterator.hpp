@@ -12,7 +12,7 @@ class ConstantMatrixViewIterator
 {
     friend bool operator==(ConstantMatrixViewIterator left, ConstantMatrixViewIterator right)
     {
-        return left.getSourcePosition() == right.getSourcePosition();
+        return left.viewBegin_ == right.viewBegin_ && left.viewIndex_ == right.viewIndex_;
     }
 
 public:
@@ -26,30 +26,51 @@ public:
         : viewBegin_{iterator.viewBegin_},
           viewIndex_{iterator.viewIndex_},
           viewColumnCount_{iterator.viewColumnCount_},
-          sourceColumnCount_{iterator.sourceColumnCount_}
+          rowStride_{iterator.rowStride_},
+          columnStride_{iterator.columnStride_},
+          position_{iterator.position_},
+          column_{iterator.column_}
     {
     }
 
-    ConstantMatrixViewIterator(pointer viewBegin, difference_type viewColumnCount, difference_type sourceColumnCount)
-        : viewBegin_{viewBegin}, viewIndex_{0}, viewColumnCount_{viewColumnCount}, sourceColumnCount_{sourceColumnCount}
+    ConstantMatrixViewIterator(pointer viewBegin, difference_type viewColumnCount, difference_type rowStride,
+                               difference_type columnStride)
+        : viewBegin_{viewBegin},
+          viewIndex_{0},
+          viewColumnCount_{viewColumnCount},
+          rowStride_{rowStride},
+          columnStride_{columnStride},
+          position_{viewBegin},
+          column_{0}
     {
     }
 
     auto& operator+=(size_type n)
     {
         viewIndex_ += n;
+        seek();
         return *this;
     }
 
     auto& operator-=(size_type n)
     {
         viewIndex_ -= n;
+        seek();
         return *this;
     }
 
     auto& operator++()
     {
         viewIndex_ += 1;
+        if (++column_ == viewColumnCount_)
+        {
+            column_ = 0;
+            position_ += rowStride_ - (viewColumnCount_ - 1) * columnStride_;
+        }
+        else
+        {
+            position_ += columnStride_;
+        }
         return *this;
     }
 
@@ -63,6 +84,16 @@ public:
     auto& operator--()
     {
         viewIndex_ -= 1;
+        if (column_ == 0)
+        {
+            column_ = viewColumnCount_ - 1;
+            position_ -= rowStride_ - (viewColumnCount_ - 1) * columnStride_;
+        }
+        else
+        {
+            --column_;
+            position_ -= columnStride_;
+        }
         return *this;
     }
 
@@ -75,24 +106,32 @@ public:
 
     const auto& operator*() const
     {
-        return *getSourcePosition();
+        return *position_;
     }
 
     auto operator->() const
     {
-        return getSourcePosition();
+        return position_;
     }
 
 private:
-    auto getSourcePosition() const
+    // Steps and dereferences only move the cached position, which is recomputed from the index after jumps.
+    void seek()
     {
-        return viewBegin_ + (viewIndex_ / viewColumnCount_) * sourceColumnCount_ + viewIndex_ % viewColumnCount_;
+        if (viewColumnCount_ != 0)
+        {
+            column_ = viewIndex_ % viewColumnCount_;
+            position_ = viewBegin_ + (viewIndex_ / viewColumnCount_) * rowStride_ + column_ * columnStride_;
+        }
     }
 
     pointer viewBegin_;
     difference_type viewIndex_;
     difference_type viewColumnCount_;
-    difference_type sourceColumnCount_;
+    difference_type rowStride_;
+    difference_type columnStride_;
+    pointer position_;
+    difference_type column_;
 };
 
 template<typename T>
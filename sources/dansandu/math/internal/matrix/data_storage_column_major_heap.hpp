@@ -0,0 +1,187 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/constant_matrix_view_iterator.hpp"
+#include "dansandu/math/internal/matrix/data_storage_heap.hpp"
+#include "dansandu/math/internal/matrix/matrix_view_iterator.hpp"
+
+#include <vector>
+
+namespace dansandu::math::matrix
+{
+
+// Stores an M x N matrix column by column as the row-major heap storage of its N x M transpose. Iteration still visits
+// the elements row by row so that column-major matrices compare, print and convert like any other matrix.
+template<typename T, size_type M, size_type N>
+class DataStorage<T, M, N, DataStorageStrategy::columnMajorHeap>
+{
+public:
+    using iterator = MatrixViewIterator<T>;
+    using const_iterator = ConstantMatrixViewIterator<T>;
+
+    DataStorage() = default;
+
+    template<size_type L, typename = std::enable_if_t<isVectorOfLength(M, N, L)>>
+    explicit DataStorage(const T (&array)[L])
+        : transpose_{M == 1 || N == L ? L : 1, M == 1 || N == L ? 1 : L, array, array + L}
+    {
+    }
+
+    template<size_type MM, size_type NN, typename = std::enable_if_t<dimensionsMatch(M, N, MM, NN)>>
+    explicit DataStorage(const T (&array)[MM][NN])
+        : transpose_{NN, MM, dansandu::math::common::additiveIdentity<T>}
+    {
+        for (auto row = 0; row < MM; ++row)
+        {
+            for (auto column = 0; column < NN; ++column)
+            {
+                unsafeSubscript(row, column) = array[row][column];
+            }
+        }
+    }
+
+    DataStorage(size_type rows, size_type columns, const T& fillValue)
+        : transpose_{columns, validateDimensions(rows, columns), fillValue}
+    {
+    }
+
+    DataStorage(size_type rows, size_type columns, Uninitialized)
+        : transpose_{columns, validateDimensions(rows, columns), uninitialized}
+    {
+    }
+
+    template<typename IteratorBegin, typename IteratorEnd>
+    DataStorage(size_type rows, size_type columns, IteratorBegin sourceBegin, IteratorEnd sourceEnd)
+        : transpose_{columns, validateDimensions(rows, columns), dansandu::math::common::additiveIdentity<T>}
+    {
+        auto sourceIterator = sourceBegin;
+        for (auto row = 0; row < rows; ++row)
+        {
+            for (auto column = 0; column < columns; ++column)
+            {
+                if (sourceIterator == sourceEnd)
+                {
+                    THROW(std::out_of_range, "source underflows matrix");
+                }
+                unsafeSubscript(row, column) = *sourceIterator++;
+            }
+        }
+        if (sourceIterator != sourceEnd)
+        {
+            THROW(std::out_of_range, "source overflows matrix");
+        }
+    }
+
+    // The buffer holds the elements column by column and is adopted without reordering.
+    DataStorage(size_type rows, size_type columns, AlignedVector<T> buffer)
+        : transpose_{columns, validateDimensions(rows, columns), std::move(buffer)}
+    {
+    }
+
+    DataStorage(size_type rows, size_type columns, const std::vector<T>& buffer)
+        : transpose_{columns, validateDimensions(rows, columns), buffer}
+    {
+    }
+
+    auto& unsafeSubscript(size_type row, size_type column)
+    {
+        return transpose_.unsafeSubscript(column, row);
+    }
+
+    const auto& unsafeSubscript(size_type row, size_type column) const
+    {
+        return transpose_.unsafeSubscript(column, row);
+    }
+
+    auto& unsafeSubscript(size_type coordinate)
+    {
+        return transpose_.unsafeSubscript(coordinate);
+    }
+
+    const auto& unsafeSubscript(size_type coordinate) const
+    {
+        return transpose_.unsafeSubscript(coordinate);
+    }
+
+    auto rowCount() const
+    {
+        return transpose_.columnCount();
+    }
+
+    auto columnCount() const
+    {
+        return transpose_.rowCount();
+    }
+
+    auto rowStride() const
+    {
+        return static_cast<size_type>(1);
+    }
+
+    auto columnStride() const
+    {
+        return transpose_.rowStride();
+    }
+
+    auto begin()
+    {
+        return MatrixViewIterator<T>{data(), columnCount(), rowStride(), columnStride()};
+    }
+
+    auto end()
+    {
+        return begin() + rowCount() * columnCount();
+    }
+
+    auto begin() const
+    {
+        return cbegin();
+    }
+
+    auto end() const
+    {
+        return cend();
+    }
+
+    auto cbegin() const
+    {
+        return ConstantMatrixViewIterator<T>{data(), columnCount(), rowStride(), columnStride()};
+    }
+
+    auto cend() const
+    {
+        return cbegin() + rowCount() * columnCount();
+    }
+
+    auto data()
+    {
+        return transpose_.data();
+    }
+
+    auto data() const
+    {
+        return transpose_.data();
+    }
+
+    void reshape(size_type rows, size_type columns)
+    {
+        transpose_.reshape(columns, validateDimensions(rows, columns));
+    }
+
+private:
+    static auto validateDimensions(size_type rows, size_type columns)
+    {
+        if (rows < 0 || columns < 0 || (M != dynamic && M != rows) || (N != dynamic && N != columns))
+        {
+            THROW(std::out_of_range, "matrix dimensions cannot be negative ", rows, "x", columns,
+                  " and must match static rows and columns if not dynamic");
+        }
+        return rows;
+    }
+
+    DataStorage<T, N, M, DataStorageStrategy::heap> transpose_;
+};
+
+}
@@ -13,12 +13,12 @@ public:
     using iterator = ConstantMatrixViewIterator<T>;
     using const_iterator = ConstantMatrixViewIterator<T>;
 
-    DataStorage(size_type viewRowCount, size_type viewColumnCount, size_type sourceRowCount,
-                size_type sourceColumnCount, const T* viewBegin)
+    DataStorage(size_type viewRowCount, size_type viewColumnCount, size_type rowStride, size_type columnStride,
+                const T* viewBegin)
         : DimensionalityStorage<T, M, N>{viewRowCount, viewColumnCount},
           viewBegin_{viewBegin},
-          sourceRowCount_{sourceRowCount},
-          sourceColumnCount_{sourceColumnCount}
+          rowStride_{rowStride},
+          columnStride_{columnStride}
     {
     }
 
@@ -42,24 +42,24 @@ public:
         return DimensionalityStorage<T, M, N>::columnCount();
     }
 
-    auto sourceRowCount() const
+    auto rowStride() const
     {
-        return sourceRowCount_;
+        return rowStride_;
     }
 
-    auto sourceColumnCount() const
+    auto columnStride() const
     {
-        return sourceColumnCount_;
+        return columnStride_;
     }
 
     auto begin() const
     {
-        return ConstantMatrixViewIterator<T>{viewBegin_, columnCount(), sourceColumnCount_};
+        return ConstantMatrixViewIterator<T>{viewBegin_, columnCount(), rowStride_, columnStride_};
     }
 
     auto end() const
     {
-        return ConstantMatrixViewIterator<T>{viewBegin_, columnCount(), sourceColumnCount_} +
+        return ConstantMatrixViewIterator<T>{viewBegin_, columnCount(), rowStride_, columnStride_} +
                rowCount() * columnCount();
     }
 
@@ -81,24 +81,24 @@ public:
 private:
     auto getIndex(size_type row, size_type column) const
     {
-        return row * sourceColumnCount_ + column;
+        return row * rowStride_ + column * columnStride_;
     }
 
     auto getIndex(size_type index) const
     {
         if (rowCount() == 1)
         {
-            return index;
+            return index * columnStride_;
         }
         else
         {
-            return index * sourceColumnCount_;
+            return index * rowStride_;
         }
     }
 
     const T* viewBegin_;
-    size_type sourceRowCount_;
-    size_type sourceColumnCount_;
+    size_type rowStride_;
+    size_type columnStride_;
 };
 
 }
@@ -2,26 +2,31 @@
 
 #include "dansandu/ballotin/exception.hpp"
 #include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/aligned_allocator.hpp"
 #include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/constant_matrix_view_iterator.hpp"
 #include "dansandu/math/internal/matrix/dimensionality_storage.hpp"
+#include "dansandu/math/internal/matrix/matrix_view_iterator.hpp"
 
 #include <vector>
 
 namespace dansandu::math::matrix
 {
 
+// Keeps the rows on cache line aligned storage, optionally padded so that every row starts on a cache line. The
+// leading dimension is the distance between the starts of consecutive rows and is exposed as the row stride.
 template<typename T, size_type M, size_type N>
 class DataStorage<T, M, N, DataStorageStrategy::heap> : private DimensionalityStorage<T, M, N>
 {
 public:
-    using iterator = typename std::vector<T>::iterator;
-    using const_iterator = typename std::vector<T>::const_iterator;
+    using iterator = MatrixViewIterator<T>;
+    using const_iterator = ConstantMatrixViewIterator<T>;
 
-    DataStorage()
+    DataStorage() : leadingDimension_{N != dynamic ? N : 0}
     {
         if constexpr (M != dynamic && N != dynamic && M != 0 && N != 0)
         {
-            data_ = std::vector<T>(M * N, dansandu::math::common::additiveIdentity<T>);
+            data_ = AlignedVector<T>(M * N, dansandu::math::common::additiveIdentity<T>);
         }
     }
 
@@ -45,10 +50,11 @@ public:
         {
             DimensionalityStorage<T, M, N>::setColumnCount(1);
         }
+        leadingDimension_ = columnCount();
     }
 
     template<size_type MM, size_type NN, typename = std::enable_if_t<dimensionsMatch(M, N, MM, NN)>>
-    explicit DataStorage(const T (&array)[MM][NN]) : DimensionalityStorage<T, M, N>{MM, NN}
+    explicit DataStorage(const T (&array)[MM][NN]) : DimensionalityStorage<T, M, N>{MM, NN}, leadingDimension_{NN}
     {
         data_.reserve(MM * NN);
         for (auto row = 0; row < MM; ++row)
@@ -60,19 +66,37 @@ public:
         }
     }
 
-    DataStorage(size_type rows, size_type columns, const T& fillValue) : DimensionalityStorage<T, M, N>{rows, columns}
+    DataStorage(size_type rows, size_type columns, const T& fillValue)
+        : DataStorage{rows, columns, Padding::none, fillValue}
+    {
+    }
+
+    DataStorage(size_type rows, size_type columns, Padding padding, const T& fillValue)
+        : DimensionalityStorage<T, M, N>{rows, columns}
+    {
+        if (rows < 0 || columns < 0 || (M != dynamic && M != rows) || (N != dynamic && N != columns))
+        {
+            THROW(std::out_of_range, "matrix dimensions cannot be negative ", rows, "x", columns,
+                  " and must match static rows and columns if not dynamic");
+        }
+        leadingDimension_ = padding == Padding::cacheLine ? getPaddedLeadingDimension<T>(columns) : columns;
+        data_ = AlignedVector<T>(rowCount() * leadingDimension_, fillValue);
+    }
+
+    DataStorage(size_type rows, size_type columns, Uninitialized)
+        : DimensionalityStorage<T, M, N>{rows, columns}, leadingDimension_{columns}
     {
         if (rows < 0 || columns < 0 || (M != dynamic && M != rows) || (N != dynamic && N != columns))
         {
             THROW(std::out_of_range, "matrix dimensions cannot be negative ", rows, "x", columns,
                   " and must match static rows and columns if not dynamic");
         }
-        data_ = std::vector<T>(rowCount() * columnCount(), fillValue);
+        data_ = AlignedVector<T>(rowCount() * columnCount());
     }
 
     template<typename IteratorBegin, typename IteratorEnd>
     DataStorage(size_type rows, size_type columns, IteratorBegin sourceBegin, IteratorEnd sourceEnd)
-        : DimensionalityStorage<T, M, N>{rows, columns}
+        : DimensionalityStorage<T, M, N>{rows, columns}, leadingDimension_{columns}
     {
         if (rows < 0 || columns < 0 || (M != dynamic && M != rows) || (N != dynamic && N != columns))
         {
@@ -95,8 +119,13 @@ public:
         }
     }
 
-    DataStorage(size_type rows, size_type columns, std::vector<T> buffer)
-        : DimensionalityStorage<T, M, N>{rows, columns}, data_{std::move(buffer)}
+    DataStorage(size_type rows, size_type columns, const std::vector<T>& buffer)
+        : DataStorage{rows, columns, AlignedVector<T>(buffer.cbegin(), buffer.cend())}
+    {
+    }
+
+    DataStorage(size_type rows, size_type columns, AlignedVector<T> buffer)
+        : DimensionalityStorage<T, M, N>{rows, columns}, data_{std::move(buffer)}, leadingDimension_{columns}
     {
         if (rows < 0 || columns < 0 || (M != dynamic && M != rows) || (N != dynamic && N != columns))
         {
@@ -114,20 +143,27 @@ public:
     DataStorage(const DataStorage&) = default;
 
     DataStorage(DataStorage&& other) noexcept
-        : DimensionalityStorage<T, M, N>{std::move(other)}, data_{std::move(other.data_)}
+        : DimensionalityStorage<T, M, N>{std::move(other)},
+          data_{std::move(other.data_)},
+          leadingDimension_{other.leadingDimension_}
     {
         other.DimensionalityStorage<T, M, N>::setRowCount(0);
         other.DimensionalityStorage<T, M, N>::setColumnCount(0);
+        other.leadingDimension_ = N != dynamic ? N : 0;
     }
 
     DataStorage& operator=(const DataStorage&) = default;
 
-    DataStorage& operator=(DataStorage&& other) noexcept
+    // Not noexcept since elements are copied rather than stolen when the two matrices live in different arenas.
+    DataStorage& operator=(DataStorage&& other)
     {
         DimensionalityStorage<T, M, N>::operator=(std::move(other));
         other.DimensionalityStorage<T, M, N>::setRowCount(0);
         other.DimensionalityStorage<T, M, N>::setColumnCount(0);
         data_ = std::move(other.data_);
+        other.data_.clear();
+        leadingDimension_ = other.leadingDimension_;
+        other.leadingDimension_ = N != dynamic ? N : 0;
         return *this;
     }
 
@@ -161,44 +197,44 @@ public:
         return DimensionalityStorage<T, M, N>::columnCount();
     }
 
-    auto sourceRowCount() const
+    auto rowStride() const
     {
-        return DimensionalityStorage<T, M, N>::rowCount();
+        return leadingDimension_;
     }
 
-    auto sourceColumnCount() const
+    auto columnStride() const
     {
-        return DimensionalityStorage<T, M, N>::columnCount();
+        return static_cast<size_type>(1);
     }
 
     auto begin()
     {
-        return data_.begin();
+        return MatrixViewIterator<T>{data(), columnCount(), rowStride(), columnStride()};
     }
 
     auto end()
     {
-        return data_.end();
+        return begin() + rowCount() * columnCount();
     }
 
     auto begin() const
     {
-        return data_.begin();
+        return cbegin();
     }
 
     auto end() const
     {
-        return data_.end();
+        return cend();
     }
 
     auto cbegin() const
     {
-        return data_.cbegin();
+        return ConstantMatrixViewIterator<T>{data(), columnCount(), rowStride(), columnStride()};
     }
 
     auto cend() const
     {
-        return data_.cend();
+        return cbegin() + rowCount() * columnCount();
     }
 
     auto data()
@@ -206,6 +242,20 @@ public:
         return data_.data();
     }
 
+    void reshape(size_type rows, size_type columns)
+    {
+        if (rows < 0 || columns < 0 || (M != dynamic && M != rows) || (N != dynamic && N != columns) ||
+            leadingDimension_ != columnCount() ||
+            static_cast<long long>(rows) * columns != static_cast<long long>(data_.size()))
+        {
+            THROW(std::out_of_range, "cannot reshape a ", rowCount(), "x", columnCount(), " matrix into ", rows, "x",
+                  columns, " -- element count and static rows and columns must be preserved on unpadded rows");
+        }
+        DimensionalityStorage<T, M, N>::setRowCount(rows);
+        DimensionalityStorage<T, M, N>::setColumnCount(columns);
+        leadingDimension_ = columns;
+    }
+
     auto data() const
     {
         return data_.data();
@@ -214,15 +264,16 @@ public:
 private:
     auto getIndex(size_type row, size_type column) const
     {
-        return row * columnCount() + column;
+        return row * leadingDimension_ + column;
     }
 
     auto getIndex(size_type index) const
     {
-        return index;
+        return rowCount() == 1 ? index : index * leadingDimension_;
     }
 
-    std::vector<T> data_;
+    AlignedVector<T> data_;
+    size_type leadingDimension_;
 };
 
 }
@@ -0,0 +1,334 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/aligned_allocator.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/constant_matrix_view_iterator.hpp"
+#include "dansandu/math/internal/matrix/dimensionality_storage.hpp"
+#include "dansandu/math/internal/matrix/matrix_view_iterator.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace dansandu::math::matrix
+{
+
+// Keeps the elements inside the matrix object while they fit in smallBufferLength<T> elements and on cache line
+// aligned heap storage otherwise, so the short vectors and small matrices built at runtime cost no allocation. The
+// inline buffer is cache line aligned as well and rows may be padded the same way as on the heap. Adopted buffers are
+// always kept on the heap so that they are never copied.
+template<typename T, size_type M, size_type N>
+class DataStorage<T, M, N, DataStorageStrategy::smallBuffer> : private DimensionalityStorage<T, M, N>
+{
+public:
+    static_assert(smallBufferLength<T> > 0, "small buffer must hold at least one element");
+
+    using iterator = MatrixViewIterator<T>;
+    using const_iterator = ConstantMatrixViewIterator<T>;
+
+    DataStorage() : leadingDimension_{N != dynamic ? N : 0}, data_{inline_}
+    {
+        if constexpr (M != dynamic && N != dynamic)
+        {
+            allocate(M * N);
+            std::fill(data_, data_ + M * N, dansandu::math::common::additiveIdentity<T>);
+        }
+    }
+
+    template<size_type L, typename = std::enable_if_t<isVectorOfLength(M, N, L)>>
+    explicit DataStorage(const T (&array)[L])
+        : DimensionalityStorage<T, M, N>{N == L ? 1 : L, M == 1 ? L : 1}, leadingDimension_{M == 1 ? L : 1}
+    {
+        allocate(L);
+        std::copy(array, array + L, data_);
+    }
+
+    template<size_type MM, size_type NN, typename = std::enable_if_t<dimensionsMatch(M, N, MM, NN)>>
+    explicit DataStorage(const T (&array)[MM][NN]) : DimensionalityStorage<T, M, N>{MM, NN}, leadingDimension_{NN}
+    {
+        allocate(MM * NN);
+        for (auto row = 0; row < MM; ++row)
+        {
+            std::copy(array[row], array[row] + NN, data_ + row * NN);
+        }
+    }
+
+    DataStorage(size_type rows, size_type columns, const T& fillValue)
+        : DataStorage{rows, columns, Padding::none, fillValue}
+    {
+    }
+
+    DataStorage(size_type rows, size_type columns, Padding padding, const T& fillValue)
+        : DimensionalityStorage<T, M, N>{validateDimensions(rows, columns), columns},
+          leadingDimension_{padding == Padding::cacheLine ? getPaddedLeadingDimension<T>(columns) : columns}
+    {
+        allocate(rows * leadingDimension_);
+        std::fill(data_, data_ + rows * leadingDimension_, fillValue);
+    }
+
+    DataStorage(size_type rows, size_type columns, Uninitialized)
+        : DimensionalityStorage<T, M, N>{validateDimensions(rows, columns), columns}, leadingDimension_{columns}
+    {
+        allocate(rows * columns);
+    }
+
+    template<typename IteratorBegin, typename IteratorEnd>
+    DataStorage(size_type rows, size_type columns, IteratorBegin sourceBegin, IteratorEnd sourceEnd)
+        : DimensionalityStorage<T, M, N>{validateDimensions(rows, columns), columns}, leadingDimension_{columns}
+    {
+        allocate(rows * columns);
+        auto sourceIterator = sourceBegin;
+        for (auto i = 0; i < rows * columns; ++i)
+        {
+            if (sourceIterator == sourceEnd)
+            {
+                THROW(std::out_of_range, "source underflows matrix");
+            }
+            data_[i] = *sourceIterator++;
+        }
+        if (sourceIterator != sourceEnd)
+        {
+            THROW(std::out_of_range, "source overflows matrix");
+        }
+    }
+
+    DataStorage(size_type rows, size_type columns, const std::vector<T>& buffer)
+        : DimensionalityStorage<T, M, N>{validateDimensions(rows, columns), columns}, leadingDimension_{columns}
+    {
+        validateBufferSize(buffer.size());
+        allocate(rows * columns);
+        std::copy(buffer.cbegin(), buffer.cend(), data_);
+    }
+
+    DataStorage(size_type rows, size_type columns, AlignedVector<T> buffer)
+        : DimensionalityStorage<T, M, N>{validateDimensions(rows, columns), columns},
+          heap_{std::move(buffer)},
+          leadingDimension_{columns},
+          data_{heap_.data()}
+    {
+        validateBufferSize(heap_.size());
+    }
+
+    DataStorage(const DataStorage& other)
+        : DimensionalityStorage<T, M, N>{other}, leadingDimension_{other.leadingDimension_}
+    {
+        allocate(other.size());
+        std::copy(other.data_, other.data_ + other.size(), data_);
+    }
+
+    // The heap buffer is move constructed so that it keeps its allocator, which never allocates.
+    DataStorage(DataStorage&& other) noexcept
+        : DimensionalityStorage<T, M, N>{std::move(other)},
+          heap_{std::move(other.heap_)},
+          leadingDimension_{other.leadingDimension_},
+          data_{other.isInline() ? inline_ : heap_.data()}
+    {
+        if (isInline())
+        {
+            std::copy(other.inline_, other.inline_ + other.size(), inline_);
+        }
+        other.clear();
+    }
+
+    DataStorage& operator=(const DataStorage& other)
+    {
+        if (this != &other)
+        {
+            DimensionalityStorage<T, M, N>::operator=(other);
+            leadingDimension_ = other.leadingDimension_;
+            allocate(other.size());
+            std::copy(other.data_, other.data_ + other.size(), data_);
+        }
+        return *this;
+    }
+
+    // Not noexcept since elements are copied rather than stolen when the two matrices live in different arenas.
+    DataStorage& operator=(DataStorage&& other)
+    {
+        if (this != &other)
+        {
+            DimensionalityStorage<T, M, N>::operator=(std::move(other));
+            leadingDimension_ = other.leadingDimension_;
+            if (other.isInline())
+            {
+                allocate(other.size());
+                std::copy(other.inline_, other.inline_ + other.size(), inline_);
+            }
+            else
+            {
+                heap_ = std::move(other.heap_);
+                data_ = heap_.data();
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    auto& unsafeSubscript(size_type row, size_type column)
+    {
+        return data_[row * leadingDimension_ + column];
+    }
+
+    const auto& unsafeSubscript(size_type row, size_type column) const
+    {
+        return data_[row * leadingDimension_ + column];
+    }
+
+    auto& unsafeSubscript(size_type coordinate)
+    {
+        return data_[getIndex(coordinate)];
+    }
+
+    const auto& unsafeSubscript(size_type coordinate) const
+    {
+        return data_[getIndex(coordinate)];
+    }
+
+    auto rowCount() const
+    {
+        return DimensionalityStorage<T, M, N>::rowCount();
+    }
+
+    auto columnCount() const
+    {
+        return DimensionalityStorage<T, M, N>::columnCount();
+    }
+
+    auto rowStride() const
+    {
+        return leadingDimension_;
+    }
+
+    auto columnStride() const
+    {
+        return static_cast<size_type>(1);
+    }
+
+    auto begin()
+    {
+        return MatrixViewIterator<T>{data(), columnCount(), rowStride(), columnStride()};
+    }
+
+    auto end()
+    {
+        return begin() + rowCount() * columnCount();
+    }
+
+    auto begin() const
+    {
+        return cbegin();
+    }
+
+    auto end() const
+    {
+        return cend();
+    }
+
+    auto cbegin() const
+    {
+        return ConstantMatrixViewIterator<T>{data(), columnCount(), rowStride(), columnStride()};
+    }
+
+    auto cend() const
+    {
+        return cbegin() + rowCount() * columnCount();
+    }
+
+    auto data()
+    {
+        return data_;
+    }
+
+    auto data() const
+    {
+        return static_cast<const T*>(data_);
+    }
+
+    void reshape(size_type rows, size_type columns)
+    {
+        if (rows < 0 || columns < 0 || (M != dynamic && M != rows) || (N != dynamic && N != columns) ||
+            leadingDimension_ != columnCount() || rows * columns != size())
+        {
+            THROW(std::out_of_range, "cannot reshape a ", rowCount(), "x", columnCount(), " matrix into ", rows, "x",
+                  columns, " -- element count and static rows and columns must be preserved on unpadded rows");
+        }
+        DimensionalityStorage<T, M, N>::setRowCount(rows);
+        DimensionalityStorage<T, M, N>::setColumnCount(columns);
+        leadingDimension_ = columns;
+    }
+
+private:
+    static auto validateDimensions(size_type rows, size_type columns)
+    {
+        if (rows < 0 || columns < 0 || (M != dynamic && M != rows) || (N != dynamic && N != columns))
+        {
+            THROW(std::out_of_range, "matrix dimensions cannot be negative ", rows, "x", columns,
+                  " and must match static rows and columns if not dynamic");
+        }
+        return rows;
+    }
+
+    void validateBufferSize(std::size_t bufferSize) const
+    {
+        if (static_cast<std::size_t>(size()) != bufferSize)
+        {
+            THROW(std::out_of_range, "buffer size ", bufferSize, " doesn't match matrix dimensions ", rowCount(), "x",
+                  columnCount());
+        }
+    }
+
+    // Points the data at the inline buffer if count elements fit, otherwise at heap storage holding exactly count
+    // default-initialized elements, releasing the heap storage that is no longer needed either way.
+    void allocate(size_type count)
+    {
+        if (count <= smallBufferLength<T>)
+        {
+            if (heap_.capacity() != 0)
+            {
+                heap_ = AlignedVector<T>{heap_.get_allocator()};
+            }
+            data_ = inline_;
+        }
+        else
+        {
+            if (static_cast<size_type>(heap_.size()) != count)
+            {
+                heap_ = AlignedVector<T>(count, heap_.get_allocator());
+            }
+            data_ = heap_.data();
+        }
+    }
+
+    void clear()
+    {
+        DimensionalityStorage<T, M, N>::setRowCount(0);
+        DimensionalityStorage<T, M, N>::setColumnCount(0);
+        heap_.clear();
+        leadingDimension_ = N != dynamic ? N : 0;
+        data_ = inline_;
+    }
+
+    auto isInline() const
+    {
+        return data_ == inline_;
+    }
+
+    auto size() const
+    {
+        return rowCount() * leadingDimension_;
+    }
+
+    auto getIndex(size_type index) const
+    {
+        return rowCount() == 1 ? index : index * leadingDimension_;
+    }
+
+    AlignedVector<T> heap_;
+    size_type leadingDimension_;
+    T* data_;
+    alignas(cacheLineBytes) T inline_[smallBufferLength<T>];
+};
+
+}
@@ -17,19 +17,25 @@ public:
     using iterator = typename std::array<T, M * N>::iterator;
     using const_iterator = typename std::array<T, M * N>::const_iterator;
 
-    DataStorage() : DimensionalityStorage<T, M, N>{M, N}
+    constexpr DataStorage() : DimensionalityStorage<T, M, N>{M, N}, data_{}
     {
-        std::fill(begin(), end(), dansandu::math::common::additiveIdentity<T>);
+        for (auto i = 0; i < M * N; ++i)
+        {
+            data_[i] = dansandu::math::common::additiveIdentity<T>;
+        }
     }
 
     template<size_type L, typename = std::enable_if_t<isVectorOfLength(M, N, L)>>
-    explicit DataStorage(const T (&array)[L]) : DimensionalityStorage<T, M, N>{M, N}
+    constexpr explicit DataStorage(const T (&array)[L]) : DimensionalityStorage<T, M, N>{M, N}, data_{}
     {
-        std::copy(array, array + L, begin());
+        for (auto i = 0; i < L; ++i)
+        {
+            data_[i] = array[i];
+        }
     }
 
     template<size_type MM, size_type NN, typename = std::enable_if_t<dimensionsMatch(M, N, MM, NN)>>
-    explicit DataStorage(const T (&array)[MM][NN]) : DimensionalityStorage<T, M, N>{MM, NN}
+    constexpr explicit DataStorage(const T (&array)[MM][NN]) : DimensionalityStorage<T, M, N>{MM, NN}, data_{}
     {
         for (auto row = 0; row < MM; ++row)
         {
@@ -50,6 +56,15 @@ public:
         std::fill(begin(), end(), fillValue);
     }
 
+    DataStorage(size_type rows, size_type columns, Uninitialized) : DimensionalityStorage<T, M, N>{rows, columns}
+    {
+        if (rows < 0 || columns < 0 || M != rows || N != columns)
+        {
+            THROW(std::out_of_range, "matrix dimensions cannot be negative ", rows, "x", columns,
+                  " and must match static rows and columns if not dynamic");
+        }
+    }
+
     template<typename IteratorBegin, typename IteratorEnd>
     DataStorage(size_type rows, size_type columns, IteratorBegin sourceBegin, IteratorEnd sourceEnd)
         : DimensionalityStorage<T, M, N>{rows, columns}
@@ -75,93 +90,93 @@ public:
         }
     }
 
-    auto& unsafeSubscript(size_type row, size_type column)
+    constexpr auto& unsafeSubscript(size_type row, size_type column)
     {
         return data_[getIndex(row, column)];
     }
 
-    const auto& unsafeSubscript(size_type row, size_type column) const
+    constexpr const auto& unsafeSubscript(size_type row, size_type column) const
     {
         return data_[getIndex(row, column)];
     }
 
-    auto& unsafeSubscript(size_type coordinate)
+    constexpr auto& unsafeSubscript(size_type coordinate)
     {
         return data_[getIndex(coordinate)];
     }
 
-    const auto& unsafeSubscript(size_type coordinate) const
+    constexpr const auto& unsafeSubscript(size_type coordinate) const
     {
         return data_[getIndex(coordinate)];
     }
 
-    auto rowCount() const
+    constexpr auto rowCount() const
     {
         return DimensionalityStorage<T, M, N>::rowCount();
     }
 
-    auto columnCount() const
+    constexpr auto columnCount() const
     {
         return DimensionalityStorage<T, M, N>::columnCount();
     }
 
-    auto sourceRowCount() const
+    constexpr auto rowStride() const
     {
-        return DimensionalityStorage<T, M, N>::rowCount();
+        return DimensionalityStorage<T, M, N>::columnCount();
     }
 
-    auto sourceColumnCount() const
+    constexpr auto columnStride() const
     {
-        return DimensionalityStorage<T, M, N>::columnCount();
+        return static_cast<size_type>(1);
     }
 
-    auto begin()
+    constexpr auto begin()
     {
         return data_.begin();
     }
 
-    auto end()
+    constexpr auto end()
     {
         return data_.end();
     }
 
-    auto begin() const
+    constexpr auto begin() const
     {
         return data_.begin();
     }
 
-    auto end() const
+    constexpr auto end() const
     {
         return data_.end();
     }
 
-    auto cbegin() const
+    constexpr auto cbegin() const
     {
         return data_.cbegin();
     }
 
-    auto cend() const
+    constexpr auto cend() const
     {
         return data_.cend();
     }
 
-    auto data()
+    constexpr auto data()
     {
         return data_.data();
     }
 
-    auto data() const
+    constexpr auto data() const
     {
         return data_.data();
     }
 
 private:
-    auto getIndex(size_type row, size_type column) const
+    constexpr auto getIndex(size_type row, size_type column) const
     {
         return row * columnCount() + column;
     }
 
-    auto getIndex(size_type index) const
+    constexpr auto getIndex(size_type index) const
     {
         return index;
     }
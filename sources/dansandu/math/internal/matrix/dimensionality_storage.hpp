@@ -2,17 +2,34 @@
 
 #include "dansandu/math/internal/matrix/common.hpp"
 
+// Matrices with static dimensions of at most DANSANDU_MATH_STACK_BYTES are stored in a plain array inside the object.
+#ifndef DANSANDU_MATH_STACK_BYTES
+#define DANSANDU_MATH_STACK_BYTES 32
+#endif
+
+// Matrices with dynamic dimensions keep up to DANSANDU_MATH_SMALL_BUFFER_BYTES inside the object before falling back to
+// the heap. Zero sends them straight to the heap.
+#ifndef DANSANDU_MATH_SMALL_BUFFER_BYTES
+#define DANSANDU_MATH_SMALL_BUFFER_BYTES 64
+#endif
+
 namespace dansandu::math::matrix
 {
 
-template<typename T, size_type M, size_type N>
+template<typename T>
+constexpr auto smallBufferLength = static_cast<size_type>(DANSANDU_MATH_SMALL_BUFFER_BYTES / sizeof(T));
+
+template<typename T, size_type M, size_type N, Layout L = Layout::rowMajor>
 struct DataStorageStrategyFor
 {
-    constexpr static auto stackBytes = static_cast<size_type>(32);
-
-    constexpr static auto value = (M == dynamic || N == dynamic || M * N * sizeof(T) > stackBytes)
-                                      ? DataStorageStrategy::heap
-                                      : DataStorageStrategy::stack;
+    constexpr static auto stackBytes = static_cast<size_type>(DANSANDU_MATH_STACK_BYTES);
+
+    constexpr static auto value = L == Layout::columnMajor ? DataStorageStrategy::columnMajorHeap
+                                  : (M == dynamic || N == dynamic)
+                                      ? (smallBufferLength<T> > 0 ? DataStorageStrategy::smallBuffer
+                                                                  : DataStorageStrategy::heap)
+                                  : M * N * sizeof(T) > stackBytes ? DataStorageStrategy::heap
+                                                                   : DataStorageStrategy::stack;
 };
 
 template<typename T, size_type M, size_type N>
@@ -22,28 +39,28 @@ template<typename T, size_type M, size_type N>
 class DimensionalityStorage
 {
 public:
-    DimensionalityStorage()
+    constexpr DimensionalityStorage()
     {
     }
 
-    DimensionalityStorage(size_type, size_type)
+    constexpr DimensionalityStorage(size_type, size_type)
     {
     }
 
-    void setRowCount(size_type)
+    constexpr void setRowCount(size_type)
     {
     }
 
-    void setColumnCount(size_type)
+    constexpr void setColumnCount(size_type)
     {
     }
 
-    auto rowCount() const
+    constexpr auto rowCount() const
     {
         return M;
     }
 
-    auto columnCount() const
+    constexpr auto columnCount() const
     {
         return N;
     }
@@ -53,29 +70,29 @@ template<typename T, size_type N>
 class DimensionalityStorage<T, dynamic, N>
 {
 public:
-    DimensionalityStorage() : rows_{0}
+    constexpr DimensionalityStorage() : rows_{0}
     {
     }
 
-    DimensionalityStorage(size_type rows, size_type) : rows_{rows}
+    constexpr DimensionalityStorage(size_type rows, size_type) : rows_{rows}
     {
     }
 
-    void setRowCount(size_type rows)
+    constexpr void setRowCount(size_type rows)
     {
         rows_ = rows;
     }
 
-    void setColumnCount(size_type)
+    constexpr void setColumnCount(size_type)
     {
     }
 
-    auto rowCount() const
+    constexpr auto rowCount() const
     {
         return rows_;
     }
 
-    auto columnCount() const
+    constexpr auto columnCount() const
     {
         return N;
     }
@@ -88,29 +105,29 @@ template<typename T, size_type M>
 class DimensionalityStorage<T, M, dynamic>
 {
 public:
-    DimensionalityStorage() : columns_{0}
+    constexpr DimensionalityStorage() : columns_{0}
     {
     }
 
-    DimensionalityStorage(size_type, size_type columns) : columns_{columns}
+    constexpr DimensionalityStorage(size_type, size_type columns) : columns_{columns}
     {
     }
 
-    void setRowCount(size_type)
+    constexpr void setRowCount(size_type)
     {
     }
 
-    void setColumnCount(size_type columns)
+    constexpr void setColumnCount(size_type columns)
     {
         columns_ = columns;
     }
 
-    auto rowCount() const
+    constexpr auto rowCount() const
     {
         return M;
     }
 
-    auto columnCount() const
+    constexpr auto columnCount() const
     {
         return columns_;
     }
@@ -123,30 +140,30 @@ template<typename T>
 class DimensionalityStorage<T, dynamic, dynamic>
 {
 public:
-    DimensionalityStorage() : rows_{0}, columns_{0}
+    constexpr DimensionalityStorage() : rows_{0}, columns_{0}
     {
     }
 
-    DimensionalityStorage(size_type rows, size_type columns) : rows_{rows}, columns_{columns}
+    constexpr DimensionalityStorage(size_type rows, size_type columns) : rows_{rows}, columns_{columns}
     {
     }
 
-    void setRowCount(size_type rows)
+    constexpr void setRowCount(size_type rows)
     {
         rows_ = rows;
     }
 
-    void setColumnCount(size_type columns)
+    constexpr void setColumnCount(size_type columns)
     {
         columns_ = columns;
     }
 
-    auto rowCount() const
+    constexpr auto rowCount() const
     {
         return rows_;
     }
 
-    auto columnCount() const
+    constexpr auto columnCount() const
     {
         return columns_;
     }
@@ -0,0 +1,293 @@
+#pragma once
+
+#include "dansandu/math/internal/matrix/common.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace dansandu::math::matrix
+{
+
+template<typename Function, typename... Operands>
+class MatrixExpression;
+
+template<typename T>
+struct IsMatrixImplementation : std::false_type
+{
+};
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+struct IsMatrixImplementation<MatrixImplementation<T, M, N, S>> : std::true_type
+{
+};
+
+template<typename T>
+struct IsMatrixExpression : std::false_type
+{
+};
+
+template<typename Function, typename... Operands>
+struct IsMatrixExpression<MatrixExpression<Function, Operands...>> : std::true_type
+{
+};
+
+template<typename T>
+constexpr auto isMatrixImplementation = IsMatrixImplementation<std::decay_t<T>>::value;
+
+template<typename T>
+constexpr auto isMatrixExpression = IsMatrixExpression<std::decay_t<T>>::value;
+
+template<typename T>
+constexpr auto isMatrixOperand = isMatrixImplementation<T> || isMatrixExpression<T>;
+
+template<typename A, typename B>
+constexpr auto elementwiseOperands()
+{
+    if constexpr (isMatrixOperand<A> && isMatrixOperand<B>)
+    {
+        using AA = std::decay_t<A>;
+        using BB = std::decay_t<B>;
+        return std::is_same_v<typename AA::value_type, typename BB::value_type> &&
+               dimensionsMatch(AA::staticRowCount, AA::staticColumnCount, BB::staticRowCount, BB::staticColumnCount);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+// Containers passed as lvalues are referenced by the expression, while views, expressions and containers passed as
+// rvalues are stored inside it so that the expression can safely outlive the full-expression that created it.
+template<typename A>
+constexpr auto isReferencedOperand()
+{
+    if constexpr (std::is_lvalue_reference_v<A> && isMatrixImplementation<A>)
+    {
+        return isContainer(std::decay_t<A>::dataStorageStrategy);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template<typename A>
+using ExpressionOperand = std::conditional_t<isReferencedOperand<A>(), const std::decay_t<A>&, std::decay_t<A>>;
+
+template<typename Function, typename... Cursors>
+class ExpressionCursor
+{
+public:
+    ExpressionCursor(const Function& function, Cursors... cursors) : function_{function}, cursors_{cursors...}
+    {
+    }
+
+    auto operator[](size_type index) const
+    {
+        return std::apply([this, index](const auto&... cursors) { return function_(cursors[index]...); }, cursors_);
+    }
+
+private:
+    const Function& function_;
+    std::tuple<Cursors...> cursors_;
+};
+
+template<typename T>
+class StridedCursor
+{
+public:
+    StridedCursor(const T* begin, size_type stride) : begin_{begin}, stride_{stride}
+    {
+    }
+
+    const T& operator[](size_type index) const
+    {
+        return begin_[index * stride_];
+    }
+
+private:
+    const T* begin_;
+    size_type stride_;
+};
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+auto getRowCursor(const MatrixImplementation<T, M, N, S>& matrix, size_type row)
+{
+    if constexpr (isContainer(S) && !isColumnMajor(S))
+    {
+        return static_cast<const T*>(matrix.data() + row * matrix.rowStride());
+    }
+    else
+    {
+        return StridedCursor<T>{matrix.data() + row * matrix.rowStride(), matrix.columnStride()};
+    }
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+auto getColumnCursor(const MatrixImplementation<T, M, N, S>& matrix, size_type column)
+{
+    if constexpr (isColumnMajor(S))
+    {
+        return static_cast<const T*>(matrix.data() + column * matrix.columnStride());
+    }
+    else
+    {
+        return StridedCursor<T>{matrix.data() + column * matrix.columnStride(), matrix.rowStride()};
+    }
+}
+
+template<typename Function, typename... Operands>
+auto getRowCursor(const MatrixExpression<Function, Operands...>& expression, size_type row)
+{
+    return expression.getRowCursor(row);
+}
+
+template<typename Function, typename... Operands>
+auto getColumnCursor(const MatrixExpression<Function, Operands...>& expression, size_type column)
+{
+    return expression.getColumnCursor(column);
+}
+
+// Tells whether writing the destination can clobber an element of the operand before it is read. An operand that
+// maps every element onto the same destination element is harmless, while any other overlap, e.g. the transpose of
+// the destination, is not.
+template<typename T, size_type M, size_type N, DataStorageStrategy S, typename Destination>
+bool aliases(const MatrixImplementation<T, M, N, S>& operand, const Destination& destination)
+{
+    if (operand.rowCount() == 0 || operand.columnCount() == 0 || destination.rowCount() == 0 ||
+        destination.columnCount() == 0)
+    {
+        return false;
+    }
+    const auto first = static_cast<const void*>(operand.data());
+    const auto destinationFirst = static_cast<const void*>(destination.data());
+    if (first == destinationFirst && operand.rowStride() == destination.rowStride() &&
+        operand.columnStride() == destination.columnStride())
+    {
+        return false;
+    }
+    const auto last = static_cast<const void*>(operand.data() + (operand.rowCount() - 1) * operand.rowStride() +
+                                               (operand.columnCount() - 1) * operand.columnStride());
+    const auto destinationLast =
+        static_cast<const void*>(destination.data() + (destination.rowCount() - 1) * destination.rowStride() +
+                                 (destination.columnCount() - 1) * destination.columnStride());
+    const auto less = std::less<const void*>{};
+    return !less(last, destinationFirst) && !less(destinationLast, first);
+}
+
+template<typename Function, typename... Operands, typename Destination>
+bool aliases(const MatrixExpression<Function, Operands...>& expression, const Destination& destination)
+{
+    return expression.aliases(destination);
+}
+
+template<typename Function, typename... Operands>
+class MatrixExpression
+{
+public:
+    using value_type = std::decay_t<decltype(std::declval<Function>()(
+        std::declval<typename std::decay_t<Operands>::value_type>()...))>;
+
+    static constexpr auto staticRowCount = std::max({std::decay_t<Operands>::staticRowCount...});
+
+    static constexpr auto staticColumnCount = std::max({std::decay_t<Operands>::staticColumnCount...});
+
+    template<typename... A>
+    explicit MatrixExpression(Function function, A&&... operands)
+        : function_{std::move(function)}, operands_{std::forward<A>(operands)...}
+    {
+    }
+
+    auto rowCount() const
+    {
+        return std::get<0>(operands_).rowCount();
+    }
+
+    auto columnCount() const
+    {
+        return std::get<0>(operands_).columnCount();
+    }
+
+    auto getRowCursor(size_type row) const
+    {
+        return std::apply(
+            [this, row](const auto&... operands)
+            {
+                return ExpressionCursor<Function, decltype(dansandu::math::matrix::getRowCursor(operands, row))...>{
+                    function_, dansandu::math::matrix::getRowCursor(operands, row)...};
+            },
+            operands_);
+    }
+
+    auto getColumnCursor(size_type column) const
+    {
+        return std::apply(
+            [this, column](const auto&... operands)
+            {
+                return ExpressionCursor<Function,
+                                        decltype(dansandu::math::matrix::getColumnCursor(operands, column))...>{
+                    function_, dansandu::math::matrix::getColumnCursor(operands, column)...};
+            },
+            operands_);
+    }
+
+    template<typename Destination>
+    bool aliases(const Destination& destination) const
+    {
+        return std::apply([&destination](const auto&... operands)
+                          { return (dansandu::math::matrix::aliases(operands, destination) || ...); },
+                          operands_);
+    }
+
+private:
+    Function function_;
+    std::tuple<Operands...> operands_;
+};
+
+// Evaluates the expression in a single pass, combining every element with the destination element it maps to. The
+// destination is traversed in the order of its layout, by rows or by columns.
+template<typename Expression, typename T, typename Assignment>
+void assignExpression(const Expression& expression, T* destination, size_type rowStride, size_type columnStride,
+                      Assignment assignment)
+{
+    if (rowStride == 1 && columnStride != 1)
+    {
+        const auto rows = expression.rowCount();
+        for (auto column = 0; column < expression.columnCount(); ++column)
+        {
+            const auto source = getColumnCursor(expression, column);
+            const auto target = destination + column * columnStride;
+            for (auto row = 0; row < rows; ++row)
+            {
+                assignment(target[row], source[row]);
+            }
+        }
+        return;
+    }
+
+    const auto columns = expression.columnCount();
+    for (auto row = 0; row < expression.rowCount(); ++row)
+    {
+        const auto source = getRowCursor(expression, row);
+        const auto target = destination + row * rowStride;
+        if (columnStride == 1)
+        {
+            for (auto column = 0; column < columns; ++column)
+            {
+                assignment(target[column], source[column]);
+            }
+        }
+        else
+        {
+            for (auto column = 0; column < columns; ++column)
+            {
+                assignment(target[column * columnStride], source[column]);
+            }
+        }
+    }
+}
+
+}
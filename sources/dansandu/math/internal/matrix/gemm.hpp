@@ -0,0 +1,272 @@
+#pragma once
+
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/aligned_allocator.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/gemv.hpp"
+#include "dansandu/math/internal/matrix/kernels.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace dansandu::math::matrix
+{
+
+// Blocking parameters of the packed matrix multiplication. The micro tile is kept in registers, a packed micro
+// panel of B (depthBlock x microColumns) stays in L1, a packed block of A (rowBlock x depthBlock) stays in L2 and a
+// packed panel of B (depthBlock x columnBlock) stays in L3.
+template<typename T>
+struct GemmBlocking
+{
+    static constexpr size_type depthBlock = 256;
+    static constexpr size_type rowBlock = static_cast<size_type>(128 * 1024 / (depthBlock * sizeof(T)));
+    static constexpr size_type columnBlock = 4096;
+};
+
+// Products with fewer multiply-adds than this are cheaper to compute directly than to pack.
+constexpr auto gemmPackingThreshold = 16 * 16 * 16;
+
+// Products with fewer multiply-adds than this are not worth waking up other threads for.
+constexpr auto gemmParallelThreshold = 128 * 128 * 128;
+
+template<typename T>
+void packBlockOfA(size_type rows, size_type depth, T alpha, const T* a, size_type rowStride, size_type columnStride,
+                  size_type microRows, T* packed)
+{
+    for (auto panel = 0; panel < rows; panel += microRows)
+    {
+        const auto panelRows = std::min(microRows, rows - panel);
+        for (auto i = 0; i < microRows; ++i)
+        {
+            if (i < panelRows)
+            {
+                const auto row = a + (panel + i) * rowStride;
+                for (auto p = 0; p < depth; ++p)
+                {
+                    packed[p * microRows + i] = alpha * row[p * columnStride];
+                }
+            }
+            else
+            {
+                for (auto p = 0; p < depth; ++p)
+                {
+                    packed[p * microRows + i] = dansandu::math::common::additiveIdentity<T>;
+                }
+            }
+        }
+        packed += depth * microRows;
+    }
+}
+
+template<typename T>
+void packPanelOfB(size_type depth, size_type columns, const T* b, size_type rowStride, size_type columnStride,
+                  size_type microColumns, T* packed)
+{
+    for (auto panel = 0; panel < columns; panel += microColumns)
+    {
+        const auto panelColumns = std::min(microColumns, columns - panel);
+        for (auto p = 0; p < depth; ++p)
+        {
+            const auto row = b + p * rowStride + panel * columnStride;
+            for (auto j = 0; j < panelColumns; ++j)
+            {
+                *packed++ = row[j * columnStride];
+            }
+            for (auto j = panelColumns; j < microColumns; ++j)
+            {
+                *packed++ = dansandu::math::common::additiveIdentity<T>;
+            }
+        }
+    }
+}
+
+// Runs the micro-kernel on a tile that may be smaller than a full register tile by computing into a scratch tile.
+template<typename T>
+void gemmTile(const Kernels<T>& kernels, size_type depth, const T* packedA, const T* packedB, T* c, size_type rowStride,
+              size_type rows, size_type columns, T* scratch)
+{
+    if (rows == kernels.microRows && columns == kernels.microColumns)
+    {
+        kernels.gemmMicroKernel(depth, packedA, packedB, c, rowStride);
+        return;
+    }
+
+    std::fill(scratch, scratch + kernels.microRows * kernels.microColumns,
+              dansandu::math::common::additiveIdentity<T>);
+    kernels.gemmMicroKernel(depth, packedA, packedB, scratch, kernels.microColumns);
+    for (auto i = 0; i < rows; ++i)
+    {
+        for (auto j = 0; j < columns; ++j)
+        {
+            c[i * rowStride + j] += scratch[i * kernels.microColumns + j];
+        }
+    }
+}
+
+template<typename T>
+void gemmBlock(const Kernels<T>& kernels, size_type rows, size_type columns, size_type depth, T alpha, const T* a,
+               size_type aRowStride, size_type aColumnStride, const T* b, size_type bRowStride,
+               size_type bColumnStride, T* c, size_type cRowStride)
+{
+    const auto depthBlock = GemmBlocking<T>::depthBlock;
+    const auto microRows = kernels.microRows;
+    const auto microColumns = kernels.microColumns;
+
+    // The buffers outlive any arena scope the first call may run in, so they always come from the global heap.
+    static thread_local auto packedA = AlignedVector<T>{AlignedAllocator<T>{nullptr}};
+    static thread_local auto packedB = AlignedVector<T>{AlignedAllocator<T>{nullptr}};
+    static thread_local auto scratch = AlignedVector<T>{AlignedAllocator<T>{nullptr}};
+    packedA.resize(std::max<std::size_t>(packedA.size(), (rows + microRows - 1) / microRows * microRows * depthBlock));
+    packedB.resize(
+        std::max<std::size_t>(packedB.size(), (columns + microColumns - 1) / microColumns * microColumns * depthBlock));
+    scratch.resize(microRows * microColumns);
+
+    for (auto pc = 0; pc < depth; pc += depthBlock)
+    {
+        const auto kc = std::min(depthBlock, depth - pc);
+        packPanelOfB(kc, columns, b + pc * bRowStride, bRowStride, bColumnStride, microColumns, packedB.data());
+        packBlockOfA(rows, kc, alpha, a + pc * aColumnStride, aRowStride, aColumnStride, microRows, packedA.data());
+        for (auto jr = 0; jr < columns; jr += microColumns)
+        {
+            const auto nr = std::min(microColumns, columns - jr);
+            for (auto ir = 0; ir < rows; ir += microRows)
+            {
+                const auto mr = std::min(microRows, rows - ir);
+                gemmTile(kernels, kc, packedA.data() + ir * kc, packedB.data() + jr * kc, c + ir * cRowStride + jr,
+                         cRowStride, mr, nr, scratch.data());
+            }
+        }
+    }
+}
+
+// Scales the rows x columns block of C by beta ahead of the accumulation. A zero beta overwrites the block without
+// reading it, so C may start out uninitialized.
+template<typename T>
+void scaleOutput(size_type rows, size_type columns, T beta, T* c, size_type cRowStride)
+{
+    if (beta == dansandu::math::common::multiplicativeIdentity<T>)
+    {
+        return;
+    }
+    for (auto i = 0; i < rows; ++i)
+    {
+        const auto row = c + i * cRowStride;
+        if (beta == dansandu::math::common::additiveIdentity<T>)
+        {
+            std::fill(row, row + columns, dansandu::math::common::additiveIdentity<T>);
+        }
+        else
+        {
+            std::transform(row, row + columns, row, dansandu::math::common::MultiplyBy<T>{beta});
+        }
+    }
+}
+
+// Computes C = alpha * A * B + beta * C where A is rows x depth, B is depth x columns and C is rows x columns. Element
+// (i, j) of each operand lives at i * rowStride + j * columnStride, which lets transposed operands be read in place,
+// while C is row-major. C is split into blocks that are scaled and computed independently on the executor threads, so
+// an uninitialized C is first touched by the thread that computes it. Because every element of C is accumulated in the
+// same order regardless of the split, the result does not depend on the thread count.
+template<typename T>
+void unsafeGemm(size_type rows, size_type columns, size_type depth, T alpha, const T* a, size_type aRowStride,
+                size_type aColumnStride, const T* b, size_type bRowStride, size_type bColumnStride, T beta, T* c,
+                size_type cRowStride,
+                const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    using Blocking = GemmBlocking<T>;
+
+    if (rows == 0 || columns == 0)
+    {
+        return;
+    }
+
+    const auto multiplyAdds = static_cast<long long>(rows) * columns * depth;
+    if (depth == 0 || alpha == dansandu::math::common::additiveIdentity<T>)
+    {
+        scaleOutput(rows, columns, beta, c, cRowStride);
+        return;
+    }
+
+    if (multiplyAdds <= gemmPackingThreshold)
+    {
+        scaleOutput(rows, columns, beta, c, cRowStride);
+        for (auto i = 0; i < rows; ++i)
+        {
+            for (auto p = 0; p < depth; ++p)
+            {
+                const auto scalar = alpha * a[i * aRowStride + p * aColumnStride];
+                for (auto j = 0; j < columns; ++j)
+                {
+                    c[i * cRowStride + j] += scalar * b[p * bRowStride + j * bColumnStride];
+                }
+            }
+        }
+        return;
+    }
+
+    // Matrix-vector and vector-matrix products go to the bandwidth-bound kernels, which read the matrix in whichever
+    // order it is stored.
+    const auto matrixVector = columns == 1 && (aColumnStride == 1 || aRowStride == 1);
+    const auto vectorMatrix = rows == 1 && (bColumnStride == 1 || bRowStride == 1);
+    if (matrixVector || vectorMatrix)
+    {
+        scaleOutput(rows, columns, beta, c, cRowStride);
+        if (matrixVector && aColumnStride == 1)
+        {
+            unsafeGemv(rows, depth, alpha, a, aRowStride, b, bRowStride, c, cRowStride, executor);
+        }
+        else if (matrixVector)
+        {
+            unsafeGemvTransposed(rows, depth, alpha, a, aColumnStride, b, bRowStride, c, cRowStride, executor);
+        }
+        else if (bColumnStride == 1)
+        {
+            unsafeGemvTransposed(columns, depth, alpha, b, bRowStride, a, aColumnStride, c, 1, executor);
+        }
+        else
+        {
+            unsafeGemv(columns, depth, alpha, b, bColumnStride, a, aColumnStride, c, 1, executor);
+        }
+        return;
+    }
+
+    const auto& kernels = getKernels<T>();
+    const auto microRows = kernels.microRows;
+    const auto microColumns = kernels.microColumns;
+    const auto rowBlock = std::max(Blocking::rowBlock / microRows, 1) * microRows;
+    const auto rowBlocks = (rows + rowBlock - 1) / rowBlock;
+
+    const auto threads = multiplyAdds < gemmParallelThreshold ? 1 : executor.threadCount();
+    const auto wantedColumnBlocks = (4 * threads + rowBlocks - 1) / rowBlocks;
+    const auto columnBlock =
+        std::clamp((columns + wantedColumnBlocks - 1) / wantedColumnBlocks + microColumns - 1, microColumns,
+                   Blocking::columnBlock) /
+        microColumns * microColumns;
+    const auto columnBlocks = (columns + columnBlock - 1) / columnBlock;
+
+    const auto computeBlock = [&](int block)
+    {
+        const auto ic = block % rowBlocks * rowBlock;
+        const auto jc = block / rowBlocks * columnBlock;
+        const auto blockRows = std::min(rowBlock, rows - ic);
+        const auto blockColumns = std::min(columnBlock, columns - jc);
+        scaleOutput(blockRows, blockColumns, beta, c + ic * cRowStride + jc, cRowStride);
+        gemmBlock(kernels, blockRows, blockColumns, depth, alpha, a + ic * aRowStride, aRowStride, aColumnStride,
+                  b + jc * bColumnStride, bRowStride, bColumnStride, c + ic * cRowStride + jc, cRowStride);
+    };
+
+    if (threads == 1)
+    {
+        for (auto block = 0; block < rowBlocks * columnBlocks; ++block)
+        {
+            computeBlock(block);
+        }
+    }
+    else
+    {
+        executor.parallelFor(rowBlocks * columnBlocks, computeBlock);
+    }
+}
+
+}
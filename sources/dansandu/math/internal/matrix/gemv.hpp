@@ -0,0 +1,120 @@
+#pragma once
+
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/kernels.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace dansandu::math::matrix
+{
+
+// Matrix-vector products stream the matrix once and are bound by memory bandwidth, so they only pay off on several
+// threads once the matrix no longer fits in the caches.
+constexpr auto gemvParallelThreshold = 512 * 512;
+
+// Splits [0, length) into chunks whose sizes are multiples of the alignment and runs function(begin, end) for each of
+// them on the executor threads when the work is large enough.
+template<typename Function>
+void forEachChunk(size_type length, size_type alignment, long long work,
+                  const dansandu::math::thread_pool::Executor& executor, const Function& function)
+{
+    const auto threads = work < gemvParallelThreshold ? 1 : executor.threadCount();
+    if (threads == 1)
+    {
+        function(0, length);
+        return;
+    }
+
+    const auto wantedChunk = (length + 4 * threads - 1) / (4 * threads);
+    const auto chunk = std::max((wantedChunk + alignment - 1) / alignment, 1) * alignment;
+    const auto chunks = (length + chunk - 1) / chunk;
+    executor.parallelFor(chunks,
+                         [&](int index) { function(index * chunk, std::min(length, (index + 1) * chunk)); });
+}
+
+// Returns a pointer to the vector elements laid out contiguously, gathering them into the buffer if they are strided.
+template<typename T>
+const T* contiguousVector(size_type length, const T* vector, size_type stride, std::vector<T>& buffer)
+{
+    if (stride == 1)
+    {
+        return vector;
+    }
+    buffer.resize(length);
+    for (auto i = 0; i < length; ++i)
+    {
+        buffer[i] = vector[i * stride];
+    }
+    return buffer.data();
+}
+
+// Computes y += alpha * A * x where A is rows x depth and row-major with the given row stride. Every element of y is a
+// single dot product with a row of A, so the matrix is streamed once and the rows are split between the threads.
+template<typename T>
+void unsafeGemv(size_type rows, size_type depth, T alpha, const T* a, size_type aRowStride, const T* x,
+                size_type xStride, T* y, size_type yStride,
+                const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    if (rows == 0 || depth == 0)
+    {
+        return;
+    }
+
+    const auto& kernels = getKernels<T>();
+    static thread_local auto xBuffer = std::vector<T>{};
+    const auto contiguousX = contiguousVector(depth, x, xStride, xBuffer);
+    forEachChunk(rows, 16, static_cast<long long>(rows) * depth, executor,
+                 [&](size_type begin, size_type end)
+                 {
+                     for (auto i = begin; i < end; ++i)
+                     {
+                         y[i * yStride] += alpha * kernels.dot(depth, a + i * aRowStride, contiguousX);
+                     }
+                 });
+}
+
+// Computes y += alpha * transposed(A) * x where A is depth x columns and row-major with the given row stride. The
+// rows of A are accumulated into y, which the threads split by columns so that each one streams its own stripe of A.
+template<typename T>
+void unsafeGemvTransposed(size_type columns, size_type depth, T alpha, const T* a, size_type aRowStride, const T* x,
+                          size_type xStride, T* y, size_type yStride,
+                          const dansandu::math::thread_pool::Executor& executor =
+                              dansandu::math::thread_pool::Executor{})
+{
+    if (columns == 0 || depth == 0)
+    {
+        return;
+    }
+
+    const auto& kernels = getKernels<T>();
+    static thread_local auto yBuffer = std::vector<T>{};
+    auto target = y;
+    if (yStride != 1)
+    {
+        yBuffer.assign(columns, dansandu::math::common::additiveIdentity<T>);
+        target = yBuffer.data();
+    }
+
+    forEachChunk(columns, 64, static_cast<long long>(columns) * depth, executor,
+                 [&](size_type begin, size_type end)
+                 {
+                     for (auto p = 0; p < depth; ++p)
+                     {
+                         kernels.axpy(end - begin, alpha * x[p * xStride], a + p * aRowStride + begin, target + begin);
+                     }
+                 });
+
+    if (yStride != 1)
+    {
+        for (auto j = 0; j < columns; ++j)
+        {
+            y[j * yStride] += target[j];
+        }
+    }
+}
+
+}
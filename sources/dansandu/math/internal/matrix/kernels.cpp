@@ -0,0 +1,432 @@
+#include "dansandu/math/internal/matrix/kernels.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define DANSANDU_MATH_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace dansandu::math::matrix
+{
+
+#ifdef DANSANDU_MATH_X86_KERNELS
+
+#define DANSANDU_MATH_SSE __attribute__((target("sse2")))
+#define DANSANDU_MATH_AVX2 __attribute__((target("avx2,fma")))
+#define DANSANDU_MATH_AVX512 __attribute__((target("avx512f,avx2,fma")))
+
+namespace sse
+{
+
+DANSANDU_MATH_SSE inline __m128 load(const float* p)
+{
+    return _mm_loadu_ps(p);
+}
+
+DANSANDU_MATH_SSE inline __m128d load(const double* p)
+{
+    return _mm_loadu_pd(p);
+}
+
+DANSANDU_MATH_SSE inline void store(float* p, __m128 r)
+{
+    _mm_storeu_ps(p, r);
+}
+
+DANSANDU_MATH_SSE inline void store(double* p, __m128d r)
+{
+    _mm_storeu_pd(p, r);
+}
+
+DANSANDU_MATH_SSE inline __m128 broadcast(float s)
+{
+    return _mm_set1_ps(s);
+}
+
+DANSANDU_MATH_SSE inline __m128d broadcast(double s)
+{
+    return _mm_set1_pd(s);
+}
+
+DANSANDU_MATH_SSE inline __m128 add(__m128 a, __m128 b)
+{
+    return _mm_add_ps(a, b);
+}
+
+DANSANDU_MATH_SSE inline __m128d add(__m128d a, __m128d b)
+{
+    return _mm_add_pd(a, b);
+}
+
+DANSANDU_MATH_SSE inline __m128 subtract(__m128 a, __m128 b)
+{
+    return _mm_sub_ps(a, b);
+}
+
+DANSANDU_MATH_SSE inline __m128d subtract(__m128d a, __m128d b)
+{
+    return _mm_sub_pd(a, b);
+}
+
+DANSANDU_MATH_SSE inline __m128 multiplyAdd(__m128 a, __m128 b, __m128 c)
+{
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+
+DANSANDU_MATH_SSE inline __m128d multiplyAdd(__m128d a, __m128d b, __m128d c)
+{
+    return _mm_add_pd(_mm_mul_pd(a, b), c);
+}
+
+DANSANDU_MATH_SSE inline float sum(__m128 r)
+{
+    const auto pairs = _mm_add_ps(r, _mm_movehl_ps(r, r));
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+
+DANSANDU_MATH_SSE inline double sum(__m128d r)
+{
+    return _mm_cvtsd_f64(_mm_add_sd(r, _mm_unpackhi_pd(r, r)));
+}
+
+DANSANDU_MATH_SSE inline void transposeMicroKernel(const float* a, size_type aRowStride, float* c,
+                                                  size_type cRowStride)
+{
+    auto r0 = _mm_loadu_ps(a);
+    auto r1 = _mm_loadu_ps(a + aRowStride);
+    auto r2 = _mm_loadu_ps(a + 2 * aRowStride);
+    auto r3 = _mm_loadu_ps(a + 3 * aRowStride);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(c, r0);
+    _mm_storeu_ps(c + cRowStride, r1);
+    _mm_storeu_ps(c + 2 * cRowStride, r2);
+    _mm_storeu_ps(c + 3 * cRowStride, r3);
+}
+
+DANSANDU_MATH_SSE inline void transposeMicroKernel(const double* a, size_type aRowStride, double* c,
+                                                  size_type cRowStride)
+{
+    const auto r0 = _mm_loadu_pd(a);
+    const auto r1 = _mm_loadu_pd(a + aRowStride);
+    _mm_storeu_pd(c, _mm_unpacklo_pd(r0, r1));
+    _mm_storeu_pd(c + cRowStride, _mm_unpackhi_pd(r0, r1));
+}
+
+template<typename T>
+constexpr auto transposeSize = static_cast<size_type>(sizeof(__m128) / sizeof(T));
+
+#define DANSANDU_MATH_INSTRUCTION_SET sse
+#define DANSANDU_MATH_TARGET DANSANDU_MATH_SSE
+#define DANSANDU_MATH_MICRO_ROWS 4
+#include "dansandu/math/internal/matrix/kernels.inl"
+#undef DANSANDU_MATH_MICRO_ROWS
+#undef DANSANDU_MATH_TARGET
+#undef DANSANDU_MATH_INSTRUCTION_SET
+
+}
+
+namespace avx2
+{
+
+DANSANDU_MATH_AVX2 inline __m256 load(const float* p)
+{
+    return _mm256_loadu_ps(p);
+}
+
+DANSANDU_MATH_AVX2 inline __m256d load(const double* p)
+{
+    return _mm256_loadu_pd(p);
+}
+
+DANSANDU_MATH_AVX2 inline void store(float* p, __m256 r)
+{
+    _mm256_storeu_ps(p, r);
+}
+
+DANSANDU_MATH_AVX2 inline void store(double* p, __m256d r)
+{
+    _mm256_storeu_pd(p, r);
+}
+
+DANSANDU_MATH_AVX2 inline __m256 broadcast(float s)
+{
+    return _mm256_set1_ps(s);
+}
+
+DANSANDU_MATH_AVX2 inline __m256d broadcast(double s)
+{
+    return _mm256_set1_pd(s);
+}
+
+DANSANDU_MATH_AVX2 inline __m256 add(__m256 a, __m256 b)
+{
+    return _mm256_add_ps(a, b);
+}
+
+DANSANDU_MATH_AVX2 inline __m256d add(__m256d a, __m256d b)
+{
+    return _mm256_add_pd(a, b);
+}
+
+DANSANDU_MATH_AVX2 inline __m256 subtract(__m256 a, __m256 b)
+{
+    return _mm256_sub_ps(a, b);
+}
+
+DANSANDU_MATH_AVX2 inline __m256d subtract(__m256d a, __m256d b)
+{
+    return _mm256_sub_pd(a, b);
+}
+
+DANSANDU_MATH_AVX2 inline __m256 multiplyAdd(__m256 a, __m256 b, __m256 c)
+{
+    return _mm256_fmadd_ps(a, b, c);
+}
+
+DANSANDU_MATH_AVX2 inline __m256d multiplyAdd(__m256d a, __m256d b, __m256d c)
+{
+    return _mm256_fmadd_pd(a, b, c);
+}
+
+DANSANDU_MATH_AVX2 inline float sum(__m256 r)
+{
+    const auto quad = _mm_add_ps(_mm256_castps256_ps128(r), _mm256_extractf128_ps(r, 1));
+    const auto pairs = _mm_add_ps(quad, _mm_movehl_ps(quad, quad));
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+
+DANSANDU_MATH_AVX2 inline double sum(__m256d r)
+{
+    const auto pair = _mm_add_pd(_mm256_castpd256_pd128(r), _mm256_extractf128_pd(r, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+DANSANDU_MATH_AVX2 inline void transposeMicroKernel(const float* a, size_type aRowStride, float* c,
+                                                   size_type cRowStride)
+{
+    __m256 r[8];
+    for (auto i = 0; i < 8; ++i)
+    {
+        r[i] = _mm256_loadu_ps(a + i * aRowStride);
+    }
+
+    __m256 t[8];
+    for (auto i = 0; i < 8; i += 2)
+    {
+        t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+    }
+
+    __m256 s[8];
+    for (auto i = 0; i < 8; i += 4)
+    {
+        s[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+        s[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+        s[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+        s[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        _mm256_storeu_ps(c + i * cRowStride, _mm256_permute2f128_ps(s[i], s[i + 4], 0x20));
+        _mm256_storeu_ps(c + (i + 4) * cRowStride, _mm256_permute2f128_ps(s[i], s[i + 4], 0x31));
+    }
+}
+
+DANSANDU_MATH_AVX2 inline void transposeMicroKernel(const double* a, size_type aRowStride, double* c,
+                                                   size_type cRowStride)
+{
+    const auto r0 = _mm256_loadu_pd(a);
+    const auto r1 = _mm256_loadu_pd(a + aRowStride);
+    const auto r2 = _mm256_loadu_pd(a + 2 * aRowStride);
+    const auto r3 = _mm256_loadu_pd(a + 3 * aRowStride);
+    const auto t0 = _mm256_unpacklo_pd(r0, r1);
+    const auto t1 = _mm256_unpackhi_pd(r0, r1);
+    const auto t2 = _mm256_unpacklo_pd(r2, r3);
+    const auto t3 = _mm256_unpackhi_pd(r2, r3);
+    _mm256_storeu_pd(c, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(c + cRowStride, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(c + 2 * cRowStride, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(c + 3 * cRowStride, _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+template<typename T>
+constexpr auto transposeSize = static_cast<size_type>(sizeof(__m256) / sizeof(T));
+
+#define DANSANDU_MATH_INSTRUCTION_SET avx2
+#define DANSANDU_MATH_TARGET DANSANDU_MATH_AVX2
+#define DANSANDU_MATH_MICRO_ROWS 6
+#include "dansandu/math/internal/matrix/kernels.inl"
+#undef DANSANDU_MATH_MICRO_ROWS
+#undef DANSANDU_MATH_TARGET
+#undef DANSANDU_MATH_INSTRUCTION_SET
+
+}
+
+namespace avx512
+{
+
+DANSANDU_MATH_AVX512 inline __m512 load(const float* p)
+{
+    return _mm512_loadu_ps(p);
+}
+
+DANSANDU_MATH_AVX512 inline __m512d load(const double* p)
+{
+    return _mm512_loadu_pd(p);
+}
+
+DANSANDU_MATH_AVX512 inline void store(float* p, __m512 r)
+{
+    _mm512_storeu_ps(p, r);
+}
+
+DANSANDU_MATH_AVX512 inline void store(double* p, __m512d r)
+{
+    _mm512_storeu_pd(p, r);
+}
+
+DANSANDU_MATH_AVX512 inline __m512 broadcast(float s)
+{
+    return _mm512_set1_ps(s);
+}
+
+DANSANDU_MATH_AVX512 inline __m512d broadcast(double s)
+{
+    return _mm512_set1_pd(s);
+}
+
+DANSANDU_MATH_AVX512 inline __m512 add(__m512 a, __m512 b)
+{
+    return _mm512_add_ps(a, b);
+}
+
+DANSANDU_MATH_AVX512 inline __m512d add(__m512d a, __m512d b)
+{
+    return _mm512_add_pd(a, b);
+}
+
+DANSANDU_MATH_AVX512 inline __m512 subtract(__m512 a, __m512 b)
+{
+    return _mm512_sub_ps(a, b);
+}
+
+DANSANDU_MATH_AVX512 inline __m512d subtract(__m512d a, __m512d b)
+{
+    return _mm512_sub_pd(a, b);
+}
+
+DANSANDU_MATH_AVX512 inline __m512 multiplyAdd(__m512 a, __m512 b, __m512 c)
+{
+    return _mm512_fmadd_ps(a, b, c);
+}
+
+DANSANDU_MATH_AVX512 inline __m512d multiplyAdd(__m512d a, __m512d b, __m512d c)
+{
+    return _mm512_fmadd_pd(a, b, c);
+}
+
+// The halves are added by hand and passed to the 256-bit sums since the reduce and cast intrinsics of GCC read an
+// undefined register. Both halves are taken with the zero-masking extract of AVX-512F, which needs no DQ.
+DANSANDU_MATH_AVX512 inline float sum(__m512 r)
+{
+    const auto lower = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xff, _mm512_castps_pd(r), 0));
+    const auto upper = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xff, _mm512_castps_pd(r), 1));
+    return avx2::sum(_mm256_add_ps(lower, upper));
+}
+
+DANSANDU_MATH_AVX512 inline double sum(__m512d r)
+{
+    return avx2::sum(_mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xff, r, 0), _mm512_maskz_extractf64x4_pd(0xff, r, 1)));
+}
+
+// Transposing a 16x16 tile through 512-bit shuffles needs twice the shuffle steps for the same number of loads and
+// stores, so the 256-bit tiles are kept.
+using avx2::transposeMicroKernel;
+
+template<typename T>
+constexpr auto transposeSize = avx2::transposeSize<T>;
+
+#define DANSANDU_MATH_INSTRUCTION_SET avx512
+#define DANSANDU_MATH_TARGET DANSANDU_MATH_AVX512
+#define DANSANDU_MATH_MICRO_ROWS 12
+#include "dansandu/math/internal/matrix/kernels.inl"
+#undef DANSANDU_MATH_MICRO_ROWS
+#undef DANSANDU_MATH_TARGET
+#undef DANSANDU_MATH_INSTRUCTION_SET
+
+}
+
+#endif
+
+InstructionSet getSupportedInstructionSet()
+{
+#ifdef DANSANDU_MATH_X86_KERNELS
+    __builtin_cpu_init();
+    const auto avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    if (avx2 && __builtin_cpu_supports("avx512f"))
+    {
+        return InstructionSet::avx512;
+    }
+    if (avx2)
+    {
+        return InstructionSet::avx2;
+    }
+    return InstructionSet::sse;
+#else
+    return InstructionSet::scalar;
+#endif
+}
+
+template<typename T>
+static const Kernels<T>* getKernelsFor(InstructionSet instructionSet)
+{
+#ifdef DANSANDU_MATH_X86_KERNELS
+    static const auto sseKernels = sse::getKernels<T>();
+    static const auto avx2Kernels = avx2::getKernels<T>();
+    static const auto avx512Kernels = avx512::getKernels<T>();
+
+    const auto supported = getSupportedInstructionSet();
+    if (instructionSet == InstructionSet::avx512 && supported == InstructionSet::avx512)
+    {
+        return &avx512Kernels;
+    }
+    if (instructionSet == InstructionSet::avx2 &&
+        (supported == InstructionSet::avx2 || supported == InstructionSet::avx512))
+    {
+        return &avx2Kernels;
+    }
+    if (instructionSet == InstructionSet::sse)
+    {
+        return &sseKernels;
+    }
+#endif
+    return instructionSet == InstructionSet::scalar ? &getScalarKernels<T>() : nullptr;
+}
+
+template<>
+const Kernels<float>* getKernels<float>(InstructionSet instructionSet)
+{
+    return getKernelsFor<float>(instructionSet);
+}
+
+template<>
+const Kernels<double>* getKernels<double>(InstructionSet instructionSet)
+{
+    return getKernelsFor<double>(instructionSet);
+}
+
+template<>
+const Kernels<float>& getKernels<float>()
+{
+    static const auto& kernels = *getKernelsFor<float>(getSupportedInstructionSet());
+    return kernels;
+}
+
+template<>
+const Kernels<double>& getKernels<double>()
+{
+    static const auto& kernels = *getKernelsFor<double>(getSupportedInstructionSet());
+    return kernels;
+}
+
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+
+namespace dansandu::math::matrix
+{
+
+enum class InstructionSet
+{
+    scalar,
+    sse,
+    avx2,
+    avx512
+};
+
+template<typename T>
+struct Kernels
+{
+    InstructionSet instructionSet;
+
+    size_type microRows;
+
+    size_type microColumns;
+
+    // C += A * B for a full microRows x microColumns tile of C, where A and B are packed micro panels.
+    void (*gemmMicroKernel)(size_type depth, const T* packedA, const T* packedB, T* c, size_type rowStride);
+
+    T (*dot)(size_type length, const T* a, const T* b);
+
+    void (*axpy)(size_type length, T alpha, const T* x, T* y);
+
+    T (*squaredDistance)(size_type length, const T* a, const T* b);
+
+    size_type transposeSize;
+
+    // C = transposed(A) for a transposeSize x transposeSize tile, exchanging the elements inside the registers.
+    void (*transposeMicroKernel)(const T* a, size_type aRowStride, T* c, size_type cRowStride);
+};
+
+template<typename T, size_type MicroRows, size_type MicroColumns>
+void scalarGemmMicroKernel(size_type depth, const T* packedA, const T* packedB, T* c, size_type rowStride)
+{
+    T accumulator[MicroRows][MicroColumns] = {};
+    for (auto p = 0; p < depth; ++p)
+    {
+        for (auto i = 0; i < MicroRows; ++i)
+        {
+            const auto scalar = packedA[i];
+            for (auto j = 0; j < MicroColumns; ++j)
+            {
+                accumulator[i][j] += scalar * packedB[j];
+            }
+        }
+        packedA += MicroRows;
+        packedB += MicroColumns;
+    }
+
+    for (auto i = 0; i < MicroRows; ++i)
+    {
+        for (auto j = 0; j < MicroColumns; ++j)
+        {
+            c[i * rowStride + j] += accumulator[i][j];
+        }
+    }
+}
+
+template<typename T>
+T scalarDot(size_type length, const T* a, const T* b)
+{
+    auto sum = dansandu::math::common::additiveIdentity<T>;
+    for (auto i = 0; i < length; ++i)
+    {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+template<typename T>
+void scalarAxpy(size_type length, T alpha, const T* x, T* y)
+{
+    for (auto i = 0; i < length; ++i)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+
+template<typename T>
+T scalarSquaredDistance(size_type length, const T* a, const T* b)
+{
+    auto sum = dansandu::math::common::additiveIdentity<T>;
+    for (auto i = 0; i < length; ++i)
+    {
+        const auto difference = a[i] - b[i];
+        sum += difference * difference;
+    }
+    return sum;
+}
+
+template<typename T, size_type Size>
+void scalarTransposeMicroKernel(const T* a, size_type aRowStride, T* c, size_type cRowStride)
+{
+    for (auto i = 0; i < Size; ++i)
+    {
+        for (auto j = 0; j < Size; ++j)
+        {
+            c[j * cRowStride + i] = a[i * aRowStride + j];
+        }
+    }
+}
+
+template<typename T>
+const Kernels<T>& getScalarKernels()
+{
+    constexpr auto microRows = 4;
+    constexpr auto microColumns = sizeof(T) >= 8 ? 4 : 8;
+    constexpr auto transposeSize = 4;
+    static const auto kernels = Kernels<T>{InstructionSet::scalar,
+                                           microRows,
+                                           microColumns,
+                                           scalarGemmMicroKernel<T, microRows, microColumns>,
+                                           scalarDot<T>,
+                                           scalarAxpy<T>,
+                                           scalarSquaredDistance<T>,
+                                           transposeSize,
+                                           scalarTransposeMicroKernel<T, transposeSize>};
+    return kernels;
+}
+
+PRALINE_EXPORT InstructionSet getSupportedInstructionSet();
+
+// Returns the kernels for the given instruction set or nullptr if the processor does not support it.
+template<typename T>
+const Kernels<T>* getKernels(InstructionSet instructionSet)
+{
+    return instructionSet == InstructionSet::scalar ? &getScalarKernels<T>() : nullptr;
+}
+
+template<>
+PRALINE_EXPORT const Kernels<float>* getKernels<float>(InstructionSet instructionSet);
+
+template<>
+PRALINE_EXPORT const Kernels<double>* getKernels<double>(InstructionSet instructionSet);
+
+// Returns the kernels of the best instruction set supported by the processor, selected once on first use.
+template<typename T>
+const Kernels<T>& getKernels()
+{
+    return getScalarKernels<T>();
+}
+
+template<>
+PRALINE_EXPORT const Kernels<float>& getKernels<float>();
+
+template<>
+PRALINE_EXPORT const Kernels<double>& getKernels<double>();
+
+}
@@ -0,0 +1,146 @@
+// Instruction set independent kernel bodies, included once per instruction set namespace in kernels.cpp after the
+// load, store, broadcast, add, subtract, multiplyAdd and sum primitives of that instruction set are declared.
+// DANSANDU_MATH_TARGET holds the target attribute and DANSANDU_MATH_MICRO_ROWS the register tile height. The
+// transposeMicroKernel overloads and the transposeSize tile width are shuffle specific and come with the primitives.
+
+template<typename T>
+DANSANDU_MATH_TARGET void gemmMicroKernel(size_type depth, const T* packedA, const T* packedB, T* c,
+                                          size_type rowStride)
+{
+    using Register = decltype(load(packedB));
+    constexpr auto width = static_cast<size_type>(sizeof(Register) / sizeof(T));
+    constexpr auto microRows = DANSANDU_MATH_MICRO_ROWS;
+    constexpr auto lanes = 2;
+
+    Register accumulator[microRows][lanes];
+    for (auto i = 0; i < microRows; ++i)
+    {
+        for (auto j = 0; j < lanes; ++j)
+        {
+            accumulator[i][j] = broadcast(T{});
+        }
+    }
+
+    for (auto p = 0; p < depth; ++p)
+    {
+        Register b[lanes];
+        for (auto j = 0; j < lanes; ++j)
+        {
+            b[j] = load(packedB + j * width);
+        }
+        for (auto i = 0; i < microRows; ++i)
+        {
+            const auto a = broadcast(packedA[i]);
+            for (auto j = 0; j < lanes; ++j)
+            {
+                accumulator[i][j] = multiplyAdd(a, b[j], accumulator[i][j]);
+            }
+        }
+        packedA += microRows;
+        packedB += lanes * width;
+    }
+
+    for (auto i = 0; i < microRows; ++i)
+    {
+        for (auto j = 0; j < lanes; ++j)
+        {
+            const auto destination = c + i * rowStride + j * width;
+            store(destination, add(load(destination), accumulator[i][j]));
+        }
+    }
+}
+
+template<typename T>
+DANSANDU_MATH_TARGET T dot(size_type length, const T* a, const T* b)
+{
+    using Register = decltype(load(a));
+    constexpr auto width = static_cast<size_type>(sizeof(Register) / sizeof(T));
+
+    auto first = broadcast(T{});
+    auto second = broadcast(T{});
+    auto third = broadcast(T{});
+    auto fourth = broadcast(T{});
+    auto i = 0;
+    for (; i + 4 * width <= length; i += 4 * width)
+    {
+        first = multiplyAdd(load(a + i), load(b + i), first);
+        second = multiplyAdd(load(a + i + width), load(b + i + width), second);
+        third = multiplyAdd(load(a + i + 2 * width), load(b + i + 2 * width), third);
+        fourth = multiplyAdd(load(a + i + 3 * width), load(b + i + 3 * width), fourth);
+    }
+    for (; i + width <= length; i += width)
+    {
+        first = multiplyAdd(load(a + i), load(b + i), first);
+    }
+    auto result = sum(add(add(first, second), add(third, fourth)));
+    for (; i < length; ++i)
+    {
+        result += a[i] * b[i];
+    }
+    return result;
+}
+
+template<typename T>
+DANSANDU_MATH_TARGET void axpy(size_type length, T alpha, const T* x, T* y)
+{
+    using Register = decltype(load(x));
+    constexpr auto width = static_cast<size_type>(sizeof(Register) / sizeof(T));
+
+    const auto scalar = broadcast(alpha);
+    auto i = 0;
+    for (; i + width <= length; i += width)
+    {
+        store(y + i, multiplyAdd(scalar, load(x + i), load(y + i)));
+    }
+    for (; i < length; ++i)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+
+template<typename T>
+DANSANDU_MATH_TARGET T squaredDistance(size_type length, const T* a, const T* b)
+{
+    using Register = decltype(load(a));
+    constexpr auto width = static_cast<size_type>(sizeof(Register) / sizeof(T));
+
+    auto first = broadcast(T{});
+    auto second = broadcast(T{});
+    auto i = 0;
+    for (; i + 2 * width <= length; i += 2 * width)
+    {
+        const auto firstDifference = subtract(load(a + i), load(b + i));
+        const auto secondDifference = subtract(load(a + i + width), load(b + i + width));
+        first = multiplyAdd(firstDifference, firstDifference, first);
+        second = multiplyAdd(secondDifference, secondDifference, second);
+    }
+    for (; i + width <= length; i += width)
+    {
+        const auto difference = subtract(load(a + i), load(b + i));
+        first = multiplyAdd(difference, difference, first);
+    }
+    auto result = sum(add(first, second));
+    for (; i < length; ++i)
+    {
+        const auto difference = a[i] - b[i];
+        result += difference * difference;
+    }
+    return result;
+}
+
+template<typename T>
+Kernels<T> getKernels()
+{
+    using Register = decltype(load(static_cast<const T*>(nullptr)));
+    constexpr auto width = static_cast<size_type>(sizeof(Register) / sizeof(T));
+
+    return Kernels<T>{InstructionSet::DANSANDU_MATH_INSTRUCTION_SET,
+                      DANSANDU_MATH_MICRO_ROWS,
+                      2 * width,
+                      gemmMicroKernel<T>,
+                      dot<T>,
+                      axpy<T>,
+                      squaredDistance<T>,
+                      transposeSize<T>,
+                      transposeMicroKernel};
+}
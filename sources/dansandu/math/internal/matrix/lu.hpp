@@ -0,0 +1,211 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/matrix.hpp"
+#include "dansandu/math/internal/matrix/slicer.hpp"
+#include "dansandu/math/internal/matrix/trsm.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dansandu::math::matrix
+{
+
+// Columns are factored in panels of this width. Everything to the right of a panel is updated with trsm and gemm.
+constexpr auto luBlock = 64;
+
+// The factors of P * A = L * U packed into one matrix: L is below the diagonal with an implied unit diagonal and U is
+// on and above it. Row i of P * A is row permutation[i] of A, so getInvertedPermutation(permutation) gives the row of
+// the factors that each row of A ended up in.
+template<typename T>
+struct LuDecomposition
+{
+    Matrix<T> factors;
+    std::vector<int> permutation;
+};
+
+template<typename T>
+void swapRows(const MatrixView<T> matrix, size_type first, size_type second)
+{
+    if (first != second)
+    {
+        for (auto column = 0; column < matrix.columnCount(); ++column)
+        {
+            std::swap(matrix.unsafeSubscript(first, column), matrix.unsafeSubscript(second, column));
+        }
+    }
+}
+
+// Factors the panel of columns [k, k + width) with partial pivoting and rank-1 updates restricted to the panel. Rows
+// are swapped across the whole matrix so that the factors to the left and the trailing columns stay consistent.
+template<typename T>
+void factorLuPanel(const MatrixView<T> a, size_type k, size_type width, std::vector<int>& permutation)
+{
+    const auto rows = a.rowCount();
+    for (auto j = k; j < k + width; ++j)
+    {
+        auto pivot = j;
+        for (auto i = j + 1; i < rows; ++i)
+        {
+            if (std::abs(a.unsafeSubscript(i, j)) > std::abs(a.unsafeSubscript(pivot, j)))
+            {
+                pivot = i;
+            }
+        }
+        swapRows(a, j, pivot);
+        std::swap(permutation[j], permutation[pivot]);
+
+        const auto diagonal = a.unsafeSubscript(j, j);
+        if (diagonal == dansandu::math::common::additiveIdentity<T>)
+        {
+            continue;
+        }
+        for (auto i = j + 1; i < rows; ++i)
+        {
+            const auto factor = a.unsafeSubscript(i, j) /= diagonal;
+            for (auto column = j + 1; column < k + width; ++column)
+            {
+                a.unsafeSubscript(i, column) -= factor * a.unsafeSubscript(j, column);
+            }
+        }
+    }
+}
+
+// Overwrites the square matrix with its packed LU factors and returns the row permutation. The factorization is
+// right-looking: after each panel, the block row of U is solved with trsm and the trailing matrix is updated with gemm,
+// which is where nearly all the work is and what runs on the executor threads. Singular matrices are factored as well
+// and leave a zero on the diagonal of U.
+template<typename T>
+std::vector<int> luDecomposeInPlace(const MatrixView<T> a,
+                                    const dansandu::math::thread_pool::Executor& executor =
+                                        dansandu::math::thread_pool::Executor{})
+{
+    static_assert(std::is_floating_point_v<T>, "LU decomposition requires floating point matrices");
+
+    const auto n = a.rowCount();
+    if (a.columnCount() != n)
+    {
+        THROW(std::logic_error, "cannot LU decompose a ", a.rowCount(), "x", a.columnCount(),
+              " matrix -- the matrix must be square");
+    }
+
+    auto permutation = std::vector<int>(n);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    for (auto k = 0; k < n; k += luBlock)
+    {
+        const auto width = std::min(luBlock, n - k);
+        factorLuPanel(a, k, width, permutation);
+
+        const auto trailing = n - k - width;
+        if (trailing > 0)
+        {
+            const auto u12 = unsafeSlice(a, k, k + width, width, trailing);
+            trsm(Side::left, Triangle::lower, Transposition::none, Diagonal::unit, one,
+                 unsafeSlice(a, k, k, width, width), u12, executor);
+            gemm(-one, unsafeSlice(a, k + width, k, trailing, width), Transposition::none, u12, Transposition::none,
+                 one, unsafeSlice(a, k + width, k + width, trailing, trailing), executor);
+        }
+    }
+    return permutation;
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+LuDecomposition<T> luDecompose(const MatrixImplementation<T, M, N, S>& a,
+                               const dansandu::math::thread_pool::Executor& executor =
+                                   dansandu::math::thread_pool::Executor{})
+{
+    auto factors = Matrix<T>{a};
+    auto permutation = luDecomposeInPlace<T>(factors, executor);
+    return {std::move(factors), std::move(permutation)};
+}
+
+// Solves a * x = b for every column of b from the LU factors of a.
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+Matrix<T> solve(const LuDecomposition<T>& lu, const MatrixImplementation<T, M, N, S>& b,
+                const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    const auto n = lu.factors.rowCount();
+    if (b.rowCount() != n)
+    {
+        THROW(std::logic_error, "cannot solve a ", n, "x", n, " system for a ", b.rowCount(), "x", b.columnCount(),
+              " right-hand side -- the right-hand side must have as many rows as the system");
+    }
+    for (auto i = 0; i < n; ++i)
+    {
+        if (lu.factors.unsafeSubscript(i, i) == dansandu::math::common::additiveIdentity<T>)
+        {
+            THROW(std::logic_error, "cannot solve a singular ", n, "x", n, " system");
+        }
+    }
+
+    auto x = Matrix<T>{n, b.columnCount(), uninitialized};
+    for (auto i = 0; i < n; ++i)
+    {
+        sliceRow(x, i).deepCopy(sliceRow(b, lu.permutation[i]));
+    }
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    trsm(Side::left, Triangle::lower, Transposition::none, Diagonal::unit, one, lu.factors, x, executor);
+    trsm(Side::left, Triangle::upper, Transposition::none, Diagonal::nonUnit, one, lu.factors, x, executor);
+    return x;
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S, size_type MM, size_type NN,
+         DataStorageStrategy SS>
+Matrix<T> solve(const MatrixImplementation<T, M, N, S>& a, const MatrixImplementation<T, MM, NN, SS>& b,
+                const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    return solve(luDecompose(a, executor), b, executor);
+}
+
+// Small static matrices are inverted by the unrolled overload instead.
+template<typename T, size_type M, size_type N, DataStorageStrategy S,
+         typename = std::enable_if_t<!(isUnrolled(M, N) && M == N)>>
+Matrix<T> inverse(const MatrixImplementation<T, M, N, S>& a,
+                  const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    return solve(luDecompose(a, executor), identity<T>(a.rowCount()), executor);
+}
+
+template<typename T>
+T determinant(const LuDecomposition<T>& lu)
+{
+    // The sign of the permutation is the parity of the number of its even length cycles.
+    auto result = dansandu::math::common::multiplicativeIdentity<T>;
+    auto visited = std::vector<bool>(lu.permutation.size(), false);
+    for (auto start = std::size_t{0}; start < lu.permutation.size(); ++start)
+    {
+        auto length = 0;
+        for (auto index = start; !visited[index]; index = static_cast<std::size_t>(lu.permutation[index]))
+        {
+            visited[index] = true;
+            ++length;
+        }
+        if (length % 2 == 0 && length > 0)
+        {
+            result = -result;
+        }
+    }
+    for (auto i = 0; i < lu.factors.rowCount(); ++i)
+    {
+        result *= lu.factors.unsafeSubscript(i, i);
+    }
+    return result;
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S,
+         typename = std::enable_if_t<!(isUnrolled(M, N) && M == N)>>
+T determinant(const MatrixImplementation<T, M, N, S>& a,
+              const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    return determinant(luDecompose(a, executor));
+}
+
+}
@@ -0,0 +1,203 @@
+#include "dansandu/math/internal/matrix/mapped_file.hpp"
+#include "dansandu/ballotin/exception.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DANSANDU_MATH_POSIX_MAPPING
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dansandu::math::matrix
+{
+
+#ifdef DANSANDU_MATH_POSIX_MAPPING
+
+static int openFile(const std::string& path, int flags)
+{
+    const auto descriptor = ::open(path.c_str(), flags, 0644);
+    if (descriptor < 0)
+    {
+        THROW(std::runtime_error, "cannot open file '", path, "' -- ", std::strerror(errno));
+    }
+    return descriptor;
+}
+
+static std::size_t getPageSize()
+{
+    static const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return pageSize;
+}
+
+MappedFile::MappedFile(const std::string& path, MapMode mode, std::size_t offset, std::size_t length,
+                       bool hugePages)
+    : MappedFile{openFile(path, mode == MapMode::readOnly ? O_RDONLY : O_RDWR), path, mode, offset, length, hugePages}
+{
+}
+
+MappedFile MappedFile::create(const std::string& path, std::size_t length, bool hugePages)
+{
+    const auto descriptor = openFile(path, O_RDWR | O_CREAT | O_TRUNC);
+    if (::ftruncate(descriptor, static_cast<off_t>(length)) != 0)
+    {
+        const auto error = errno;
+        ::close(descriptor);
+        THROW(std::runtime_error, "cannot resize file '", path, "' to ", length, " bytes -- ", std::strerror(error));
+    }
+    return MappedFile{descriptor, path, MapMode::readWrite, 0, length, hugePages};
+}
+
+MappedFile::MappedFile(int descriptor, const std::string& path, MapMode mode, std::size_t offset,
+                       std::size_t length, bool hugePages)
+    : mapping_{nullptr}, mappingLength_{0}, data_{nullptr}, size_{length}, mode_{mode}
+{
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0)
+    {
+        const auto error = errno;
+        ::close(descriptor);
+        THROW(std::runtime_error, "cannot stat file '", path, "' -- ", std::strerror(error));
+    }
+
+    const auto fileSize = static_cast<std::size_t>(status.st_size);
+    if (offset > fileSize || length > fileSize - offset)
+    {
+        ::close(descriptor);
+        THROW(std::out_of_range, "cannot map ", length, " bytes at offset ", offset, " of file '", path, "' with ",
+              fileSize, " bytes -- the range must lie within the file");
+    }
+
+    if (length == 0)
+    {
+        ::close(descriptor);
+        return;
+    }
+
+    const auto pageOffset = offset / getPageSize() * getPageSize();
+    mappingLength_ = offset - pageOffset + length;
+    const auto protection = mode == MapMode::readOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+    mapping_ = ::mmap(nullptr, mappingLength_, protection, MAP_SHARED, descriptor, static_cast<off_t>(pageOffset));
+    const auto error = errno;
+    ::close(descriptor);
+    if (mapping_ == MAP_FAILED)
+    {
+        mapping_ = nullptr;
+        THROW(std::runtime_error, "cannot map file '", path, "' -- ", std::strerror(error));
+    }
+    data_ = static_cast<std::byte*>(mapping_) + (offset - pageOffset);
+
+#ifdef MADV_HUGEPAGE
+    if (hugePages)
+    {
+        ::madvise(mapping_, mappingLength_, MADV_HUGEPAGE);
+    }
+#else
+    static_cast<void>(hugePages);
+#endif
+}
+
+void MappedFile::advise(AccessPattern pattern, std::size_t offset, std::size_t length) const
+{
+    if (offset > size_ || length > size_ - offset)
+    {
+        THROW(std::out_of_range, "cannot advise on ", length, " bytes at offset ", offset, " of a ", size_,
+              " bytes mapping");
+    }
+
+    if (length == 0)
+    {
+        return;
+    }
+
+    const auto advice = pattern == AccessPattern::sequential ? MADV_SEQUENTIAL
+                        : pattern == AccessPattern::random   ? MADV_RANDOM
+                        : pattern == AccessPattern::willNeed ? MADV_WILLNEED
+                        : pattern == AccessPattern::dontNeed ? MADV_DONTNEED
+                                                             : MADV_NORMAL;
+    const auto begin = static_cast<std::size_t>(data_ - static_cast<std::byte*>(mapping_)) + offset;
+    const auto pageBegin = begin / getPageSize() * getPageSize();
+    if (::madvise(static_cast<std::byte*>(mapping_) + pageBegin, begin - pageBegin + length, advice) != 0)
+    {
+        THROW(std::runtime_error, "cannot advise on the mapped pages -- ", std::strerror(errno));
+    }
+}
+
+void MappedFile::flush() const
+{
+    if (mapping_ && mode_ == MapMode::readWrite && ::msync(mapping_, mappingLength_, MS_SYNC) != 0)
+    {
+        THROW(std::runtime_error, "cannot flush the mapped pages -- ", std::strerror(errno));
+    }
+}
+
+void MappedFile::unmap()
+{
+    if (mapping_)
+    {
+        ::munmap(mapping_, mappingLength_);
+        mapping_ = nullptr;
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string&, MapMode, std::size_t, std::size_t, bool)
+    : mapping_{nullptr}, mappingLength_{0}, data_{nullptr}, size_{0}, mode_{MapMode::readOnly}
+{
+    THROW(std::runtime_error, "memory mapped files are not supported on this platform");
+}
+
+MappedFile MappedFile::create(const std::string& path, std::size_t length, bool hugePages)
+{
+    return MappedFile{path, MapMode::readWrite, 0, length, hugePages};
+}
+
+void MappedFile::advise(AccessPattern, std::size_t, std::size_t) const
+{
+}
+
+void MappedFile::flush() const
+{
+}
+
+void MappedFile::unmap()
+{
+}
+
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mapping_{std::exchange(other.mapping_, nullptr)},
+      mappingLength_{std::exchange(other.mappingLength_, 0)},
+      data_{std::exchange(other.data_, nullptr)},
+      size_{std::exchange(other.size_, 0)},
+      mode_{other.mode_}
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        mappingLength_ = std::exchange(other.mappingLength_, 0);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        mode_ = other.mode_;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+}
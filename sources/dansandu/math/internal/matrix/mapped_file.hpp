@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace dansandu::math::matrix
+{
+
+enum class MapMode
+{
+    readOnly,
+    readWrite
+};
+
+// Hints forwarded to the kernel about how the mapped pages are going to be read.
+enum class AccessPattern
+{
+    normal,
+    sequential,
+    random,
+    willNeed,
+    dontNeed
+};
+
+// Owns a shared memory mapping of a byte range of a file. The range may start at any offset, the mapping itself is
+// widened to page boundaries. Huge pages are requested with madvise and silently ignored where the kernel or the file
+// system does not support them for file backed memory.
+class PRALINE_EXPORT MappedFile
+{
+public:
+    MappedFile(const std::string& path, MapMode mode, std::size_t offset, std::size_t length, bool hugePages);
+
+    // Creates or truncates the file to the given length, zero filled, and maps it for reading and writing.
+    static MappedFile create(const std::string& path, std::size_t length, bool hugePages);
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    // Applies the hint to the pages overlapping [offset, offset + length) of the mapped range.
+    void advise(AccessPattern pattern, std::size_t offset, std::size_t length) const;
+
+    // Writes the modified pages back to the file and waits for the writes to complete.
+    void flush() const;
+
+    std::byte* data()
+    {
+        return data_;
+    }
+
+    const std::byte* data() const
+    {
+        return data_;
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    MapMode mode() const
+    {
+        return mode_;
+    }
+
+private:
+    MappedFile(int descriptor, const std::string& path, MapMode mode, std::size_t offset, std::size_t length,
+               bool hugePages);
+
+    void unmap();
+
+    void* mapping_;
+    std::size_t mappingLength_;
+    std::byte* data_;
+    std::size_t size_;
+    MapMode mode_;
+};
+
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/mapped_file.hpp"
+#include "dansandu/math/internal/matrix/matrix.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace dansandu::math::matrix
+{
+
+// A rows x columns matrix whose elements live in a memory mapped file in either layout, so files larger than the memory
+// are paged in on demand and nothing is parsed up front. The elements are used through views, which work with Slicer,
+// the arithmetic operators, gemm and kMeans like any other view and must not outlive the mapped matrix. Views address
+// their elements with size_type offsets, so a row-major matrix with more elements than size_type can count is used
+// through views of row blocks that each fit, and only the views of the whole matrix are limited to that many elements.
+template<typename T>
+class MappedMatrix
+{
+public:
+    static_assert(std::is_trivially_copyable_v<T>, "mapped matrix elements must be trivially copyable");
+
+    // Maps the elements stored at the given byte offset of an existing file.
+    MappedMatrix(const std::string& path, size_type rows, size_type columns, MapMode mode = MapMode::readOnly,
+                 std::size_t offset = 0, bool hugePages = false, Layout layout = Layout::rowMajor)
+        : rows_{rows},
+          columns_{columns},
+          layout_{layout},
+          file_{path, mode, validateOffset(offset), getByteCount(rows, columns), hugePages}
+    {
+        if (layout_ == Layout::columnMajor && !fitsInView(rows_, columns_))
+        {
+            THROW(std::out_of_range, "cannot map a column-major ", rows_, "x", columns_, " matrix -- it has more than ",
+                  std::numeric_limits<size_type>::max(), " elements and column-major views cannot be split by rows");
+        }
+    }
+
+    // Creates or truncates the file to hold a zero filled rows x columns matrix mapped for reading and writing.
+    static MappedMatrix create(const std::string& path, size_type rows, size_type columns, bool hugePages = false)
+    {
+        return MappedMatrix{rows, columns, MappedFile::create(path, getByteCount(rows, columns), hugePages)};
+    }
+
+    auto rowCount() const
+    {
+        return rows_;
+    }
+
+    auto columnCount() const
+    {
+        return columns_;
+    }
+
+    auto mode() const
+    {
+        return file_.mode();
+    }
+
+    auto layout() const
+    {
+        return layout_;
+    }
+
+    MatrixView<T> view()
+    {
+        validateMutable();
+        validateViewSize(rows_);
+        return MatrixView<T>{rows_, columns_, layout_, reinterpret_cast<T*>(file_.data())};
+    }
+
+    ConstantMatrixView<T> constantView() const
+    {
+        validateViewSize(rows_);
+        return ConstantMatrixView<T>{rows_, columns_, layout_, reinterpret_cast<const T*>(file_.data())};
+    }
+
+    // Returns a view of the given rows of a row-major matrix. The offset of the first row is computed in
+    // std::ptrdiff_t, so blocks can be taken from anywhere in matrices of any size as long as each block fits.
+    MatrixView<T> rowsView(size_type firstRow, size_type rows)
+    {
+        validateMutable();
+        validateRows(firstRow, rows);
+        validateViewSize(rows);
+        return MatrixView<T>{rows, columns_, layout_, reinterpret_cast<T*>(file_.data()) + getRowOffset(firstRow)};
+    }
+
+    ConstantMatrixView<T> constantRowsView(size_type firstRow, size_type rows) const
+    {
+        validateRows(firstRow, rows);
+        validateViewSize(rows);
+        return ConstantMatrixView<T>{rows, columns_, layout_,
+                                     reinterpret_cast<const T*>(file_.data()) + getRowOffset(firstRow)};
+    }
+
+    void advise(AccessPattern pattern) const
+    {
+        file_.advise(pattern, 0, file_.size());
+    }
+
+    // Applies the hint to the given rows only, e.g. to prefetch the next chunk or drop the one already processed.
+    void adviseRows(AccessPattern pattern, size_type firstRow, size_type rows) const
+    {
+        validateRows(firstRow, rows);
+        file_.advise(pattern, static_cast<std::size_t>(firstRow) * columns_ * sizeof(T),
+                     static_cast<std::size_t>(rows) * columns_ * sizeof(T));
+    }
+
+    void flush() const
+    {
+        file_.flush();
+    }
+
+private:
+    MappedMatrix(size_type rows, size_type columns, MappedFile file)
+        : rows_{rows}, columns_{columns}, layout_{Layout::rowMajor}, file_{std::move(file)}
+    {
+    }
+
+    static std::size_t getByteCount(size_type rows, size_type columns)
+    {
+        if (rows < 0 || columns < 0)
+        {
+            THROW(std::out_of_range, "matrix dimensions cannot be negative ", rows, "x", columns);
+        }
+        return static_cast<std::size_t>(rows) * static_cast<std::size_t>(columns) * sizeof(T);
+    }
+
+    static bool fitsInView(size_type rows, size_type columns)
+    {
+        return rows == 0 || columns <= std::numeric_limits<size_type>::max() / rows;
+    }
+
+    std::ptrdiff_t getRowOffset(size_type row) const
+    {
+        return static_cast<std::ptrdiff_t>(row) * static_cast<std::ptrdiff_t>(columns_);
+    }
+
+    void validateMutable() const
+    {
+        if (mode() == MapMode::readOnly)
+        {
+            THROW(std::logic_error, "cannot get a mutable view of a read-only mapped ", rows_, "x", columns_,
+                  " matrix");
+        }
+    }
+
+    void validateRows(size_type firstRow, size_type rows) const
+    {
+        if (layout_ != Layout::rowMajor)
+        {
+            THROW(std::logic_error, "cannot address the rows of a column-major mapped matrix -- rows are not "
+                                    "contiguous");
+        }
+        if (firstRow < 0 || rows < 0 || firstRow > rows_ || rows > rows_ - firstRow)
+        {
+            THROW(std::out_of_range, "cannot address ", rows, " rows from row ", firstRow, " of a mapped ", rows_,
+                  "x", columns_, " matrix");
+        }
+    }
+
+    void validateViewSize(size_type rows) const
+    {
+        if (!fitsInView(rows, columns_))
+        {
+            THROW(std::out_of_range, "cannot view ", rows, " rows of a mapped ", rows_, "x", columns_,
+                  " matrix at once -- views hold at most ", std::numeric_limits<size_type>::max(),
+                  " elements, use smaller row blocks");
+        }
+    }
+
+    static std::size_t validateOffset(std::size_t offset)
+    {
+        if (offset % alignof(T) != 0)
+        {
+            THROW(std::invalid_argument, "mapped matrix offset ", offset, " is not aligned to ", alignof(T),
+                  " bytes");
+        }
+        return offset;
+    }
+
+    size_type rows_;
+    size_type columns_;
+    Layout layout_;
+    MappedFile file_;
+};
+
+}
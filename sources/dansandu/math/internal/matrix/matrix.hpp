@@ -3,12 +3,21 @@
 #include "dansandu/ballotin/exception.hpp"
 #include "dansandu/math/common.hpp"
 #include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/data_storage_column_major_heap.hpp"
 #include "dansandu/math/internal/matrix/data_storage_constant_view.hpp"
 #include "dansandu/math/internal/matrix/data_storage_heap.hpp"
+#include "dansandu/math/internal/matrix/data_storage_small_buffer.hpp"
 #include "dansandu/math/internal/matrix/data_storage_stack.hpp"
 #include "dansandu/math/internal/matrix/data_storage_view.hpp"
+#include "dansandu/math/internal/matrix/expression.hpp"
+#include "dansandu/math/internal/matrix/gemm.hpp"
+#include "dansandu/math/internal/matrix/kernels.hpp"
+#include "dansandu/math/internal/matrix/transpose.hpp"
+#include "dansandu/math/internal/matrix/unrolled.hpp"
+#include "dansandu/math/thread_pool.hpp"
 
 #include <algorithm>
+#include <type_traits>
 
 namespace dansandu::math::matrix
 {
@@ -32,17 +41,17 @@ public:
     static constexpr auto dataStorageStrategy = S;
 
     template<typename TT = T, typename = std::enable_if_t<isContainer(S), TT>>
-    MatrixImplementation()
+    constexpr MatrixImplementation()
     {
     }
 
     template<size_type L, typename = std::enable_if_t<isContainer(S) && isVectorOfLength(M, N, L)>>
-    explicit MatrixImplementation(const T (&array)[L]) : dataStorage_{array}
+    constexpr explicit MatrixImplementation(const T (&array)[L]) : dataStorage_{array}
     {
     }
 
     template<size_type MM, size_type NN, typename = std::enable_if_t<isContainer(S) && dimensionsMatch(M, N, MM, NN)>>
-    explicit MatrixImplementation(const T (&array)[MM][NN]) : dataStorage_{array}
+    constexpr explicit MatrixImplementation(const T (&array)[MM][NN]) : dataStorage_{array}
     {
     }
 
@@ -53,8 +62,29 @@ public:
     {
     }
 
+    template<typename TT = T, typename = std::enable_if_t<isContainer(S), TT>>
+    MatrixImplementation(size_type rows, size_type columns, Uninitialized)
+        : dataStorage_{rows, columns, uninitialized}
+    {
+    }
+
+    template<typename TT = T, typename = std::enable_if_t<S == DataStorageStrategy::heap ||
+                                                              S == DataStorageStrategy::smallBuffer,
+                                                          TT>>
+    MatrixImplementation(size_type rows, size_type columns, Padding padding,
+                         const T& fillValue = dansandu::math::common::additiveIdentity<T>)
+        : dataStorage_{rows, columns, padding, fillValue}
+    {
+    }
+
     template<typename TT = T, typename = std::enable_if_t<isHeapContainer(S), TT>>
-    MatrixImplementation(size_type rows, size_type columns, std::vector<T> buffer)
+    MatrixImplementation(size_type rows, size_type columns, const std::vector<T>& buffer)
+        : dataStorage_{rows, columns, buffer}
+    {
+    }
+
+    template<typename TT = T, typename = std::enable_if_t<isHeapContainer(S), TT>>
+    MatrixImplementation(size_type rows, size_type columns, AlignedVector<T> buffer)
         : dataStorage_{rows, columns, std::move(buffer)}
     {
     }
@@ -67,16 +97,30 @@ public:
     }
 
     template<typename TT = T, typename = std::enable_if_t<isView(S), TT>>
-    MatrixImplementation(size_type viewRowCount, size_type viewColumnCount, size_type sourceRowCount,
-                         size_type sourceColumnCount, T* viewBegin)
-        : dataStorage_{viewRowCount, viewColumnCount, sourceRowCount, sourceColumnCount, viewBegin}
+    MatrixImplementation(size_type viewRowCount, size_type viewColumnCount, size_type rowStride, size_type columnStride,
+                         T* viewBegin)
+        : dataStorage_{viewRowCount, viewColumnCount, rowStride, columnStride, viewBegin}
     {
     }
 
     template<typename TT = T, typename = std::enable_if_t<isConstantView(S), TT>>
-    MatrixImplementation(size_type viewRowCount, size_type viewColumnCount, size_type sourceRowCount,
-                         size_type sourceColumnCount, const T* viewBegin)
-        : dataStorage_{viewRowCount, viewColumnCount, sourceRowCount, sourceColumnCount, viewBegin}
+    MatrixImplementation(size_type viewRowCount, size_type viewColumnCount, size_type rowStride, size_type columnStride,
+                         const T* viewBegin)
+        : dataStorage_{viewRowCount, viewColumnCount, rowStride, columnStride, viewBegin}
+    {
+    }
+
+    template<typename TT = T, typename = std::enable_if_t<isView(S), TT>>
+    MatrixImplementation(size_type viewRowCount, size_type viewColumnCount, Layout layout, T* viewBegin)
+        : dataStorage_{viewRowCount, viewColumnCount, layout == Layout::rowMajor ? viewColumnCount : 1,
+                       layout == Layout::rowMajor ? 1 : viewRowCount, viewBegin}
+    {
+    }
+
+    template<typename TT = T, typename = std::enable_if_t<isConstantView(S), TT>>
+    MatrixImplementation(size_type viewRowCount, size_type viewColumnCount, Layout layout, const T* viewBegin)
+        : dataStorage_{viewRowCount, viewColumnCount, layout == Layout::rowMajor ? viewColumnCount : 1,
+                       layout == Layout::rowMajor ? 1 : viewRowCount, viewBegin}
     {
     }
 
@@ -93,8 +137,7 @@ public:
         std::enable_if_t<
             isView(S) && isContainer(SS) && dimensionsMatch(M, N, MM, NN) && (M != MM || N != NN || S != SS), int> = 0>
     MatrixImplementation(MatrixImplementation<T, MM, NN, SS>& other)
-        : dataStorage_{other.rowCount(), other.columnCount(), other.sourceRowCount(), other.sourceColumnCount(),
-                       other.data()}
+        : dataStorage_{other.rowCount(), other.columnCount(), other.rowStride(), other.columnStride(), other.data()}
     {
     }
 
@@ -103,8 +146,7 @@ public:
                                   (M != MM || N != NN || S != SS),
                               int> = 0>
     MatrixImplementation(const MatrixImplementation<T, MM, NN, SS>& other)
-        : dataStorage_{other.rowCount(), other.columnCount(), other.sourceRowCount(), other.sourceColumnCount(),
-                       other.data()}
+        : dataStorage_{other.rowCount(), other.columnCount(), other.rowStride(), other.columnStride(), other.data()}
     {
     }
 
@@ -114,6 +156,33 @@ public:
                               int> = 0>
     MatrixImplementation(MatrixImplementation<T, MM, NN, SS>&& other) = delete;
 
+    template<typename E, std::enable_if_t<isContainer(S) && isMatrixExpression<E> &&
+                                              dimensionsMatch(M, N, E::staticRowCount, E::staticColumnCount),
+                                          int> = 0>
+    MatrixImplementation(const E& expression)
+        : dataStorage_{expression.rowCount(), expression.columnCount(), uninitialized}
+    {
+        assignExpression(expression, data(), rowStride(), columnStride(),
+                         [](auto& target, auto value) { target = value; });
+    }
+
+    template<typename E, typename = std::enable_if_t<isContainer(S) && isMatrixExpression<E> &&
+                                                     dimensionsMatch(M, N, E::staticRowCount, E::staticColumnCount)>>
+    auto& operator=(const E& expression)
+    {
+        if (rowCount() == expression.rowCount() && columnCount() == expression.columnCount() &&
+            !aliases(expression, *this))
+        {
+            assignExpression(expression, data(), rowStride(), columnStride(),
+                             [](auto& target, auto value) { target = value; });
+        }
+        else
+        {
+            *this = MatrixImplementation{expression};
+        }
+        return *this;
+    }
+
     template<size_type MM, size_type NN, DataStorageStrategy SS,
              typename = std::enable_if_t<isView(S) && dimensionsMatch(M, N, MM, NN)>>
     void deepCopy(const MatrixImplementation<T, MM, NN, SS>& other) const
@@ -129,6 +198,24 @@ public:
         std::copy(other.cbegin(), other.cend(), begin());
     }
 
+    template<typename E, typename = std::enable_if_t<isView(S) && isMatrixExpression<E> &&
+                                                     dimensionsMatch(M, N, E::staticRowCount, E::staticColumnCount)>>
+    void deepCopy(const E& expression) const
+    {
+        if (rowCount() != expression.rowCount() || columnCount() != expression.columnCount())
+        {
+            THROW(std::logic_error, "cannot copy matrices ", rowCount(), "x", columnCount(), " and ",
+                  expression.rowCount(), "x", expression.columnCount(), " -- matrix dimensions do not match");
+        }
+        if (aliases(expression, *this))
+        {
+            deepCopy(MatrixImplementation<T, M, N, DataStorageStrategyFor<T, M, N>::value>{expression});
+            return;
+        }
+        assignExpression(expression, data(), rowStride(), columnStride(),
+                         [](auto& target, auto value) { target = value; });
+    }
+
     template<size_type MM, size_type NN, DataStorageStrategy SS,
              typename = std::enable_if_t<isContainer(S) && dimensionsMatch(M, N, MM, NN)>>
     auto& operator+=(const MatrixImplementation<T, MM, NN, SS>& other)
@@ -141,7 +228,7 @@ public:
                       other.rowCount(), "x", other.columnCount(), " -- matrix dimensions do not match");
             }
         }
-        std::transform(cbegin(), cend(), other.cbegin(), begin(), dansandu::math::common::Add{});
+        addScaledRows(data(), other, dansandu::math::common::multiplicativeIdentity<T>);
         return *this;
     }
 
@@ -157,7 +244,7 @@ public:
                       other.rowCount(), "x", other.columnCount(), " -- matrix dimensions do not match");
             }
         }
-        std::transform(cbegin(), cend(), other.cbegin(), begin(), dansandu::math::common::Add{});
+        addScaledRows(data(), other, dansandu::math::common::multiplicativeIdentity<T>);
         return *this;
     }
 
@@ -173,7 +260,7 @@ public:
                       other.rowCount(), "x", other.columnCount(), " -- matrix dimensions do not match");
             }
         }
-        std::transform(cbegin(), cend(), other.cbegin(), begin(), dansandu::math::common::Subtract{});
+        addScaledRows(data(), other, -dansandu::math::common::multiplicativeIdentity<T>);
         return *this;
     }
 
@@ -189,7 +276,39 @@ public:
                       other.rowCount(), "x", other.columnCount(), " -- matrix dimensions do not match");
             }
         }
-        std::transform(cbegin(), cend(), other.cbegin(), begin(), dansandu::math::common::Subtract{});
+        addScaledRows(data(), other, -dansandu::math::common::multiplicativeIdentity<T>);
+        return *this;
+    }
+
+    template<typename E, typename = std::enable_if_t<isContainer(S) && isMatrixExpression<E> &&
+                                                     dimensionsMatch(M, N, E::staticRowCount, E::staticColumnCount)>>
+    auto& operator+=(const E& expression)
+    {
+        assignScaledExpression(data(), "add", expression, dansandu::math::common::multiplicativeIdentity<T>);
+        return *this;
+    }
+
+    template<typename E, typename = std::enable_if_t<isView(S) && isMatrixExpression<E> &&
+                                                     dimensionsMatch(M, N, E::staticRowCount, E::staticColumnCount)>>
+    auto& operator+=(const E& expression) const
+    {
+        assignScaledExpression(data(), "add", expression, dansandu::math::common::multiplicativeIdentity<T>);
+        return *this;
+    }
+
+    template<typename E, typename = std::enable_if_t<isContainer(S) && isMatrixExpression<E> &&
+                                                     dimensionsMatch(M, N, E::staticRowCount, E::staticColumnCount)>>
+    auto& operator-=(const E& expression)
+    {
+        assignScaledExpression(data(), "subtract", expression, -dansandu::math::common::multiplicativeIdentity<T>);
+        return *this;
+    }
+
+    template<typename E, typename = std::enable_if_t<isView(S) && isMatrixExpression<E> &&
+                                                     dimensionsMatch(M, N, E::staticRowCount, E::staticColumnCount)>>
+    auto& operator-=(const E& expression) const
+    {
+        assignScaledExpression(data(), "subtract", expression, -dansandu::math::common::multiplicativeIdentity<T>);
         return *this;
     }
 
@@ -221,8 +340,6 @@ public:
         return *this;
     }
 
-    auto operator-() const;
-
     template<typename TT = T, typename = std::enable_if_t<isContainer(S) && !isNullMatrix(M, N), TT>>
     auto& operator()(size_type row, size_type column)
     {
@@ -307,24 +424,26 @@ public:
         }
     }
 
-    auto rowCount() const
+    constexpr auto rowCount() const
     {
         return dataStorage_.rowCount();
     }
 
-    auto columnCount() const
+    constexpr auto columnCount() const
     {
         return dataStorage_.columnCount();
     }
 
-    auto sourceRowCount() const
+    // The distance in elements between consecutive rows and between consecutive columns. The strides alone describe
+    // the layout, since containers may be row-major or column-major and views may be strided in both directions.
+    constexpr auto rowStride() const
     {
-        return dataStorage_.sourceRowCount();
+        return dataStorage_.rowStride();
     }
 
-    auto sourceColumnCount() const
+    constexpr auto columnStride() const
     {
-        return dataStorage_.sourceColumnCount();
+        return dataStorage_.columnStride();
     }
 
     template<typename TT = T, typename = std::enable_if_t<isVector(M, N), TT>>
@@ -341,37 +460,37 @@ public:
     }
 
     template<typename TT = T, typename = std::enable_if_t<isContainer(S), TT>>
-    auto& unsafeSubscript(size_type row, size_type column)
+    constexpr auto& unsafeSubscript(size_type row, size_type column)
     {
         return dataStorage_.unsafeSubscript(row, column);
     }
 
     template<typename TT = T, typename = std::enable_if_t<isView(S), TT>>
-    auto& unsafeSubscript(size_type row, size_type column) const
+    constexpr auto& unsafeSubscript(size_type row, size_type column) const
     {
         return dataStorage_.unsafeSubscript(row, column);
     }
 
     template<typename TT = T, typename = std::enable_if_t<!isView(S), TT>>
-    const auto& unsafeSubscript(size_type row, size_type column) const
+    constexpr const auto& unsafeSubscript(size_type row, size_type column) const
     {
         return dataStorage_.unsafeSubscript(row, column);
     }
 
     template<typename TT = T, typename = std::enable_if_t<isContainer(S), TT>>
-    auto& unsafeSubscript(size_type coordinate)
+    constexpr auto& unsafeSubscript(size_type coordinate)
     {
         return dataStorage_.unsafeSubscript(coordinate);
     }
 
     template<typename TT = T, typename = std::enable_if_t<isView(S), TT>>
-    auto& unsafeSubscript(size_type coordinate) const
+    constexpr auto& unsafeSubscript(size_type coordinate) const
     {
         return dataStorage_.unsafeSubscript(coordinate);
     }
 
     template<typename TT = T, typename = std::enable_if_t<!isView(S), TT>>
-    const auto& unsafeSubscript(size_type coordinate) const
+    constexpr const auto& unsafeSubscript(size_type coordinate) const
     {
         return dataStorage_.unsafeSubscript(coordinate);
     }
@@ -533,54 +652,119 @@ public:
     }
 
     template<typename TT = T, typename = std::enable_if_t<isContainer(S), TT>>
-    auto begin()
+    constexpr auto begin()
     {
         return dataStorage_.begin();
     }
 
     template<typename TT = T, typename = std::enable_if_t<isContainer(S), TT>>
-    auto end()
+    constexpr auto end()
     {
         return dataStorage_.end();
     }
 
-    auto begin() const
+    constexpr auto begin() const
     {
         return dataStorage_.begin();
     }
 
-    auto end() const
+    constexpr auto end() const
     {
         return dataStorage_.end();
     }
 
-    auto cbegin() const
+    constexpr auto cbegin() const
     {
         return dataStorage_.cbegin();
     }
 
-    auto cend() const
+    constexpr auto cend() const
     {
         return dataStorage_.cend();
     }
 
     template<typename TT = T, typename = std::enable_if_t<isContainer(S), TT>>
-    auto data()
+    constexpr auto data()
     {
         return dataStorage_.data();
     }
 
-    auto data() const
+    constexpr auto data() const
     {
         return dataStorage_.data();
     }
 
+    // Reinterprets the elements as a rows x columns matrix in the same layout without moving them.
+    template<typename TT = T, typename = std::enable_if_t<isHeapContainer(S), TT>>
+    void reshape(size_type rows, size_type columns)
+    {
+        dataStorage_.reshape(rows, columns);
+    }
+
 private:
+    template<size_type MM, size_type NN, DataStorageStrategy SS>
+    void addScaledRows(T* target, const MatrixImplementation<T, MM, NN, SS>& source, T alpha) const
+    {
+        if (aliases(source, *this))
+        {
+            addScaledRows(target, MatrixImplementation<T, MM, NN, DataStorageStrategyFor<T, MM, NN>::value>{source},
+                          alpha);
+            return;
+        }
+
+        const auto& kernels = getKernels<T>();
+        if (rowStride() == 1 && source.rowStride() == 1 && columnStride() != 1)
+        {
+            // Both operands are stored column by column, so the columns are accumulated instead of the rows.
+            for (auto column = 0; column < columnCount(); ++column)
+            {
+                kernels.axpy(rowCount(), alpha, source.data() + column * source.columnStride(),
+                             target + column * columnStride());
+            }
+            return;
+        }
+
+        for (auto row = 0; row < rowCount(); ++row)
+        {
+            const auto sourceRow = source.data() + row * source.rowStride();
+            const auto targetRow = target + row * rowStride();
+            if (columnStride() == 1 && source.columnStride() == 1)
+            {
+                kernels.axpy(columnCount(), alpha, sourceRow, targetRow);
+            }
+            else
+            {
+                for (auto column = 0; column < columnCount(); ++column)
+                {
+                    targetRow[column * columnStride()] += alpha * sourceRow[column * source.columnStride()];
+                }
+            }
+        }
+    }
+
+    template<typename E>
+    void assignScaledExpression(T* target, const char* operation, const E& expression, T alpha) const
+    {
+        if (rowCount() != expression.rowCount() || columnCount() != expression.columnCount())
+        {
+            THROW(std::logic_error, "cannot ", operation, " matrices ", rowCount(), "x", columnCount(), " and ",
+                  expression.rowCount(), "x", expression.columnCount(), " -- matrix dimensions do not match");
+        }
+        if (aliases(expression, *this))
+        {
+            addScaledRows(target, MatrixImplementation<T, M, N, DataStorageStrategyFor<T, M, N>::value>{expression},
+                          alpha);
+            return;
+        }
+        assignExpression(expression, target, rowStride(), columnStride(),
+                         [alpha](auto& targetValue, auto value) { targetValue += alpha * value; });
+    }
+
     DataStorage<T, M, N, S> dataStorage_;
 };
 
-template<typename T = double, size_type M = dynamic, size_type N = dynamic>
-using Matrix = MatrixImplementation<T, M, N, DataStorageStrategyFor<T, M, N>::value>;
+template<typename T = double, size_type M = dynamic, size_type N = dynamic, Layout L = Layout::rowMajor>
+using Matrix = MatrixImplementation<T, M, N, DataStorageStrategyFor<T, M, N, L>::value>;
 
 template<typename T = double, size_type M = dynamic, size_type N = dynamic>
 using MatrixView = MatrixImplementation<T, M, N, DataStorageStrategy::view>;
@@ -609,74 +793,188 @@ bool operator!=(const MatrixImplementation<T, M, N, S>& a, const MatrixImplement
 
 template<typename T, size_type M, size_type N, DataStorageStrategy S, size_type MM, size_type NN,
          DataStorageStrategy SS, typename = std::enable_if_t<N == MM || N == dynamic || MM == dynamic>>
-auto operator*(const MatrixImplementation<T, M, N, S>& a, const MatrixImplementation<T, MM, NN, SS>& b)
+constexpr auto operator*(const MatrixImplementation<T, M, N, S>& a, const MatrixImplementation<T, MM, NN, SS>& b)
 {
-    if constexpr (N == dynamic || MM == dynamic)
+    if constexpr (isUnrolled(M, N) && isUnrolled(MM, NN) && isUnrolled(M, NN))
     {
-        if (a.columnCount() != b.rowCount())
-        {
-            THROW(std::logic_error, "cannot multiply a ", a.rowCount(), "x", a.columnCount(), " matrix with ",
-                  b.rowCount(), "x", b.columnCount(), " -- matrix dimensions do not match");
-        }
+        auto result = Matrix<T, M, NN>{};
+        unrolledMultiply<M, N, NN>(a.data(), a.rowStride(), a.columnStride(), b.data(), b.rowStride(), b.columnStride(),
+                                   result.data());
+        return result;
     }
-    auto result = Matrix<T, M, NN>{a.rowCount(), b.columnCount()};
-    for (auto m = 0; m < a.rowCount(); ++m)
+    else
     {
-        for (auto p = 0; p < b.columnCount(); ++p)
+        if constexpr (N == dynamic || MM == dynamic)
         {
-            for (auto n = 0; n < a.columnCount(); ++n)
+            if (a.columnCount() != b.rowCount())
             {
-                result.unsafeSubscript(m, p) += a.unsafeSubscript(m, n) * b.unsafeSubscript(n, p);
+                THROW(std::logic_error, "cannot multiply a ", a.rowCount(), "x", a.columnCount(), " matrix with ",
+                      b.rowCount(), "x", b.columnCount(), " -- matrix dimensions do not match");
             }
         }
+        auto result = Matrix<T, M, NN>{a.rowCount(), b.columnCount(), uninitialized};
+        unsafeGemm(a.rowCount(), b.columnCount(), a.columnCount(), dansandu::math::common::multiplicativeIdentity<T>,
+                   a.data(), a.rowStride(), a.columnStride(), b.data(), b.rowStride(), b.columnStride(),
+                   dansandu::math::common::additiveIdentity<T>, result.data(), result.rowStride());
+        return result;
     }
-    return result;
 }
 
-template<typename T, size_type M, size_type N, DataStorageStrategy S>
-auto MatrixImplementation<T, M, N, S>::operator-() const
+// Computes c = alpha * op(a) * op(b) + beta * c, where op transposes its operand in place when asked to, using the
+// threads of the executor. When beta is zero the previous contents of c are ignored. The output must not overlap the
+// operands.
+template<typename T, size_type M, size_type N, DataStorageStrategy S, size_type MM, size_type NN,
+         DataStorageStrategy SS>
+void gemm(std::common_type_t<T> alpha, const MatrixImplementation<T, M, N, S>& a, Transposition transA,
+          const MatrixImplementation<T, MM, NN, SS>& b, Transposition transB, std::common_type_t<T> beta,
+          const MatrixView<std::common_type_t<T>> c,
+          const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
 {
-    auto copy = Matrix<T, M, N>{*this};
-    std::transform(cbegin(), cend(), copy.begin(),
-                   dansandu::math::common::MultiplyBy<T>{-dansandu::math::common::multiplicativeIdentity<T>});
-    return copy;
+    const auto transposeA = transA == Transposition::transposed;
+    const auto transposeB = transB == Transposition::transposed;
+    const auto rows = transposeA ? a.columnCount() : a.rowCount();
+    const auto depth = transposeA ? a.rowCount() : a.columnCount();
+    const auto bRows = transposeB ? b.columnCount() : b.rowCount();
+    const auto columns = transposeB ? b.rowCount() : b.columnCount();
+    if (depth != bRows || c.rowCount() != rows || c.columnCount() != columns)
+    {
+        THROW(std::logic_error, "cannot multiply a ", rows, "x", depth, " matrix with ", bRows, "x", columns,
+              " into a ", c.rowCount(), "x", c.columnCount(), " matrix -- matrix dimensions do not match");
+    }
+
+    const auto aRowStride = transposeA ? a.columnStride() : a.rowStride();
+    const auto aColumnStride = transposeA ? a.rowStride() : a.columnStride();
+    const auto bRowStride = transposeB ? b.columnStride() : b.rowStride();
+    const auto bColumnStride = transposeB ? b.rowStride() : b.columnStride();
+    if (c.columnStride() == 1)
+    {
+        unsafeGemm(rows, columns, depth, alpha, a.data(), aRowStride, aColumnStride, b.data(), bRowStride,
+                   bColumnStride, beta, c.data(), c.rowStride(), executor);
+    }
+    else if (c.rowStride() == 1)
+    {
+        // c is a transposed view, so its transpose op(b)' * op(a)' is row-major and computed instead.
+        unsafeGemm(columns, rows, depth, alpha, b.data(), bColumnStride, bRowStride, a.data(), aColumnStride,
+                   aRowStride, beta, c.data(), c.columnStride(), executor);
+    }
+    else
+    {
+        if (beta == dansandu::math::common::additiveIdentity<T>)
+        {
+            std::fill(c.begin(), c.end(), dansandu::math::common::additiveIdentity<T>);
+        }
+        else if (beta != dansandu::math::common::multiplicativeIdentity<T>)
+        {
+            std::transform(c.begin(), c.end(), c.begin(), dansandu::math::common::MultiplyBy<T>{beta});
+        }
+        auto product = Matrix<T>{rows, columns, uninitialized};
+        unsafeGemm(rows, columns, depth, alpha, a.data(), aRowStride, aColumnStride, b.data(), bRowStride,
+                   bColumnStride, dansandu::math::common::additiveIdentity<T>, product.data(), product.rowStride(),
+                   executor);
+        c += product;
+    }
 }
 
-template<typename T, size_type M, size_type N, DataStorageStrategy S>
-auto operator*(const MatrixImplementation<T, M, N, S>& matrix, T scalar)
+// Overwrites the output with the product of a and b using the threads of the executor. The output must not overlap
+// the operands.
+template<typename T, size_type M, size_type N, DataStorageStrategy S, size_type MM, size_type NN,
+         DataStorageStrategy SS, typename = std::enable_if_t<N == MM || N == dynamic || MM == dynamic>>
+void multiply(const MatrixImplementation<T, M, N, S>& a, const MatrixImplementation<T, MM, NN, SS>& b,
+              const MatrixView<std::common_type_t<T>> output,
+              const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
 {
-    auto result = Matrix<T, M, N>{matrix};
-    return result *= scalar;
+    gemm(dansandu::math::common::multiplicativeIdentity<T>, a, Transposition::none, b, Transposition::none,
+         dansandu::math::common::additiveIdentity<T>, output, executor);
 }
 
-template<typename T, size_type M, size_type N, DataStorageStrategy S>
-auto operator*(T scalar, const MatrixImplementation<T, M, N, S>& matrix)
+// The elementwise operators below do not compute anything on their own. They check the operand dimensions and return
+// expressions that are evaluated in a single pass, without temporaries, once they are assigned to a matrix or a view.
+template<typename A, typename B, typename = std::enable_if_t<elementwiseOperands<A, B>()>>
+auto operator+(A&& a, B&& b)
+{
+    if (a.rowCount() != b.rowCount() || a.columnCount() != b.columnCount())
+    {
+        THROW(std::logic_error, "cannot add matrices ", a.rowCount(), "x", a.columnCount(), " and ", b.rowCount(), "x",
+              b.columnCount(), " -- matrix dimensions do not match");
+    }
+    using Expression =
+        MatrixExpression<dansandu::math::common::Add, ExpressionOperand<A&&>, ExpressionOperand<B&&>>;
+    return Expression{dansandu::math::common::Add{}, std::forward<A>(a), std::forward<B>(b)};
+}
+
+template<typename A, typename B, typename = std::enable_if_t<elementwiseOperands<A, B>()>>
+auto operator-(A&& a, B&& b)
 {
-    auto result = Matrix<T, M, N>{matrix};
-    return result *= scalar;
+    if (a.rowCount() != b.rowCount() || a.columnCount() != b.columnCount())
+    {
+        THROW(std::logic_error, "cannot subtract matrices ", a.rowCount(), "x", a.columnCount(), " and ",
+              b.rowCount(), "x", b.columnCount(), " -- matrix dimensions do not match");
+    }
+    using Expression =
+        MatrixExpression<dansandu::math::common::Subtract, ExpressionOperand<A&&>, ExpressionOperand<B&&>>;
+    return Expression{dansandu::math::common::Subtract{}, std::forward<A>(a), std::forward<B>(b)};
 }
 
-template<typename T, size_type M, size_type N, DataStorageStrategy S, size_type MM, size_type NN,
-         DataStorageStrategy SS, typename = std::enable_if_t<dimensionsMatch(M, N, MM, NN)>>
-auto operator+(const MatrixImplementation<T, M, N, S>& a, const MatrixImplementation<T, MM, NN, SS>& b)
+template<typename A, typename = std::enable_if_t<isMatrixOperand<A>>>
+auto operator-(A&& matrix)
 {
-    auto result = StaticMatrix<T, M, N, MM, NN>{a};
-    return result += b;
+    using Expression = MatrixExpression<dansandu::math::common::Negate, ExpressionOperand<A&&>>;
+    return Expression{dansandu::math::common::Negate{}, std::forward<A>(matrix)};
 }
 
-template<typename T, size_type M, size_type N, DataStorageStrategy S, size_type MM, size_type NN,
-         DataStorageStrategy SS, typename = std::enable_if_t<dimensionsMatch(M, N, MM, NN)>>
-auto operator-(const MatrixImplementation<T, M, N, S>& a, const MatrixImplementation<T, MM, NN, SS>& b)
+template<typename A, typename = std::enable_if_t<isMatrixOperand<A>>>
+auto operator*(A&& matrix, typename std::decay_t<A>::value_type scalar)
 {
-    auto result = StaticMatrix<T, M, N, MM, NN>{a};
-    return result -= b;
+    using T = typename std::decay_t<A>::value_type;
+    using Expression = MatrixExpression<dansandu::math::common::MultiplyBy<T>, ExpressionOperand<A&&>>;
+    return Expression{dansandu::math::common::MultiplyBy<T>{scalar}, std::forward<A>(matrix)};
 }
 
-template<typename T, size_type M, size_type N, DataStorageStrategy S>
-auto operator/(const MatrixImplementation<T, M, N, S>& matrix, const T& scalar)
+template<typename A, typename = std::enable_if_t<isMatrixOperand<A>>>
+auto operator*(typename std::decay_t<A>::value_type scalar, A&& matrix)
+{
+    return std::forward<A>(matrix) * scalar;
+}
+
+template<typename A, typename = std::enable_if_t<isMatrixOperand<A>>>
+auto operator/(A&& matrix, typename std::decay_t<A>::value_type scalar)
+{
+    using T = typename std::decay_t<A>::value_type;
+    using Expression = MatrixExpression<dansandu::math::common::DivideBy<T>, ExpressionOperand<A&&>>;
+    return Expression{dansandu::math::common::DivideBy<T>{scalar}, std::forward<A>(matrix)};
+}
+
+// Applies the function elementwise to operands of matching dimensions, e.g. elementwise(Power{}, bases, exponents).
+template<typename Function, typename A, typename... B,
+         typename = std::enable_if_t<isMatrixOperand<A> && (elementwiseOperands<A, B>() && ...)>>
+auto elementwise(Function function, A&& a, B&&... b)
+{
+    if (((a.rowCount() != b.rowCount() || a.columnCount() != b.columnCount()) || ...))
+    {
+        THROW(std::logic_error, "cannot apply an elementwise function to matrices of different dimensions");
+    }
+    using Expression = MatrixExpression<Function, ExpressionOperand<A&&>, ExpressionOperand<B&&>...>;
+    return Expression{std::move(function), std::forward<A>(a), std::forward<B>(b)...};
+}
+
+template<typename E, typename = std::enable_if_t<isMatrixExpression<E>>>
+auto evaluate(const E& expression)
+{
+    return Matrix<typename E::value_type, E::staticRowCount, E::staticColumnCount>{expression};
+}
+
+// Evaluates expressions and passes matrices through so that the functions below accept both.
+template<typename A>
+decltype(auto) materialize(const A& operand)
 {
-    auto result = Matrix<T, M, N>{matrix};
-    return result /= scalar;
+    if constexpr (isMatrixExpression<A>)
+    {
+        return evaluate(operand);
+    }
+    else
+    {
+        return (operand);
+    }
 }
 
 template<typename T>
@@ -709,6 +1007,31 @@ auto identity()
     return result;
 }
 
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+constexpr auto vectorStride(const MatrixImplementation<T, M, N, S>& vector)
+{
+    return vector.rowCount() == 1 ? vector.columnStride() : vector.rowStride();
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S, size_type MM, size_type NN,
+         DataStorageStrategy SS>
+auto unsafeDotProduct(const MatrixImplementation<T, M, N, S>& a, const MatrixImplementation<T, MM, NN, SS>& b)
+{
+    const auto length = a.rowCount() * a.columnCount();
+    const auto aStride = vectorStride(a);
+    const auto bStride = vectorStride(b);
+    if (aStride == 1 && bStride == 1)
+    {
+        return getKernels<T>().dot(length, a.data(), b.data());
+    }
+    auto sum = dansandu::math::common::additiveIdentity<T>;
+    for (auto i = 0; i < length; ++i)
+    {
+        sum += a.data()[i * aStride] * b.data()[i * bStride];
+    }
+    return sum;
+}
+
 template<typename T, size_type M, size_type N, DataStorageStrategy S, typename = std::enable_if_t<isVector(M, N)>>
 auto magnitude(const MatrixImplementation<T, M, N, S>& matrix)
 {
@@ -720,12 +1043,7 @@ auto magnitude(const MatrixImplementation<T, M, N, S>& matrix)
                   matrix.columnCount());
         }
     }
-    auto sum = dansandu::math::common::additiveIdentity<T>;
-    for (const auto component : matrix)
-    {
-        sum += component * component;
-    }
-    return std::sqrt(sum);
+    return std::sqrt(unsafeDotProduct(matrix, matrix));
 }
 
 template<typename T, size_type M, size_type N, DataStorageStrategy S, typename = std::enable_if_t<isVector(M, N)>>
@@ -739,12 +1057,8 @@ auto normalized(const MatrixImplementation<T, M, N, S>& matrix)
                   matrix.columnCount());
         }
     }
-    auto sum = dansandu::math::common::additiveIdentity<T>;
-    for (const auto component : matrix)
-    {
-        sum += component * component;
-    }
-    return matrix * (dansandu::math::common::multiplicativeIdentity<T> / std::sqrt(sum));
+    return evaluate(matrix *
+                    (dansandu::math::common::multiplicativeIdentity<T> / std::sqrt(unsafeDotProduct(matrix, matrix))));
 }
 
 template<typename T, size_type M, size_type N, DataStorageStrategy S, size_type MM, size_type NN,
@@ -759,14 +1073,7 @@ auto dotProduct(const MatrixImplementation<T, M, N, S>& a, const MatrixImplement
                   " and ", b.rowCount(), "x", b.columnCount());
         }
     }
-    auto sum = dansandu::math::common::additiveIdentity<T>;
-    auto left = a.cbegin();
-    auto right = b.cbegin();
-    while (left != a.cend())
-    {
-        sum += *left++ * *right++;
-    }
-    return sum;
+    return unsafeDotProduct(a, b);
 }
 
 template<typename T, size_type M, size_type N, DataStorageStrategy S, size_type MM, size_type NN,
@@ -781,23 +1088,25 @@ auto distance(const MatrixImplementation<T, M, N, S>& a, const MatrixImplementat
                   b.rowCount(), "x", b.columnCount());
         }
     }
+    const auto length = a.rowCount() * a.columnCount();
+    const auto aStride = vectorStride(a);
+    const auto bStride = vectorStride(b);
+    if (aStride == 1 && bStride == 1)
+    {
+        return std::sqrt(getKernels<T>().squaredDistance(length, a.data(), b.data()));
+    }
     auto sum = dansandu::math::common::additiveIdentity<T>;
-    auto left = a.cbegin();
-    auto leftEnd = a.cend();
-    auto right = b.cbegin();
-    while (left != leftEnd)
+    for (auto i = 0; i < length; ++i)
     {
-        const auto difference = *left - *right;
+        const auto difference = a.data()[i * aStride] - b.data()[i * bStride];
         sum += difference * difference;
-        ++left;
-        ++right;
     }
     return std::sqrt(sum);
 }
 
 template<typename T, size_type M, size_type N, DataStorageStrategy S, size_type MM, size_type NN,
          DataStorageStrategy SS, typename = std::enable_if_t<vectorsOfLength3(M, N, MM, NN)>>
-auto crossProduct(const MatrixImplementation<T, M, N, S>& a, const MatrixImplementation<T, MM, NN, SS>& b)
+constexpr auto crossProduct(const MatrixImplementation<T, M, N, S>& a, const MatrixImplementation<T, MM, NN, SS>& b)
 {
     if constexpr (M == dynamic || N == dynamic || MM == dynamic || NN == dynamic)
     {
@@ -808,24 +1117,136 @@ auto crossProduct(const MatrixImplementation<T, M, N, S>& a, const MatrixImpleme
         }
     }
 
-    const auto x = a.unsafeSubscript(1) * b.unsafeSubscript(2) - a.unsafeSubscript(2) * b.unsafeSubscript(1);
-    const auto y = a.unsafeSubscript(2) * b.unsafeSubscript(0) - a.unsafeSubscript(0) * b.unsafeSubscript(2);
-    const auto z = a.unsafeSubscript(0) * b.unsafeSubscript(1) - a.unsafeSubscript(1) * b.unsafeSubscript(0);
+    const auto aStride = vectorStride(a);
+    const auto bStride = vectorStride(b);
+    const auto u = a.data();
+    const auto v = b.data();
+    const auto x = u[aStride] * v[2 * bStride] - u[2 * aStride] * v[bStride];
+    const auto y = u[2 * aStride] * v[0] - u[0] * v[2 * bStride];
+    const auto z = u[0] * v[bStride] - u[aStride] * v[0];
 
     return Matrix<T, 3, 1>{{x, y, z}};
 }
 
 template<typename T, size_type M, size_type N, DataStorageStrategy S>
-auto transposed(const MatrixImplementation<T, M, N, S>& matrix)
+constexpr auto transposed(const MatrixImplementation<T, M, N, S>& matrix)
 {
-    auto result = Matrix<T, N, M>{matrix.columnCount(), matrix.rowCount()};
-    for (auto i = 0; i < matrix.rowCount(); ++i)
+    if constexpr (isUnrolled(M, N))
+    {
+        auto result = Matrix<T, N, M>{};
+        unrolledTranspose<M, N>(matrix.data(), matrix.rowStride(), matrix.columnStride(), result.data());
+        return result;
+    }
+    else
     {
-        for (auto j = 0; j < matrix.columnCount(); ++j)
+        auto result = Matrix<T, N, M>{matrix.columnCount(), matrix.rowCount(), uninitialized};
+        unsafeTranspose(matrix.rowCount(), matrix.columnCount(), matrix.data(), matrix.rowStride(),
+                        matrix.columnStride(), result.data(), result.rowStride());
+        return result;
+    }
+}
+
+// Transposes a matrix without allocating a second one. Square matrices and views exchange their elements across the
+// diagonal, while rectangular matrices need fully dynamic heap storage since their dimensions are swapped as well.
+template<typename T, size_type M, size_type N, DataStorageStrategy S,
+         typename = std::enable_if_t<isContainer(S) && (M == N || M == dynamic || N == dynamic)>>
+void transposeInPlace(MatrixImplementation<T, M, N, S>& matrix)
+{
+    if (matrix.rowCount() == matrix.columnCount())
+    {
+        unsafeTransposeSquareInPlace(matrix.rowCount(), matrix.data(), matrix.rowStride(), matrix.columnStride());
+    }
+    else
+    {
+        if constexpr (isHeapContainer(S) && M == dynamic && N == dynamic)
         {
-            result(j, i) = matrix(i, j);
+            if (!isColumnMajor(S) && matrix.rowStride() != matrix.columnCount())
+            {
+                THROW(std::logic_error, "cannot transpose a ", matrix.rowCount(), "x", matrix.columnCount(),
+                      " matrix in place -- rectangular matrices must not have padded rows");
+            }
+            if constexpr (isColumnMajor(S))
+            {
+                unsafeTransposeInPlace(matrix.columnCount(), matrix.rowCount(), matrix.data());
+            }
+            else
+            {
+                unsafeTransposeInPlace(matrix.rowCount(), matrix.columnCount(), matrix.data());
+            }
+            matrix.reshape(matrix.columnCount(), matrix.rowCount());
+        }
+        else
+        {
+            THROW(std::logic_error, "cannot transpose a ", matrix.rowCount(), "x", matrix.columnCount(),
+                  " matrix in place -- rectangular matrices must have dynamic rows and columns");
         }
     }
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S,
+         typename = std::enable_if_t<isView(S) && (M == N || M == dynamic || N == dynamic)>>
+void transposeInPlace(const MatrixImplementation<T, M, N, S>& view)
+{
+    if (view.rowCount() != view.columnCount())
+    {
+        THROW(std::logic_error, "cannot transpose a ", view.rowCount(), "x", view.columnCount(),
+              " view in place -- only square views can be transposed in place");
+    }
+    unsafeTransposeSquareInPlace(view.rowCount(), view.data(), view.rowStride(), view.columnStride());
+}
+
+// Returns a view of the transpose that shares the storage of the matrix by swapping its row and column strides.
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+auto transposedView(MatrixImplementation<T, M, N, S>& matrix)
+{
+    if constexpr (isConstantView(S))
+    {
+        return ConstantMatrixView<T, N, M>{matrix.columnCount(), matrix.rowCount(), matrix.columnStride(),
+                                           matrix.rowStride(), matrix.data()};
+    }
+    else
+    {
+        return MatrixView<T, N, M>{matrix.columnCount(), matrix.rowCount(), matrix.columnStride(), matrix.rowStride(),
+                                   matrix.data()};
+    }
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+auto transposedView(const MatrixImplementation<T, M, N, S>& matrix)
+{
+    if constexpr (isView(S))
+    {
+        return MatrixView<T, N, M>{matrix.columnCount(), matrix.rowCount(), matrix.columnStride(), matrix.rowStride(),
+                                   matrix.data()};
+    }
+    else
+    {
+        return ConstantMatrixView<T, N, M>{matrix.columnCount(), matrix.rowCount(), matrix.columnStride(),
+                                           matrix.rowStride(), matrix.data()};
+    }
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S,
+         typename = std::enable_if_t<isContainer(S)>>
+auto transposedView(MatrixImplementation<T, M, N, S>&& matrix) = delete;
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S,
+         typename = std::enable_if_t<isUnrolled(M, N) && M == N>>
+constexpr auto determinant(const MatrixImplementation<T, M, N, S>& matrix)
+{
+    return unrolledDeterminant<M>(matrix.data(), matrix.rowStride(), matrix.columnStride());
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S,
+         typename = std::enable_if_t<isUnrolled(M, N) && M == N && std::is_floating_point_v<T>>>
+constexpr auto inverse(const MatrixImplementation<T, M, N, S>& matrix)
+{
+    auto result = Matrix<T, M, N>{};
+    if (unrolledInverse<M>(matrix.data(), matrix.rowStride(), matrix.columnStride(), result.data()) ==
+        dansandu::math::common::additiveIdentity<T>)
+    {
+        THROW(std::logic_error, "cannot invert a singular ", M, "x", N, " matrix");
+    }
     return result;
 }
 
@@ -867,4 +1288,73 @@ std::ostream& operator<<(std::ostream& stream, const MatrixImplementation<T, M,
     return stream << "}";
 }
 
+template<typename A, typename B, typename = std::enable_if_t<isMatrixExpression<A> || isMatrixExpression<B>>>
+auto operator==(const A& a, const B& b) -> decltype(materialize(a) == materialize(b))
+{
+    return materialize(a) == materialize(b);
+}
+
+template<typename A, typename B, typename = std::enable_if_t<isMatrixExpression<A> || isMatrixExpression<B>>>
+auto operator!=(const A& a, const B& b) -> decltype(materialize(a) != materialize(b))
+{
+    return materialize(a) != materialize(b);
+}
+
+template<typename A, typename B,
+         typename = std::enable_if_t<(isMatrixExpression<A> || isMatrixExpression<B>) && isMatrixOperand<A> &&
+                                     isMatrixOperand<B>>>
+auto operator*(const A& a, const B& b) -> decltype(materialize(a) * materialize(b))
+{
+    return materialize(a) * materialize(b);
+}
+
+template<typename E, typename = std::enable_if_t<isMatrixExpression<E>>>
+auto magnitude(const E& expression) -> decltype(magnitude(evaluate(expression)))
+{
+    return magnitude(evaluate(expression));
+}
+
+template<typename E, typename = std::enable_if_t<isMatrixExpression<E>>>
+auto normalized(const E& expression) -> decltype(normalized(evaluate(expression)))
+{
+    return normalized(evaluate(expression));
+}
+
+template<typename E, typename = std::enable_if_t<isMatrixExpression<E>>>
+auto transposed(const E& expression)
+{
+    return transposed(evaluate(expression));
+}
+
+template<typename A, typename B, typename = std::enable_if_t<isMatrixExpression<A> || isMatrixExpression<B>>>
+auto dotProduct(const A& a, const B& b) -> decltype(dotProduct(materialize(a), materialize(b)))
+{
+    return dotProduct(materialize(a), materialize(b));
+}
+
+template<typename A, typename B, typename = std::enable_if_t<isMatrixExpression<A> || isMatrixExpression<B>>>
+auto distance(const A& a, const B& b) -> decltype(distance(materialize(a), materialize(b)))
+{
+    return distance(materialize(a), materialize(b));
+}
+
+template<typename A, typename B, typename = std::enable_if_t<isMatrixExpression<A> || isMatrixExpression<B>>>
+auto crossProduct(const A& a, const B& b) -> decltype(crossProduct(materialize(a), materialize(b)))
+{
+    return crossProduct(materialize(a), materialize(b));
+}
+
+template<typename A, typename B, typename = std::enable_if_t<isMatrixExpression<A> || isMatrixExpression<B>>>
+auto close(const A& a, const B& b, const typename A::value_type epsilon)
+    -> decltype(close(materialize(a), materialize(b), epsilon))
+{
+    return close(materialize(a), materialize(b), epsilon);
+}
+
+template<typename E, typename = std::enable_if_t<isMatrixExpression<E>>>
+std::ostream& operator<<(std::ostream& stream, const E& expression)
+{
+    return stream << evaluate(expression);
+}
+
 }
@@ -0,0 +1,138 @@
+#include "dansandu/math/internal/matrix/matrix_file.hpp"
+#include "dansandu/ballotin/exception.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace dansandu::math::matrix
+{
+
+static constexpr char magic[8] = {'D', 'S', 'M', 'A', 'T', 'R', 'I', 'X'};
+static constexpr auto byteOrderMark = static_cast<std::uint32_t>(0x01020304);
+static constexpr auto version = static_cast<std::uint32_t>(1);
+static constexpr auto payloadAlignment = static_cast<std::uint32_t>(64);
+
+static std::size_t getElementSize(ElementType elementType)
+{
+    switch (elementType)
+    {
+    case ElementType::int32:
+    case ElementType::float32:
+        return 4;
+    case ElementType::int64:
+    case ElementType::float64:
+        return 8;
+    }
+    return 0;
+}
+
+template<typename U>
+static void put(char* bytes, std::size_t offset, U value)
+{
+    std::memcpy(bytes + offset, &value, sizeof(value));
+}
+
+template<typename U>
+static U get(const char* bytes, std::size_t offset)
+{
+    auto value = U{};
+    std::memcpy(&value, bytes + offset, sizeof(value));
+    return value;
+}
+
+void writeMatrixFileHeader(std::ostream& stream, const MatrixFileHeader& header)
+{
+    char bytes[MatrixFileHeader::size] = {};
+    std::memcpy(bytes, magic, sizeof(magic));
+    put(bytes, 8, byteOrderMark);
+    put(bytes, 12, version);
+    put(bytes, 16, static_cast<std::uint32_t>(header.elementType));
+    put(bytes, 20, static_cast<std::uint32_t>(getElementSize(header.elementType)));
+    put(bytes, 24, static_cast<std::uint64_t>(header.rows));
+    put(bytes, 32, static_cast<std::uint64_t>(header.columns));
+    put(bytes, 40, static_cast<std::uint32_t>(header.layout));
+    put(bytes, 44, payloadAlignment);
+    put(bytes, 48, static_cast<std::uint64_t>(header.payloadOffset));
+    if (!stream.write(bytes, sizeof(bytes)))
+    {
+        THROW(std::runtime_error, "cannot write matrix file header");
+    }
+}
+
+MatrixFileHeader readMatrixFileHeader(std::istream& stream, const std::string& path)
+{
+    char bytes[MatrixFileHeader::size];
+    if (!stream.read(bytes, sizeof(bytes)))
+    {
+        THROW(std::runtime_error, "cannot read the header of matrix file '", path, "'");
+    }
+    if (std::memcmp(bytes, magic, sizeof(magic)) != 0)
+    {
+        THROW(std::runtime_error, "'", path, "' is not a matrix file");
+    }
+    if (get<std::uint32_t>(bytes, 8) != byteOrderMark)
+    {
+        THROW(std::runtime_error, "matrix file '", path, "' was written with a different byte order");
+    }
+    if (const auto fileVersion = get<std::uint32_t>(bytes, 12); fileVersion != version)
+    {
+        THROW(std::runtime_error, "unsupported version ", fileVersion, " of matrix file '", path, "'");
+    }
+
+    auto header = MatrixFileHeader{};
+    header.elementType = static_cast<ElementType>(get<std::uint32_t>(bytes, 16));
+    const auto elementSize = getElementSize(header.elementType);
+    if (elementSize == 0 || elementSize != get<std::uint32_t>(bytes, 20))
+    {
+        THROW(std::runtime_error, "matrix file '", path, "' has an unknown element type");
+    }
+
+    const auto rows = get<std::uint64_t>(bytes, 24);
+    const auto columns = get<std::uint64_t>(bytes, 32);
+    const auto maximum = static_cast<std::uint64_t>(std::numeric_limits<size_type>::max());
+    if (rows > maximum || columns > maximum)
+    {
+        THROW(std::out_of_range, "matrix file '", path, "' dimensions ", rows, "x", columns, " are too large");
+    }
+    header.rows = static_cast<size_type>(rows);
+    header.columns = static_cast<size_type>(columns);
+
+    const auto layout = get<std::uint32_t>(bytes, 40);
+    if (layout != static_cast<std::uint32_t>(Layout::rowMajor) &&
+        layout != static_cast<std::uint32_t>(Layout::columnMajor))
+    {
+        THROW(std::runtime_error, "matrix file '", path, "' has an unknown layout");
+    }
+    header.layout = static_cast<Layout>(layout);
+
+    header.payloadOffset = static_cast<std::size_t>(get<std::uint64_t>(bytes, 48));
+    if (header.payloadOffset < MatrixFileHeader::size || header.payloadOffset % elementSize != 0)
+    {
+        THROW(std::runtime_error, "matrix file '", path, "' has an invalid payload offset ", header.payloadOffset);
+    }
+    return header;
+}
+
+MatrixFileHeader readMatrixFileHeader(const std::string& path)
+{
+    auto stream = std::ifstream{path, std::ios::binary};
+    if (!stream)
+    {
+        THROW(std::runtime_error, "cannot open matrix file '", path, "'");
+    }
+    return readMatrixFileHeader(stream, path);
+}
+
+void validateElementType(const MatrixFileHeader& header, ElementType elementType, const std::string& path)
+{
+    if (header.elementType != elementType)
+    {
+        THROW(std::invalid_argument, "matrix file '", path, "' holds elements of type ",
+              static_cast<int>(header.elementType), " instead of ", static_cast<int>(elementType));
+    }
+}
+
+}
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/mapped_matrix.hpp"
+#include "dansandu/math/internal/matrix/matrix.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dansandu::math::matrix
+{
+
+enum class ElementType
+{
+    int32 = 1,
+    int64 = 2,
+    float32 = 3,
+    float64 = 4
+};
+
+template<typename T>
+constexpr auto getElementType()
+{
+    if constexpr (std::is_same_v<T, std::int32_t>)
+    {
+        return ElementType::int32;
+    }
+    else if constexpr (std::is_same_v<T, std::int64_t>)
+    {
+        return ElementType::int64;
+    }
+    else if constexpr (std::is_same_v<T, float>)
+    {
+        return ElementType::float32;
+    }
+    else
+    {
+        static_assert(std::is_same_v<T, double>, "matrix files hold 32 or 64 bit integers or floating point numbers");
+        return ElementType::float64;
+    }
+}
+
+// A matrix file is a 64 byte header followed by the elements, without any padding, in the byte order of the machine
+// that wrote it and in the layout recorded in the header. The payload starts on a cache line boundary so that a mapped
+// file can be used in place.
+//
+//    0  magic "DSMATRIX"          24  rows (uint64)
+//    8  byte order mark (uint32)   32  columns (uint64)
+//   12  version (uint32)           40  layout (uint32)
+//   16  element type (uint32)      44  alignment (uint32)
+//   20  element size (uint32)      48  payload offset (uint64)
+struct MatrixFileHeader
+{
+    static constexpr auto size = static_cast<std::size_t>(64);
+
+    ElementType elementType;
+    size_type rows;
+    size_type columns;
+    Layout layout;
+    std::size_t payloadOffset;
+};
+
+PRALINE_EXPORT void writeMatrixFileHeader(std::ostream& stream, const MatrixFileHeader& header);
+
+PRALINE_EXPORT MatrixFileHeader readMatrixFileHeader(std::istream& stream, const std::string& path);
+
+PRALINE_EXPORT MatrixFileHeader readMatrixFileHeader(const std::string& path);
+
+PRALINE_EXPORT void validateElementType(const MatrixFileHeader& header, ElementType elementType,
+                                        const std::string& path);
+
+// Appends rows to a row-major matrix file and records the final row count in the header when closed. Rows can come
+// from any matrix, view or slice, so large results can be written chunk by chunk.
+template<typename T>
+class MatrixFileWriter
+{
+public:
+    MatrixFileWriter(const std::string& path, size_type columns)
+        : path_{path}, stream_{path, std::ios::binary | std::ios::trunc}, rows_{0}, columns_{columns}
+    {
+        if (!stream_)
+        {
+            THROW(std::runtime_error, "cannot open matrix file '", path, "' for writing");
+        }
+        writeMatrixFileHeader(stream_, getHeader());
+    }
+
+    MatrixFileWriter(const MatrixFileWriter&) = delete;
+
+    MatrixFileWriter& operator=(const MatrixFileWriter&) = delete;
+
+    ~MatrixFileWriter()
+    {
+        if (stream_.is_open())
+        {
+            try
+            {
+                close();
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+
+    template<size_type M, size_type N, DataStorageStrategy S>
+    void write(const MatrixImplementation<T, M, N, S>& rows)
+    {
+        if (rows.columnCount() != columns_)
+        {
+            THROW(std::logic_error, "cannot append a ", rows.rowCount(), "x", rows.columnCount(), " matrix to the ",
+                  columns_, " columns matrix file '", path_, "'");
+        }
+        if (rows.columnStride() == 1)
+        {
+            for (auto i = 0; i < rows.rowCount(); ++i)
+            {
+                writeElements(rows.data() + i * rows.rowStride(), columns_);
+            }
+        }
+        else
+        {
+            buffer_.resize(columns_);
+            for (auto i = 0; i < rows.rowCount(); ++i)
+            {
+                for (auto j = 0; j < columns_; ++j)
+                {
+                    buffer_[j] = rows.data()[i * rows.rowStride() + j * rows.columnStride()];
+                }
+                writeElements(buffer_.data(), columns_);
+            }
+        }
+        rows_ += rows.rowCount();
+    }
+
+    void close()
+    {
+        stream_.seekp(0);
+        writeMatrixFileHeader(stream_, getHeader());
+        stream_.close();
+        if (!stream_)
+        {
+            THROW(std::runtime_error, "cannot finish writing matrix file '", path_, "'");
+        }
+    }
+
+private:
+    MatrixFileHeader getHeader() const
+    {
+        return {getElementType<T>(), rows_, columns_, Layout::rowMajor, MatrixFileHeader::size};
+    }
+
+    void writeElements(const T* elements, size_type count)
+    {
+        if (!stream_.write(reinterpret_cast<const char*>(elements), static_cast<std::streamsize>(count * sizeof(T))))
+        {
+            THROW(std::runtime_error, "cannot write to matrix file '", path_, "'");
+        }
+    }
+
+    std::string path_;
+    std::ofstream stream_;
+    size_type rows_;
+    size_type columns_;
+    std::vector<T> buffer_;
+};
+
+// Reads a row-major matrix file in chunks of rows, reusing the chunk storage while its dimensions do not change. The
+// file may hold more elements than size_type can count as long as every chunk fits.
+template<typename T>
+class MatrixFileReader
+{
+public:
+    explicit MatrixFileReader(const std::string& path)
+        : path_{path}, stream_{path, std::ios::binary}, header_{readMatrixFileHeader(stream_, path)}, nextRow_{0}
+    {
+        validateElementType(header_, getElementType<T>(), path);
+        if (header_.layout != Layout::rowMajor)
+        {
+            THROW(std::logic_error, "cannot stream the rows of column-major matrix file '", path, "'");
+        }
+        stream_.seekg(static_cast<std::streamoff>(header_.payloadOffset));
+    }
+
+    const MatrixFileHeader& header() const
+    {
+        return header_;
+    }
+
+    size_type remainingRows() const
+    {
+        return header_.rows - nextRow_;
+    }
+
+    // Reads up to maxRows of the remaining rows into chunk and returns how many were read, zero once the file is
+    // exhausted.
+    size_type read(Matrix<T>& chunk, size_type maxRows)
+    {
+        if (maxRows <= 0)
+        {
+            THROW(std::invalid_argument, "invalid chunk size ", maxRows, " -- chunks must hold at least one row");
+        }
+        const auto rows = std::min(maxRows, remainingRows());
+        if (rows == 0)
+        {
+            return 0;
+        }
+        if (header_.columns > 0 && rows > std::numeric_limits<size_type>::max() / header_.columns)
+        {
+            THROW(std::out_of_range, "cannot read ", rows, " rows of matrix file '", path_, "' at once -- a chunk of ",
+                  rows, "x", header_.columns, " has more than ", std::numeric_limits<size_type>::max(),
+                  " elements");
+        }
+        if (chunk.rowCount() != rows || chunk.columnCount() != header_.columns ||
+            chunk.rowStride() != header_.columns)
+        {
+            chunk = Matrix<T>{rows, header_.columns, uninitialized};
+        }
+        const auto bytes = static_cast<std::streamsize>(rows) * header_.columns * sizeof(T);
+        if (!stream_.read(reinterpret_cast<char*>(chunk.data()), bytes))
+        {
+            THROW(std::runtime_error, "matrix file '", path_, "' is truncated at row ", nextRow_, " of ",
+                  header_.rows);
+        }
+        nextRow_ += rows;
+        return rows;
+    }
+
+private:
+    std::string path_;
+    std::ifstream stream_;
+    MatrixFileHeader header_;
+    size_type nextRow_;
+};
+
+// Writes the matrix to a new file in the requested layout. Any matrix, view or slice can be written.
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+void writeMatrixFile(const std::string& path, const MatrixImplementation<T, M, N, S>& matrix,
+                     Layout layout = Layout::rowMajor)
+{
+    if (layout == Layout::rowMajor)
+    {
+        auto writer = MatrixFileWriter<T>{path, matrix.columnCount()};
+        writer.write(matrix);
+        writer.close();
+    }
+    else
+    {
+        // The columns are written as the rows of the transpose and the header is then marked column-major.
+        auto writer = MatrixFileWriter<T>{path, matrix.rowCount()};
+        writer.write(transposedView(matrix));
+        writer.close();
+        auto stream = std::fstream{path, std::ios::binary | std::ios::in | std::ios::out};
+        if (!stream)
+        {
+            THROW(std::runtime_error, "cannot reopen matrix file '", path, "' for writing");
+        }
+        writeMatrixFileHeader(stream, {getElementType<T>(), matrix.rowCount(), matrix.columnCount(),
+                                       Layout::columnMajor, MatrixFileHeader::size});
+    }
+}
+
+// Reads the whole file into a row-major matrix.
+template<typename T>
+Matrix<T> readMatrixFile(const std::string& path)
+{
+    const auto header = readMatrixFileHeader(path);
+    validateElementType(header, getElementType<T>(), path);
+    if (header.rows == 0 || header.columns == 0)
+    {
+        return Matrix<T>{header.rows, header.columns};
+    }
+    if (header.rows > std::numeric_limits<size_type>::max() / header.columns)
+    {
+        THROW(std::out_of_range, "matrix file '", path, "' of ", header.rows, "x", header.columns,
+              " is too large to read into memory -- stream or map it instead");
+    }
+    if (header.layout == Layout::rowMajor)
+    {
+        auto reader = MatrixFileReader<T>{path};
+        auto matrix = Matrix<T>{};
+        reader.read(matrix, header.rows);
+        return matrix;
+    }
+    return Matrix<T>{MappedMatrix<T>{path, header.rows, header.columns, MapMode::readOnly, header.payloadOffset,
+                                     false, Layout::columnMajor}
+                         .constantView()};
+}
+
+// Maps the payload of the file without copying it. The elements are available through the views of the result.
+template<typename T>
+MappedMatrix<T> mapMatrixFile(const std::string& path, MapMode mode = MapMode::readOnly, bool hugePages = false)
+{
+    const auto header = readMatrixFileHeader(path);
+    validateElementType(header, getElementType<T>(), path);
+    return MappedMatrix<T>{path, header.rows, header.columns, mode, header.payloadOffset, hugePages, header.layout};
+}
+
+}
@@ -0,0 +1,130 @@
+#include "dansandu/math/internal/matrix/matrix_text.hpp"
+#include "dansandu/ballotin/exception.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace dansandu::math::matrix
+{
+
+static bool isBlank(char character)
+{
+    return character == ' ' || character == '\t' || character == '\r' || character == '\n';
+}
+
+static std::string_view trim(std::string_view text)
+{
+    auto begin = text.cbegin();
+    auto end = text.cend();
+    while (begin != end && isBlank(*begin))
+    {
+        ++begin;
+    }
+    while (end != begin && isBlank(*(end - 1)))
+    {
+        --end;
+    }
+    return text.substr(static_cast<std::size_t>(begin - text.cbegin()), static_cast<std::size_t>(end - begin));
+}
+
+std::string_view getTextBody(std::string_view text, TextFormat format)
+{
+    if (format != TextFormat::braces)
+    {
+        return text;
+    }
+    const auto trimmed = trim(text);
+    if (trimmed.empty())
+    {
+        return trimmed;
+    }
+    if (trimmed.size() < 2 || trimmed.front() != '{' || trimmed.back() != '}')
+    {
+        THROW(std::invalid_argument, "matrix text in the braces format must be enclosed in braces");
+    }
+    return trimmed.substr(1, trimmed.size() - 2);
+}
+
+std::vector<std::string_view> splitTextIntoChunks(std::string_view body, TextFormat format, int chunks)
+{
+    // Rows of the delimited formats start after a line break and rows of the braces format start at an opening brace,
+    // which never appears inside a row.
+    const auto boundary = format == TextFormat::braces ? '{' : '\n';
+    const auto skipBoundary = format == TextFormat::braces ? 0 : 1;
+
+    auto result = std::vector<std::string_view>{};
+    auto begin = static_cast<std::size_t>(0);
+    for (auto chunk = 1; chunk <= chunks && begin < body.size(); ++chunk)
+    {
+        auto end = body.size();
+        if (chunk < chunks)
+        {
+            const auto target = std::max(begin + 1, body.size() / chunks * chunk);
+            const auto position = target < body.size() ? body.find(boundary, target) : std::string_view::npos;
+            end = position == std::string_view::npos ? body.size() : position + skipBoundary;
+        }
+        result.push_back(body.substr(begin, end - begin));
+        begin = end;
+    }
+    return result;
+}
+
+bool nextTextRow(std::string_view& chunk, TextFormat format, std::string_view& row)
+{
+    if (format == TextFormat::braces)
+    {
+        auto position = std::size_t{0};
+        while (position < chunk.size() && (isBlank(chunk[position]) || chunk[position] == ','))
+        {
+            ++position;
+        }
+        if (position == chunk.size())
+        {
+            chunk = chunk.substr(position);
+            return false;
+        }
+        const auto close = chunk.find('}', position);
+        if (chunk[position] != '{' || close == std::string_view::npos)
+        {
+            THROW(std::invalid_argument, "rows of matrix text in the braces format must be enclosed in braces");
+        }
+        row = chunk.substr(position + 1, close - position - 1);
+        chunk = chunk.substr(close + 1);
+        return true;
+    }
+
+    while (!chunk.empty())
+    {
+        const auto lineBreak = chunk.find('\n');
+        const auto line = chunk.substr(0, lineBreak);
+        chunk = lineBreak == std::string_view::npos ? std::string_view{} : chunk.substr(lineBreak + 1);
+        if (std::any_of(line.cbegin(), line.cend(), [](auto character) { return !isBlank(character); }))
+        {
+            row = line;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_type countTextRows(std::string_view chunk, TextFormat format)
+{
+    auto rows = 0;
+    auto row = std::string_view{};
+    while (nextTextRow(chunk, format, row))
+    {
+        ++rows;
+    }
+    return rows;
+}
+
+size_type countTextColumns(std::string_view row, TextFormat format)
+{
+    if (trim(row).empty())
+    {
+        return 0;
+    }
+    return static_cast<size_type>(std::count(row.cbegin(), row.cend(), getTextDelimiter(format))) + 1;
+}
+
+}
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/mapped_file.hpp"
+#include "dansandu/math/internal/matrix/matrix.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace dansandu::math::matrix
+{
+
+// Rows are lines of comma or tab separated values in the csv and tsv formats. The braces format is the one written by
+// operator<<, e.g. {{1, 2}, {3, 4}}, and may span any number of lines.
+enum class TextFormat
+{
+    csv,
+    tsv,
+    braces
+};
+
+// Texts shorter than this are parsed on the calling thread.
+constexpr auto textParallelThreshold = static_cast<std::size_t>(1) << 20;
+
+// Matrices with fewer elements than this are formatted on the calling thread.
+constexpr auto textFormatParallelThreshold = 1 << 16;
+
+constexpr auto getTextDelimiter(TextFormat format)
+{
+    return format == TextFormat::tsv ? '\t' : ',';
+}
+
+// Returns the part of the text that holds the rows, which is the text itself except for the outer braces of the braces
+// format.
+PRALINE_EXPORT std::string_view getTextBody(std::string_view text, TextFormat format);
+
+// Splits the body into at most the given number of chunks of about the same size that start and end on row boundaries.
+PRALINE_EXPORT std::vector<std::string_view> splitTextIntoChunks(std::string_view body, TextFormat format,
+                                                                 int chunks);
+
+// Moves the next row of the chunk into row and returns false once the chunk has no more rows. Blank lines are skipped
+// and the braces of the braces format are stripped.
+PRALINE_EXPORT bool nextTextRow(std::string_view& chunk, TextFormat format, std::string_view& row);
+
+PRALINE_EXPORT size_type countTextRows(std::string_view chunk, TextFormat format);
+
+PRALINE_EXPORT size_type countTextColumns(std::string_view row, TextFormat format);
+
+inline const char* skipTextBlanks(const char* position, const char* end, char delimiter)
+{
+    while (position != end && *position != delimiter &&
+           (*position == ' ' || *position == '\t' || *position == '\r' || *position == '\n'))
+    {
+        ++position;
+    }
+    return position;
+}
+
+template<typename T>
+void parseTextRow(std::string_view row, char delimiter, size_type columns, size_type rowIndex, T* output)
+{
+    auto position = row.data();
+    const auto end = position + row.size();
+    for (auto column = 0; column < columns; ++column)
+    {
+        position = skipTextBlanks(position, end, delimiter);
+        if (column > 0)
+        {
+            if (position == end || *position != delimiter)
+            {
+                THROW(std::out_of_range, "row ", rowIndex, " has ", column, " columns instead of ", columns);
+            }
+            position = skipTextBlanks(position + 1, end, delimiter);
+        }
+        if (position != end && *position == '+')
+        {
+            ++position;
+        }
+        const auto [next, error] = std::from_chars(position, end, output[column]);
+        if (error != std::errc{})
+        {
+            const auto fieldEnd = std::find(position, end, delimiter);
+            const auto field = std::string_view{position, static_cast<std::size_t>(fieldEnd - position)};
+            THROW(std::invalid_argument, "cannot parse '", field, "' in column ", column, " of row ", rowIndex);
+        }
+        position = next;
+    }
+    if (skipTextBlanks(position, end, delimiter) != end)
+    {
+        THROW(std::out_of_range, "row ", rowIndex, " has more than ", columns, " columns or trailing characters");
+    }
+}
+
+// Parses the text into a row-major matrix. The text is split into chunks on row boundaries and the chunks are first
+// counted and then parsed straight into the matrix on the executor threads, so nothing is buffered in between.
+template<typename T>
+Matrix<T> parseMatrixText(std::string_view text, TextFormat format,
+                          const dansandu::math::thread_pool::Executor& executor =
+                              dansandu::math::thread_pool::Executor{})
+{
+    static_assert(std::is_arithmetic_v<T>, "text can only be parsed into matrices of numbers");
+
+    const auto body = getTextBody(text, format);
+    const auto chunks =
+        splitTextIntoChunks(body, format, body.size() < textParallelThreshold ? 1 : 4 * executor.threadCount());
+    const auto chunkCount = static_cast<int>(chunks.size());
+
+    auto firstRows = std::vector<size_type>(chunks.size() + 1, 0);
+    executor.parallelFor(chunkCount, [&](int chunk) { firstRows[chunk + 1] = countTextRows(chunks[chunk], format); });
+    std::partial_sum(firstRows.cbegin(), firstRows.cend(), firstRows.begin());
+
+    auto rest = body;
+    auto firstRow = std::string_view{};
+    const auto rows = firstRows.back();
+    const auto columns = nextTextRow(rest, format, firstRow) ? countTextColumns(firstRow, format) : 0;
+
+    auto matrix = Matrix<T>{rows, columns, uninitialized};
+    const auto delimiter = getTextDelimiter(format);
+    const auto output = matrix.data();
+    executor.parallelFor(chunkCount,
+                         [&](int chunk)
+                         {
+                             auto remaining = chunks[chunk];
+                             auto row = std::string_view{};
+                             for (auto index = firstRows[chunk]; nextTextRow(remaining, format, row); ++index)
+                             {
+                                 parseTextRow(row, delimiter, columns, index, output + index * columns);
+                             }
+                         });
+    return matrix;
+}
+
+// Maps the file and parses it in place with parseMatrixText.
+template<typename T>
+Matrix<T> readMatrixText(const std::string& path, TextFormat format,
+                         const dansandu::math::thread_pool::Executor& executor =
+                             dansandu::math::thread_pool::Executor{})
+{
+    auto error = std::error_code{};
+    const auto size = std::filesystem::file_size(path, error);
+    if (error)
+    {
+        THROW(std::runtime_error, "cannot read text file '", path, "' -- ", error.message());
+    }
+    const auto file = MappedFile{path, MapMode::readOnly, 0, static_cast<std::size_t>(size), false};
+    file.advise(AccessPattern::sequential, 0, file.size());
+    return parseMatrixText<T>(std::string_view{reinterpret_cast<const char*>(file.data()), file.size()}, format,
+                              executor);
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+void formatTextRows(const MatrixImplementation<T, M, N, S>& matrix, TextFormat format, size_type firstRow,
+                    size_type rows, std::string& text)
+{
+    // Enough for the shortest round trip representation of any double or 64 bit integer and a separator.
+    constexpr auto elementChars = 32;
+
+    const auto columns = matrix.columnCount();
+    const auto separator = format == TextFormat::braces ? std::string_view{", "}
+                           : format == TextFormat::tsv  ? std::string_view{"\t"}
+                                                        : std::string_view{","};
+    text.resize(static_cast<std::size_t>(rows) * (columns * elementChars + 8));
+    auto position = text.data();
+    const auto end = text.data() + text.size();
+    for (auto row = firstRow; row < firstRow + rows; ++row)
+    {
+        if (format == TextFormat::braces)
+        {
+            if (row > 0)
+            {
+                *position++ = ',';
+                *position++ = ' ';
+            }
+            *position++ = '{';
+        }
+        for (auto column = 0; column < columns; ++column)
+        {
+            if (column > 0)
+            {
+                position = std::copy(separator.cbegin(), separator.cend(), position);
+            }
+            position = std::to_chars(position, end, matrix.unsafeSubscript(row, column)).ptr;
+        }
+        *position++ = format == TextFormat::braces ? '}' : '\n';
+    }
+    text.resize(static_cast<std::size_t>(position - text.data()));
+}
+
+// Writes the matrix with the shortest representation of each element that parses back to the same value. Blocks of
+// rows are formatted on the executor threads and written in order.
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+void writeMatrixText(std::ostream& stream, const MatrixImplementation<T, M, N, S>& matrix, TextFormat format,
+                     const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    static_assert(std::is_arithmetic_v<T>, "only matrices of numbers can be written as text");
+
+    constexpr auto blockRows = 1024;
+
+    const auto rows = matrix.rowCount();
+    const auto threads = rows * matrix.columnCount() < textFormatParallelThreshold ? 1 : executor.threadCount();
+    auto blocks = std::vector<std::string>(static_cast<std::size_t>(threads));
+
+    if (format == TextFormat::braces)
+    {
+        stream << '{';
+    }
+    for (auto firstRow = 0; firstRow < rows; firstRow += threads * blockRows)
+    {
+        const auto formatBlock = [&](int block)
+        {
+            const auto begin = std::min(rows, firstRow + block * blockRows);
+            formatTextRows(matrix, format, begin, std::min(rows, begin + blockRows) - begin, blocks[block]);
+        };
+        if (threads == 1)
+        {
+            formatBlock(0);
+        }
+        else
+        {
+            executor.parallelFor(threads, formatBlock);
+        }
+        for (const auto& block : blocks)
+        {
+            stream.write(block.data(), static_cast<std::streamsize>(block.size()));
+        }
+    }
+    if (format == TextFormat::braces)
+    {
+        stream << '}';
+    }
+    if (!stream)
+    {
+        THROW(std::runtime_error, "cannot write ", rows, "x", matrix.columnCount(), " matrix as text");
+    }
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+void writeMatrixText(const std::string& path, const MatrixImplementation<T, M, N, S>& matrix, TextFormat format,
+                     const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    auto stream = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    if (!stream)
+    {
+        THROW(std::runtime_error, "cannot open text file '", path, "' for writing");
+    }
+    writeMatrixText(stream, matrix, format, executor);
+}
+
+}
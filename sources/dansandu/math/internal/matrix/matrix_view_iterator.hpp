@@ -15,7 +15,7 @@ class MatrixViewIterator
 
     friend bool operator==(MatrixViewIterator left, MatrixViewIterator right)
     {
-        return left.getSourcePosition() == right.getSourcePosition();
+        return left.viewBegin_ == right.viewBegin_ && left.viewIndex_ == right.viewIndex_;
     }
 
 public:
@@ -25,26 +25,44 @@ public:
     using pointer = value_type*;
     using reference = value_type&;
 
-    MatrixViewIterator(pointer viewBegin, difference_type viewColumnCount, difference_type sourceColumnCount)
-        : viewBegin_{viewBegin}, viewIndex_{0}, viewColumnCount_{viewColumnCount}, sourceColumnCount_{sourceColumnCount}
+    MatrixViewIterator(pointer viewBegin, difference_type viewColumnCount, difference_type rowStride,
+                       difference_type columnStride)
+        : viewBegin_{viewBegin},
+          viewIndex_{0},
+          viewColumnCount_{viewColumnCount},
+          rowStride_{rowStride},
+          columnStride_{columnStride},
+          position_{viewBegin},
+          column_{0}
     {
     }
 
     auto& operator+=(size_type n)
     {
         viewIndex_ += n;
+        seek();
         return *this;
     }
 
     auto& operator-=(size_type n)
     {
         viewIndex_ -= n;
+        seek();
         return *this;
     }
 
     auto& operator++()
     {
         viewIndex_ += 1;
+        if (++column_ == viewColumnCount_)
+        {
+            column_ = 0;
+            position_ += rowStride_ - (viewColumnCount_ - 1) * columnStride_;
+        }
+        else
+        {
+            position_ += columnStride_;
+        }
         return *this;
     }
 
@@ -58,6 +76,16 @@ public:
     auto& operator--()
     {
         viewIndex_ -= 1;
+        if (column_ == 0)
+        {
+            column_ = viewColumnCount_ - 1;
+            position_ -= rowStride_ - (viewColumnCount_ - 1) * columnStride_;
+        }
+        else
+        {
+            --column_;
+            position_ -= columnStride_;
+        }
         return *this;
     }
 
@@ -70,24 +98,32 @@ public:
 
     auto& operator*() const
     {
-        return *getSourcePosition();
+        return *position_;
     }
 
     auto operator->() const
     {
-        return getSourcePosition();
+        return position_;
     }
 
 private:
-    auto getSourcePosition() const
+    // Steps and dereferences only move the cached position, which is recomputed from the index after jumps.
+    void seek()
     {
-        return viewBegin_ + (viewIndex_ / viewColumnCount_) * sourceColumnCount_ + viewIndex_ % viewColumnCount_;
+        if (viewColumnCount_ != 0)
+        {
+            column_ = viewIndex_ % viewColumnCount_;
+            position_ = viewBegin_ + (viewIndex_ / viewColumnCount_) * rowStride_ + column_ * columnStride_;
+        }
     }
 
     pointer viewBegin_;
     difference_type viewIndex_;
     difference_type viewColumnCount_;
-    difference_type sourceColumnCount_;
+    difference_type rowStride_;
+    difference_type columnStride_;
+    pointer position_;
+    difference_type column_;
 };
 
 template<typename T>
@@ -0,0 +1,441 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/matrix.hpp"
+#include "dansandu/math/internal/matrix/slicer.hpp"
+#include "dansandu/math/internal/matrix/trsm.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dansandu::math::matrix
+{
+
+// Reflectors are accumulated in blocks of this many columns and applied to the rest of the matrix with gemm.
+constexpr auto qrBlock = 32;
+
+// Applying a single reflector is split into row ranges of at least this many elements to run on several threads.
+constexpr auto qrParallelThreshold = 64 * 1024;
+
+enum class Pivoting
+{
+    none,
+    column
+};
+
+// The factors of A * P = Q * R packed into one matrix: R is on and above the diagonal and the Householder vectors of Q
+// are below it with an implied unit leading element, so that reflector j is I - tau[j] * v * v'. Column j of A * P is
+// column permutation[j] of A, which is the identity permutation without pivoting.
+template<typename T>
+struct QrDecomposition
+{
+    Matrix<T> factors;
+    std::vector<T> tau;
+    std::vector<int> permutation;
+    Pivoting pivoting;
+};
+
+// Turns column k of a below the diagonal into a Householder vector that zeroes it, stores the resulting diagonal
+// element of R and returns the scalar factor of the reflector.
+template<typename T>
+T generateReflector(const MatrixView<T> a, size_type k)
+{
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    auto sigma = zero;
+    for (auto i = k + 1; i < a.rowCount(); ++i)
+    {
+        sigma += a.unsafeSubscript(i, k) * a.unsafeSubscript(i, k);
+    }
+    if (sigma == zero)
+    {
+        return zero;
+    }
+
+    const auto alpha = a.unsafeSubscript(k, k);
+    const auto beta = -std::copysign(std::sqrt(alpha * alpha + sigma), alpha);
+    const auto scale = dansandu::math::common::multiplicativeIdentity<T> / (alpha - beta);
+    for (auto i = k + 1; i < a.rowCount(); ++i)
+    {
+        a.unsafeSubscript(i, k) *= scale;
+    }
+    a.unsafeSubscript(k, k) = beta;
+    return (beta - alpha) / beta;
+}
+
+// Applies reflector k of the factors to columns [firstColumn, lastColumn) of a from the left. Both passes over the
+// rows, the projection and the update, are split into row ranges that run on the executor threads.
+template<typename T>
+void applyReflector(const ConstantMatrixView<T> factors, size_type k, T tau, const MatrixView<T> a,
+                    size_type firstColumn, size_type lastColumn, const dansandu::math::thread_pool::Executor& executor)
+{
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    const auto rows = a.rowCount() - k;
+    const auto columns = lastColumn - firstColumn;
+    if (tau == zero || columns <= 0)
+    {
+        return;
+    }
+
+    const auto elements = static_cast<long long>(rows) * columns;
+    const auto ranges =
+        static_cast<int>(std::min<long long>(executor.threadCount(), std::max(elements / qrParallelThreshold, 1LL)));
+    const auto getRangeBegin = [&](int range)
+    { return k + static_cast<size_type>(static_cast<long long>(rows) * range / ranges); };
+
+    auto partials = std::vector<T>(static_cast<std::size_t>(ranges) * columns, zero);
+    const auto project = [&](int range)
+    {
+        const auto partial = partials.data() + static_cast<std::size_t>(range) * columns;
+        for (auto i = getRangeBegin(range); i < getRangeBegin(range + 1); ++i)
+        {
+            const auto v = i == k ? dansandu::math::common::multiplicativeIdentity<T> : factors.unsafeSubscript(i, k);
+            for (auto j = 0; j < columns; ++j)
+            {
+                partial[j] += v * a.unsafeSubscript(i, firstColumn + j);
+            }
+        }
+    };
+    const auto update = [&](int range)
+    {
+        for (auto i = getRangeBegin(range); i < getRangeBegin(range + 1); ++i)
+        {
+            const auto v = i == k ? dansandu::math::common::multiplicativeIdentity<T> : factors.unsafeSubscript(i, k);
+            const auto scalar = tau * v;
+            for (auto j = 0; j < columns; ++j)
+            {
+                a.unsafeSubscript(i, firstColumn + j) -= scalar * partials[j];
+            }
+        }
+    };
+
+    if (ranges == 1)
+    {
+        project(0);
+        update(0);
+    }
+    else
+    {
+        executor.parallelFor(ranges, project);
+        for (auto range = 1; range < ranges; ++range)
+        {
+            for (auto j = 0; j < columns; ++j)
+            {
+                partials[j] += partials[static_cast<std::size_t>(range) * columns + j];
+            }
+        }
+        executor.parallelFor(ranges, update);
+    }
+}
+
+// Applies the block of reflectors [k, k + width) of the factors, or its transpose, to c from the left, where c holds
+// rows [k, m) of the operand. The block is I - V * T * V' in compact WY form, so the whole update is three gemm calls.
+// The leading width x width part of V is copied out with its unit diagonal while the rest is read in place.
+template<typename T>
+void applyBlockReflector(const ConstantMatrixView<T> factors, const std::vector<T>& tau, size_type k, size_type width,
+                         Transposition transposition, const MatrixView<T> c,
+                         const dansandu::math::thread_pool::Executor& executor)
+{
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    const auto rows = factors.rowCount() - k;
+    const auto columns = c.columnCount();
+
+    auto v1 = Matrix<T>{width, width, zero};
+    for (auto i = 0; i < width; ++i)
+    {
+        v1.unsafeSubscript(i, i) = one;
+        for (auto j = 0; j < i; ++j)
+        {
+            v1.unsafeSubscript(i, j) = factors.unsafeSubscript(k + i, k + j);
+        }
+    }
+    const auto v2 = unsafeSlice(factors, k + width, k, rows - width, width);
+    const auto c1 = unsafeSlice(c, 0, 0, width, columns);
+    const auto c2 = unsafeSlice(c, width, 0, rows - width, columns);
+
+    auto gram = Matrix<T>{width, width, uninitialized};
+    gemm(one, v1, Transposition::transposed, v1, Transposition::none, zero, gram, executor);
+    gemm(one, v2, Transposition::transposed, v2, Transposition::none, one, gram, executor);
+
+    // T is upper triangular with T(0:i, i) = -tau[i] * T(0:i, 0:i) * V(:, 0:i)' * v_i.
+    auto triangular = Matrix<T>{width, width, zero};
+    for (auto i = 0; i < width; ++i)
+    {
+        const auto scalar = tau[static_cast<std::size_t>(k + i)];
+        triangular.unsafeSubscript(i, i) = scalar;
+        for (auto r = 0; r < i; ++r)
+        {
+            auto sum = zero;
+            for (auto p = r; p < i; ++p)
+            {
+                sum += triangular.unsafeSubscript(r, p) * gram.unsafeSubscript(p, i);
+            }
+            triangular.unsafeSubscript(r, i) = -scalar * sum;
+        }
+    }
+
+    auto projection = Matrix<T>{width, columns, uninitialized};
+    gemm(one, v1, Transposition::transposed, c1, Transposition::none, zero, projection, executor);
+    gemm(one, v2, Transposition::transposed, c2, Transposition::none, one, projection, executor);
+
+    auto scaled = Matrix<T>{width, columns, uninitialized};
+    gemm(one, triangular, transposition, projection, Transposition::none, zero, scaled, executor);
+
+    gemm(-one, v1, Transposition::none, scaled, Transposition::none, one, c1, executor);
+    gemm(-one, v2, Transposition::none, scaled, Transposition::none, one, c2, executor);
+}
+
+// Right-looking blocked factorization: each panel of qrBlock columns is factored one reflector at a time and the
+// trailing matrix is then updated with a single block reflector.
+template<typename T>
+void qrDecomposeBlocked(const MatrixView<T> a, std::vector<T>& tau,
+                        const dansandu::math::thread_pool::Executor& executor)
+{
+    const auto m = a.rowCount();
+    const auto n = a.columnCount();
+    const auto k = std::min(m, n);
+    for (auto j = 0; j < k; j += qrBlock)
+    {
+        const auto width = std::min(qrBlock, k - j);
+        for (auto column = j; column < j + width; ++column)
+        {
+            tau[column] = generateReflector(a, column);
+            applyReflector<T>(a, column, tau[column], a, column + 1, j + width, executor);
+        }
+
+        const auto trailing = n - j - width;
+        if (trailing > 0)
+        {
+            applyBlockReflector<T>(a, tau, j, width, Transposition::transposed,
+                                   unsafeSlice(a, j, j + width, m - j, trailing), executor);
+        }
+    }
+}
+
+template<typename T>
+T getColumnNorm(const ConstantMatrixView<T> a, size_type column, size_type firstRow)
+{
+    auto sum = dansandu::math::common::additiveIdentity<T>;
+    for (auto i = firstRow; i < a.rowCount(); ++i)
+    {
+        sum += a.unsafeSubscript(i, column) * a.unsafeSubscript(i, column);
+    }
+    return std::sqrt(sum);
+}
+
+// Factorization with column pivoting, where each step brings the remaining column of largest norm forward. Choosing
+// a pivot needs every trailing column to be up to date, so reflectors are applied to the whole trailing matrix one at
+// a time instead of in blocks. The column norms are downdated after each step and recomputed when cancellation makes
+// the downdate inaccurate.
+template<typename T>
+void qrDecomposePivoted(const MatrixView<T> a, std::vector<T>& tau, std::vector<int>& permutation,
+                        const dansandu::math::thread_pool::Executor& executor)
+{
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    const auto m = a.rowCount();
+    const auto n = a.columnCount();
+    const auto k = std::min(m, n);
+    const auto tolerance = std::sqrt(std::numeric_limits<T>::epsilon());
+
+    auto norms = std::vector<T>(n);
+    for (auto j = 0; j < n; ++j)
+    {
+        norms[j] = getColumnNorm<T>(a, j, 0);
+    }
+    auto referenceNorms = norms;
+
+    for (auto j = 0; j < k; ++j)
+    {
+        const auto pivot =
+            static_cast<size_type>(std::max_element(norms.begin() + j, norms.end()) - norms.begin());
+        if (pivot != j)
+        {
+            for (auto i = 0; i < m; ++i)
+            {
+                std::swap(a.unsafeSubscript(i, j), a.unsafeSubscript(i, pivot));
+            }
+            std::swap(permutation[j], permutation[pivot]);
+            std::swap(norms[j], norms[pivot]);
+            std::swap(referenceNorms[j], referenceNorms[pivot]);
+        }
+
+        tau[j] = generateReflector(a, j);
+        applyReflector<T>(a, j, tau[j], a, j + 1, n, executor);
+
+        for (auto column = j + 1; column < n; ++column)
+        {
+            if (norms[column] != zero)
+            {
+                const auto ratio = std::abs(a.unsafeSubscript(j, column)) / norms[column];
+                const auto remaining = std::max(one - ratio * ratio, zero);
+                const auto relative = norms[column] / referenceNorms[column];
+                if (remaining * relative * relative <= tolerance)
+                {
+                    norms[column] = getColumnNorm<T>(a, column, j + 1);
+                    referenceNorms[column] = norms[column];
+                }
+                else
+                {
+                    norms[column] *= std::sqrt(remaining);
+                }
+            }
+        }
+    }
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+QrDecomposition<T> qrDecompose(const MatrixImplementation<T, M, N, S>& a, Pivoting pivoting = Pivoting::none,
+                               const dansandu::math::thread_pool::Executor& executor =
+                                   dansandu::math::thread_pool::Executor{})
+{
+    static_assert(std::is_floating_point_v<T>, "QR decomposition requires floating point matrices");
+
+    auto factors = Matrix<T>{a};
+    auto tau = std::vector<T>(std::min(a.rowCount(), a.columnCount()));
+    auto permutation = std::vector<int>(a.columnCount());
+    std::iota(permutation.begin(), permutation.end(), 0);
+    if (pivoting == Pivoting::column)
+    {
+        qrDecomposePivoted<T>(factors, tau, permutation, executor);
+    }
+    else
+    {
+        qrDecomposeBlocked<T>(factors, tau, executor);
+    }
+    return {std::move(factors), std::move(tau), std::move(permutation), pivoting};
+}
+
+// Overwrites b with Q * b or Q' * b, where b has as many rows as the decomposed matrix.
+template<typename T>
+void applyQ(const QrDecomposition<T>& qr, Transposition transposition, const MatrixView<std::common_type_t<T>> b,
+            const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    const auto m = qr.factors.rowCount();
+    if (b.rowCount() != m)
+    {
+        THROW(std::logic_error, "cannot apply the Q factor of a ", m, "x", qr.factors.columnCount(),
+              " matrix to a ", b.rowCount(), "x", b.columnCount(), " matrix -- the row counts must match");
+    }
+
+    const auto k = static_cast<size_type>(qr.tau.size());
+    const auto blocks = (k + qrBlock - 1) / qrBlock;
+    for (auto step = 0; step < blocks; ++step)
+    {
+        const auto block = transposition == Transposition::transposed ? step : blocks - 1 - step;
+        const auto j = block * qrBlock;
+        const auto width = std::min(qrBlock, k - j);
+        applyBlockReflector<T>(qr.factors, qr.tau, j, width, transposition,
+                               unsafeSlice(b, j, 0, m - j, b.columnCount()), executor);
+    }
+}
+
+// Returns the first min(m, n) columns of Q.
+template<typename T>
+Matrix<T> getQ(const QrDecomposition<T>& qr,
+               const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    const auto m = qr.factors.rowCount();
+    const auto k = static_cast<size_type>(qr.tau.size());
+    auto q = Matrix<T>{m, k, dansandu::math::common::additiveIdentity<T>};
+    for (auto i = 0; i < k; ++i)
+    {
+        q.unsafeSubscript(i, i) = dansandu::math::common::multiplicativeIdentity<T>;
+    }
+    applyQ(qr, Transposition::none, q, executor);
+    return q;
+}
+
+// Returns the upper triangular min(m, n) x n factor R.
+template<typename T>
+Matrix<T> getR(const QrDecomposition<T>& qr)
+{
+    const auto n = qr.factors.columnCount();
+    const auto k = static_cast<size_type>(qr.tau.size());
+    auto r = Matrix<T>{k, n, dansandu::math::common::additiveIdentity<T>};
+    for (auto i = 0; i < k; ++i)
+    {
+        for (auto j = i; j < n; ++j)
+        {
+            r.unsafeSubscript(i, j) = qr.factors.unsafeSubscript(i, j);
+        }
+    }
+    return r;
+}
+
+// Minimizes |a * x - b| for every column of b. Without pivoting, a must have full column rank and at least as many rows
+// as columns. With column pivoting, the numerical rank is the number of diagonal elements of R above a relative
+// tolerance and the basic solution with zeros for the trailing pivoted columns is returned, which also covers rank
+// deficient and underdetermined systems.
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+Matrix<T> leastSquares(const QrDecomposition<T>& qr, const MatrixImplementation<T, M, N, S>& b,
+                       const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    const auto m = qr.factors.rowCount();
+    const auto n = qr.factors.columnCount();
+    const auto k = static_cast<size_type>(qr.tau.size());
+    if (b.rowCount() != m)
+    {
+        THROW(std::logic_error, "cannot solve a ", m, "x", n, " least squares system for a ", b.rowCount(), "x",
+              b.columnCount(), " right-hand side -- the right-hand side must have as many rows as the system");
+    }
+
+    if (qr.pivoting == Pivoting::none && m < n)
+    {
+        THROW(std::logic_error, "cannot solve an underdetermined ", m, "x", n,
+              " least squares system without column pivoting");
+    }
+
+    auto largest = zero;
+    for (auto i = 0; i < k; ++i)
+    {
+        largest = std::max(largest, std::abs(qr.factors.unsafeSubscript(i, i)));
+    }
+    const auto threshold = largest * std::max(m, n) * std::numeric_limits<T>::epsilon();
+    auto rank = 0;
+    while (rank < k && std::abs(qr.factors.unsafeSubscript(rank, rank)) > threshold)
+    {
+        ++rank;
+    }
+    if (qr.pivoting == Pivoting::none && rank < n)
+    {
+        THROW(std::logic_error, "cannot solve a rank deficient ", m, "x", n,
+              " least squares system without column pivoting");
+    }
+
+    auto projected = Matrix<T>{b};
+    applyQ(qr, Transposition::transposed, projected, executor);
+
+    const auto columns = b.columnCount();
+    const auto solution = unsafeSlice(projected, 0, 0, rank, columns);
+    trsm(Side::left, Triangle::upper, Transposition::none, Diagonal::nonUnit,
+         dansandu::math::common::multiplicativeIdentity<T>, unsafeSlice(qr.factors, 0, 0, rank, rank), solution,
+         executor);
+
+    auto x = Matrix<T>{n, columns, zero};
+    for (auto i = 0; i < rank; ++i)
+    {
+        sliceRow(x, qr.permutation[i]).deepCopy(sliceRow(projected, i));
+    }
+    return x;
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S, size_type MM, size_type NN,
+         DataStorageStrategy SS>
+Matrix<T> leastSquares(const MatrixImplementation<T, M, N, S>& a, const MatrixImplementation<T, MM, NN, SS>& b,
+                       Pivoting pivoting = Pivoting::none,
+                       const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    return leastSquares(qrDecompose(a, pivoting, executor), b, executor);
+}
+
+}
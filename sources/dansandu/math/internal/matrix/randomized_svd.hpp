@@ -0,0 +1,229 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/mapped_matrix.hpp"
+#include "dansandu/math/internal/matrix/matrix.hpp"
+#include "dansandu/math/internal/matrix/matrix_file.hpp"
+#include "dansandu/math/internal/matrix/qr.hpp"
+#include "dansandu/math/internal/matrix/slicer.hpp"
+#include "dansandu/math/internal/matrix/sparse_matrix.hpp"
+#include "dansandu/math/internal/matrix/svd.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace dansandu::math::matrix
+{
+
+// The sketch is rank + oversampling columns wide. Every power iteration costs two more passes over the matrix and
+// sharpens the estimate when the singular values decay slowly. Streamed files are read chunkRows rows at a time.
+struct RandomizedSvdOptions
+{
+    size_type oversampling = 10;
+    int powerIterations = 2;
+    std::uint64_t seed = 0;
+    size_type chunkRows = 4096;
+};
+
+template<typename T>
+Matrix<T> orthonormalizeColumns(const Matrix<T>& y, const dansandu::math::thread_pool::Executor& executor)
+{
+    return getQ(qrDecompose(y, Pivoting::none, executor), executor);
+}
+
+// Computes the top rank singular triplets of an m x n matrix that is only touched through its products. multiply
+// overwrites an m x l output with A * X for an n x l X and multiplyTransposed overwrites an n x l output with A' * Y
+// for an m x l Y, so the matrix is read 2 * powerIterations + 2 times in total. The range of A is captured by Q, the
+// orthonormalized product with a Gaussian sketch, and the small l x n matrix Q' * A is decomposed exactly.
+template<typename T, typename Multiply, typename MultiplyTransposed>
+SingularValueDecomposition<T> randomizedSvdFromProducts(size_type rows, size_type columns, size_type rank,
+                                                        const RandomizedSvdOptions& options, Multiply&& multiply,
+                                                        MultiplyTransposed&& multiplyTransposed,
+                                                        const dansandu::math::thread_pool::Executor& executor)
+{
+    static_assert(std::is_floating_point_v<T>, "randomized singular value decomposition requires floating point");
+
+    const auto smallest = std::min(rows, columns);
+    if (rank <= 0 || rank > smallest)
+    {
+        THROW(std::invalid_argument, "invalid rank ", rank, " for a ", rows, "x", columns,
+              " matrix -- the rank must be between one and the smallest dimension");
+    }
+    if (options.oversampling < 0 || options.powerIterations < 0)
+    {
+        THROW(std::invalid_argument, "invalid oversampling ", options.oversampling, " or power iterations ",
+              options.powerIterations, " -- both must be non-negative");
+    }
+
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    const auto width = std::min(rank + std::min(options.oversampling, smallest), smallest);
+    auto generator = std::mt19937_64{options.seed};
+    auto distribution = std::normal_distribution<T>{zero, one};
+    auto sketch = Matrix<T>{columns, width, uninitialized};
+    for (auto& element : sketch)
+    {
+        element = distribution(generator);
+    }
+
+    auto range = Matrix<T>{rows, width, uninitialized};
+    multiply(sketch, range);
+    auto q = orthonormalizeColumns(range, executor);
+    for (auto iteration = 0; iteration < options.powerIterations; ++iteration)
+    {
+        multiplyTransposed(q, sketch);
+        sketch = orthonormalizeColumns(sketch, executor);
+        multiply(sketch, range);
+        q = orthonormalizeColumns(range, executor);
+    }
+
+    // B' = A' * Q = Ub * S * Vb' is tall, so A ~ Q * B = (Q * Vb) * S * Ub'.
+    multiplyTransposed(q, sketch);
+    const auto small = singularValueDecompose(sketch, SvdMode::thin, executor);
+    auto result = SingularValueDecomposition<T>{};
+    result.values = Matrix<T>{unsafeSlice(small.values, 0, 0, rank, 1)};
+    result.v = Matrix<T>{unsafeSlice(small.u, 0, 0, columns, rank)};
+    result.u = Matrix<T>{rows, rank, uninitialized};
+    gemm(one, q, Transposition::none, unsafeSlice(small.v, 0, 0, width, rank), Transposition::none, zero, result.u,
+         executor);
+    return result;
+}
+
+// Returns the top rank singular values in descending order with their m x rank left and n x rank right vectors,
+// found from a Gaussian sketch of the range of A. Use it when the full decomposition is unaffordable and only the
+// leading triplets are needed.
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+SingularValueDecomposition<T> randomizedSvd(const MatrixImplementation<T, M, N, S>& a, size_type rank,
+                                            const RandomizedSvdOptions& options = RandomizedSvdOptions{},
+                                            const dansandu::math::thread_pool::Executor& executor =
+                                                dansandu::math::thread_pool::Executor{})
+{
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    return randomizedSvdFromProducts<T>(
+        a.rowCount(), a.columnCount(), rank, options,
+        [&](const Matrix<T>& x, Matrix<T>& y)
+        { gemm(one, a, Transposition::none, x, Transposition::none, zero, y, executor); },
+        [&](const Matrix<T>& x, Matrix<T>& y)
+        { gemm(one, a, Transposition::transposed, x, Transposition::none, zero, y, executor); },
+        executor);
+}
+
+template<typename T, Layout L>
+SingularValueDecomposition<T> randomizedSvd(const SparseMatrix<T, L>& a, size_type rank,
+                                            const RandomizedSvdOptions& options = RandomizedSvdOptions{},
+                                            const dansandu::math::thread_pool::Executor& executor =
+                                                dansandu::math::thread_pool::Executor{})
+{
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    return randomizedSvdFromProducts<T>(
+        a.rowCount(), a.columnCount(), rank, options,
+        [&](const Matrix<T>& x, Matrix<T>& y)
+        { gemm(one, a, Transposition::none, x, Transposition::none, zero, y, executor); },
+        [&](const Matrix<T>& x, Matrix<T>& y)
+        { gemm(one, a, Transposition::transposed, x, Transposition::none, zero, y, executor); },
+        executor);
+}
+
+// Runs the sketch over a matrix that is visited as consecutive blocks of rows. forEachRowBlock(visit) calls
+// visit(firstRow, block) for blocks that cover all the rows in order, so the matrix never has to be viewed whole and
+// may hold more elements than size_type can count as long as every block, the m x l range and the n x l sketch fit.
+template<typename T, typename ForEachRowBlock>
+SingularValueDecomposition<T> randomizedSvdFromRowBlocks(size_type rows, size_type columns, size_type rank,
+                                                         const RandomizedSvdOptions& options,
+                                                         ForEachRowBlock&& forEachRowBlock,
+                                                         const dansandu::math::thread_pool::Executor& executor)
+{
+    if (options.chunkRows <= 0)
+    {
+        THROW(std::invalid_argument, "invalid chunk size ", options.chunkRows,
+              " -- chunks must hold at least one row");
+    }
+
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    return randomizedSvdFromProducts<T>(
+        rows, columns, rank, options,
+        [&](const Matrix<T>& x, Matrix<T>& y)
+        {
+            forEachRowBlock(
+                [&](size_type firstRow, const ConstantMatrixView<T> block)
+                {
+                    gemm(one, block, Transposition::none, x, Transposition::none, zero,
+                         unsafeSlice(y, firstRow, 0, block.rowCount(), y.columnCount()), executor);
+                });
+        },
+        [&](const Matrix<T>& x, Matrix<T>& y)
+        {
+            std::fill(y.begin(), y.end(), zero);
+            forEachRowBlock(
+                [&](size_type firstRow, const ConstantMatrixView<T> block)
+                {
+                    gemm(one, block, Transposition::transposed,
+                         unsafeSlice(x, firstRow, 0, block.rowCount(), x.columnCount()), Transposition::none, one, y,
+                         executor);
+                });
+        },
+        executor);
+}
+
+// Row-major mapped matrices are visited in blocks of options.chunkRows rows, so they may be larger than a single view
+// can address. The elements are read front to back on every pass, so the kernel is told to read ahead.
+template<typename T>
+SingularValueDecomposition<T> randomizedSvd(const MappedMatrix<T>& a, size_type rank,
+                                            const RandomizedSvdOptions& options = RandomizedSvdOptions{},
+                                            const dansandu::math::thread_pool::Executor& executor =
+                                                dansandu::math::thread_pool::Executor{})
+{
+    a.advise(AccessPattern::sequential);
+    if (a.layout() != Layout::rowMajor)
+    {
+        return randomizedSvd(a.constantView(), rank, options, executor);
+    }
+    return randomizedSvdFromRowBlocks<T>(
+        a.rowCount(), a.columnCount(), rank, options,
+        [&](auto&& visit)
+        {
+            for (auto firstRow = 0; firstRow < a.rowCount(); firstRow += options.chunkRows)
+            {
+                const auto rows = std::min(options.chunkRows, a.rowCount() - firstRow);
+                visit(firstRow, a.constantRowsView(firstRow, rows));
+            }
+        },
+        executor);
+}
+
+// Streams the row-major matrix file in chunks of options.chunkRows rows on every pass, so only one chunk, the m x l
+// range and the n x l sketch are held in memory. The file may hold more elements than size_type can count, e.g. a
+// 1000000 x 10000 matrix, as long as a chunk fits.
+template<typename T>
+SingularValueDecomposition<T> randomizedSvdOfFile(const std::string& path, size_type rank,
+                                                  const RandomizedSvdOptions& options = RandomizedSvdOptions{},
+                                                  const dansandu::math::thread_pool::Executor& executor =
+                                                      dansandu::math::thread_pool::Executor{})
+{
+    const auto header = MatrixFileReader<T>{path}.header();
+    auto chunk = Matrix<T>{};
+    return randomizedSvdFromRowBlocks<T>(
+        header.rows, header.columns, rank, options,
+        [&](auto&& visit)
+        {
+            auto reader = MatrixFileReader<T>{path};
+            for (auto firstRow = 0, rows = reader.read(chunk, options.chunkRows); rows > 0;
+                 firstRow += rows, rows = reader.read(chunk, options.chunkRows))
+            {
+                visit(firstRow, ConstantMatrixView<T>{chunk});
+            }
+        },
+        executor);
+}
+
+}
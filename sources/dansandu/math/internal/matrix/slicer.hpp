@@ -19,9 +19,10 @@ public:
     {
         const auto [viewBeginRow, viewBeginColumn, viewRows, viewColumns] = unpackArguments(matrix, arguments...);
 
-        const auto viewBegin = matrix.data() + viewBeginRow * matrix.sourceColumnCount() + viewBeginColumn;
+        const auto viewBegin =
+            matrix.data() + viewBeginRow * matrix.rowStride() + viewBeginColumn * matrix.columnStride();
 
-        return {viewRows, viewColumns, matrix.sourceRowCount(), matrix.sourceColumnCount(), viewBegin};
+        return {viewRows, viewColumns, matrix.rowStride(), matrix.columnStride(), viewBegin};
     }
 
     template<typename T, size_type M, size_type N, DataStorageStrategy S, typename... A>
@@ -32,9 +33,10 @@ public:
     {
         const auto [viewBeginRow, viewBeginColumn, viewRows, viewColumns] = unpackArguments(matrix, arguments...);
 
-        const auto viewBegin = matrix.data() + viewBeginRow * matrix.sourceColumnCount() + viewBeginColumn;
+        const auto viewBegin =
+            matrix.data() + viewBeginRow * matrix.rowStride() + viewBeginColumn * matrix.columnStride();
 
-        return {viewRows, viewColumns, matrix.sourceRowCount(), matrix.sourceColumnCount(), viewBegin};
+        return {viewRows, viewColumns, matrix.rowStride(), matrix.columnStride(), viewBegin};
     }
 
 private:
@@ -100,4 +102,23 @@ auto sliceColumn(M&& matrix, int column)
     }
 }
 
+// Slices like Slicer without checking the bounds, which also allows empty slices. The blocked factorizations use it to
+// address their panels and trailing blocks.
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+auto unsafeSlice(const MatrixImplementation<T, M, N, S>& matrix, size_type beginRow, size_type beginColumn,
+                 size_type rows, size_type columns)
+{
+    using View = std::conditional_t<isView(S), MatrixView<T>, ConstantMatrixView<T>>;
+    return View{rows, columns, matrix.rowStride(), matrix.columnStride(),
+                matrix.data() + beginRow * matrix.rowStride() + beginColumn * matrix.columnStride()};
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S, typename = std::enable_if_t<isContainer(S)>>
+auto unsafeSlice(MatrixImplementation<T, M, N, S>& matrix, size_type beginRow, size_type beginColumn, size_type rows,
+                 size_type columns)
+{
+    return MatrixView<T>{rows, columns, matrix.rowStride(), matrix.columnStride(),
+                         matrix.data() + beginRow * matrix.rowStride() + beginColumn * matrix.columnStride()};
+}
+
 }
@@ -0,0 +1,513 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/matrix.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dansandu::math::matrix
+{
+
+template<typename T>
+struct Triplet
+{
+    size_type row;
+    size_type column;
+    T value;
+};
+
+// Products with fewer multiply-adds than this are not worth waking up other threads for.
+constexpr auto sparseParallelThreshold = 64 * 1024;
+
+// A rows x columns matrix that stores only its non-zero elements. The row-major layout is the compressed sparse row
+// format, where offsets[i] is the position of the first element of row i in indices, which holds column indices, and
+// values. The column-major layout is the compressed sparse column format with the roles of rows and columns swapped.
+// Indices are sorted and unique within each row or column. Offsets are 64 bit so that the number of non-zeros is not
+// limited by size_type.
+template<typename T, Layout L = Layout::rowMajor>
+class SparseMatrix
+{
+public:
+    using value_type = T;
+
+    static constexpr auto layout = L;
+
+    SparseMatrix() : SparseMatrix{0, 0}
+    {
+    }
+
+    SparseMatrix(size_type rows, size_type columns)
+        : rows_{validateDimension(rows)}, columns_{validateDimension(columns)}, offsets_(getMajorCount() + 1, 0)
+    {
+    }
+
+    // Sums duplicate triplets. The triplets can come in any order.
+    SparseMatrix(size_type rows, size_type columns, const std::vector<Triplet<T>>& triplets)
+        : SparseMatrix{rows, columns}
+    {
+        for (const auto& triplet : triplets)
+        {
+            if (triplet.row < 0 || triplet.row >= rows_ || triplet.column < 0 || triplet.column >= columns_)
+            {
+                THROW(std::out_of_range, "cannot place element (", triplet.row, ", ", triplet.column, ") in a ", rows_,
+                      "x", columns_, " sparse matrix");
+            }
+            ++offsets_[getMajor(triplet) + 1];
+        }
+        std::partial_sum(offsets_.cbegin(), offsets_.cend(), offsets_.begin());
+
+        auto next = std::vector<std::size_t>(offsets_.cbegin(), offsets_.cend() - 1);
+        indices_.resize(triplets.size());
+        values_.resize(triplets.size());
+        for (const auto& triplet : triplets)
+        {
+            const auto position = next[getMajor(triplet)]++;
+            indices_[position] = getMinor(triplet);
+            values_[position] = triplet.value;
+        }
+
+        // Each row or column is sorted by index and its duplicates are summed while it is compacted to the front,
+        // which never overwrites a row or column that is still to be read.
+        auto entries = std::vector<std::pair<size_type, T>>{};
+        auto write = std::size_t{0};
+        for (auto major = 0; major < getMajorCount(); ++major)
+        {
+            entries.clear();
+            for (auto position = offsets_[major]; position < offsets_[major + 1]; ++position)
+            {
+                entries.emplace_back(indices_[position], values_[position]);
+            }
+            std::stable_sort(entries.begin(), entries.end(),
+                             [](const auto& left, const auto& right) { return left.first < right.first; });
+            offsets_[major] = write;
+            for (auto entry = entries.cbegin(); entry != entries.cend(); ++entry)
+            {
+                if (entry != entries.cbegin() && entry->first == (entry - 1)->first)
+                {
+                    values_[write - 1] += entry->second;
+                }
+                else
+                {
+                    indices_[write] = entry->first;
+                    values_[write] = entry->second;
+                    ++write;
+                }
+            }
+        }
+        offsets_.back() = write;
+        indices_.resize(write);
+        values_.resize(write);
+    }
+
+    // Adopts arrays that are already in the compressed format of the layout.
+    SparseMatrix(size_type rows, size_type columns, std::vector<std::size_t> offsets, std::vector<size_type> indices,
+                 std::vector<T> values)
+        : rows_{validateDimension(rows)},
+          columns_{validateDimension(columns)},
+          offsets_{std::move(offsets)},
+          indices_{std::move(indices)},
+          values_{std::move(values)}
+    {
+        if (offsets_.size() != static_cast<std::size_t>(getMajorCount()) + 1 || offsets_.front() != 0 ||
+            offsets_.back() != indices_.size() || indices_.size() != values_.size())
+        {
+            THROW(std::invalid_argument, "compressed arrays of sizes ", offsets_.size(), ", ", indices_.size(), " and ",
+                  values_.size(), " do not describe a ", rows_, "x", columns_, " sparse matrix");
+        }
+        for (auto major = 0; major < getMajorCount(); ++major)
+        {
+            if (offsets_[major] > offsets_[major + 1])
+            {
+                THROW(std::invalid_argument, "compressed offsets must not decrease");
+            }
+            for (auto position = offsets_[major]; position < offsets_[major + 1]; ++position)
+            {
+                if (indices_[position] < 0 || indices_[position] >= getMinorCount() ||
+                    (position > offsets_[major] && indices_[position] <= indices_[position - 1]))
+                {
+                    THROW(std::invalid_argument, "compressed indices must be in range, sorted and unique within each ",
+                          L == Layout::rowMajor ? "row" : "column");
+                }
+            }
+        }
+    }
+
+    // Keeps the elements of the dense matrix that are not zero.
+    template<size_type M, size_type N, DataStorageStrategy S>
+    explicit SparseMatrix(const MatrixImplementation<T, M, N, S>& dense)
+        : SparseMatrix{dense.rowCount(), dense.columnCount()}
+    {
+        for (auto major = 0; major < getMajorCount(); ++major)
+        {
+            for (auto minor = 0; minor < getMinorCount(); ++minor)
+            {
+                const auto& value = L == Layout::rowMajor ? dense.unsafeSubscript(major, minor)
+                                                          : dense.unsafeSubscript(minor, major);
+                if (value != dansandu::math::common::additiveIdentity<T>)
+                {
+                    indices_.push_back(minor);
+                    values_.push_back(value);
+                }
+            }
+            offsets_[major + 1] = indices_.size();
+        }
+    }
+
+    // Converts between the compressed row and compressed column formats with a counting sort.
+    template<Layout LL, typename = std::enable_if_t<LL != L>>
+    explicit SparseMatrix(const SparseMatrix<T, LL>& other)
+        : SparseMatrix{other.rowCount(), other.columnCount()}
+    {
+        const auto& otherIndices = other.indices();
+        const auto& otherValues = other.values();
+        for (const auto index : otherIndices)
+        {
+            ++offsets_[index + 1];
+        }
+        std::partial_sum(offsets_.cbegin(), offsets_.cend(), offsets_.begin());
+
+        auto next = std::vector<std::size_t>(offsets_.cbegin(), offsets_.cend() - 1);
+        indices_.resize(otherIndices.size());
+        values_.resize(otherValues.size());
+        const auto& otherOffsets = other.offsets();
+        for (auto otherMajor = 0; otherMajor < getMinorCount(); ++otherMajor)
+        {
+            for (auto position = otherOffsets[otherMajor]; position < otherOffsets[otherMajor + 1]; ++position)
+            {
+                const auto target = next[otherIndices[position]]++;
+                indices_[target] = otherMajor;
+                values_[target] = otherValues[position];
+            }
+        }
+    }
+
+    auto rowCount() const
+    {
+        return rows_;
+    }
+
+    auto columnCount() const
+    {
+        return columns_;
+    }
+
+    auto nonZeroCount() const
+    {
+        return indices_.size();
+    }
+
+    const auto& offsets() const
+    {
+        return offsets_;
+    }
+
+    const auto& indices() const
+    {
+        return indices_;
+    }
+
+    const auto& values() const
+    {
+        return values_;
+    }
+
+    // The stored values can be changed in place, the sparsity pattern cannot.
+    auto& values()
+    {
+        return values_;
+    }
+
+    // Returns the element at the given position, which is zero unless it is stored.
+    T operator()(size_type row, size_type column) const
+    {
+        if (row < 0 || row >= rows_ || column < 0 || column >= columns_)
+        {
+            THROW(std::out_of_range, "cannot index the (", row, ", ", column, ") element in a ", rows_, "x", columns_,
+                  " sparse matrix");
+        }
+        const auto major = L == Layout::rowMajor ? row : column;
+        const auto minor = L == Layout::rowMajor ? column : row;
+        const auto begin = indices_.cbegin() + offsets_[major];
+        const auto end = indices_.cbegin() + offsets_[major + 1];
+        const auto position = std::lower_bound(begin, end, minor);
+        return position != end && *position == minor ? values_[position - indices_.cbegin()]
+                                                     : dansandu::math::common::additiveIdentity<T>;
+    }
+
+    Matrix<T> toDense() const
+    {
+        auto dense = Matrix<T>{rows_, columns_, dansandu::math::common::additiveIdentity<T>};
+        for (auto major = 0; major < getMajorCount(); ++major)
+        {
+            for (auto position = offsets_[major]; position < offsets_[major + 1]; ++position)
+            {
+                auto& element = L == Layout::rowMajor ? dense.unsafeSubscript(major, indices_[position])
+                                                      : dense.unsafeSubscript(indices_[position], major);
+                element = values_[position];
+            }
+        }
+        return dense;
+    }
+
+private:
+    static auto validateDimension(size_type dimension)
+    {
+        if (dimension < 0)
+        {
+            THROW(std::out_of_range, "sparse matrix dimensions cannot be negative");
+        }
+        return dimension;
+    }
+
+    size_type getMajorCount() const
+    {
+        return L == Layout::rowMajor ? rows_ : columns_;
+    }
+
+    size_type getMinorCount() const
+    {
+        return L == Layout::rowMajor ? columns_ : rows_;
+    }
+
+    static auto getMajor(const Triplet<T>& triplet)
+    {
+        return L == Layout::rowMajor ? triplet.row : triplet.column;
+    }
+
+    static auto getMinor(const Triplet<T>& triplet)
+    {
+        return L == Layout::rowMajor ? triplet.column : triplet.row;
+    }
+
+    size_type rows_;
+    size_type columns_;
+    std::vector<std::size_t> offsets_;
+    std::vector<size_type> indices_;
+    std::vector<T> values_;
+};
+
+template<typename T>
+using CsrMatrix = SparseMatrix<T, Layout::rowMajor>;
+
+template<typename T>
+using CscMatrix = SparseMatrix<T, Layout::columnMajor>;
+
+// Returns the transpose, which copies the compressed arrays of the matrix and reads them in the other layout. Products
+// with the transpose need no copy, gemm takes Transposition::transposed for the sparse operand instead.
+template<typename T, Layout L>
+auto transposed(const SparseMatrix<T, L>& matrix)
+{
+    constexpr auto otherLayout = L == Layout::rowMajor ? Layout::columnMajor : Layout::rowMajor;
+    return SparseMatrix<T, otherLayout>{matrix.columnCount(), matrix.rowCount(), matrix.offsets(), matrix.indices(),
+                                        matrix.values()};
+}
+
+// Splits [0, count) into at most the given number of ranges with about the same number of stored elements each, so
+// that rows or columns of very different density are spread evenly over the threads.
+inline std::vector<size_type> balanceCompressedRanges(const std::vector<std::size_t>& offsets, int ranges)
+{
+    const auto count = static_cast<size_type>(offsets.size()) - 1;
+    const auto elements = offsets.back();
+    auto boundaries = std::vector<size_type>{0};
+    for (auto range = 1; range < ranges; ++range)
+    {
+        const auto target = elements / ranges * range + std::min<std::size_t>(elements % ranges, range);
+        const auto boundary =
+            static_cast<size_type>(std::lower_bound(offsets.cbegin(), offsets.cend(), target) - offsets.cbegin());
+        boundaries.push_back(std::clamp(boundary, boundaries.back(), count));
+    }
+    boundaries.push_back(count);
+    return boundaries;
+}
+
+template<typename T>
+void scaleSparseOutput(size_type firstRow, size_type lastRow, size_type columns, T beta, const MatrixView<T> c)
+{
+    if (beta == dansandu::math::common::multiplicativeIdentity<T>)
+    {
+        return;
+    }
+    for (auto i = firstRow; i < lastRow; ++i)
+    {
+        for (auto j = 0; j < columns; ++j)
+        {
+            auto& element = c.data()[i * c.rowStride() + j * c.columnStride()];
+            element = beta == dansandu::math::common::additiveIdentity<T> ? dansandu::math::common::additiveIdentity<T>
+                                                                           : beta * element;
+        }
+    }
+}
+
+// Adds scalar times row k of B to row i of C.
+template<typename T>
+void sparseAxpy(size_type columns, T scalar, const T* b, size_type bColumnStride, T* c, size_type cColumnStride)
+{
+    if (bColumnStride == 1 && cColumnStride == 1)
+    {
+        for (auto j = 0; j < columns; ++j)
+        {
+            c[j] += scalar * b[j];
+        }
+    }
+    else
+    {
+        for (auto j = 0; j < columns; ++j)
+        {
+            c[j * cColumnStride] += scalar * b[j * bColumnStride];
+        }
+    }
+}
+
+// Computes C = alpha * A * B + beta * C where the stored elements of A are compressed along the rows of C. Each thread
+// owns a range of rows of C, balanced by the number of stored elements, so no synchronization is needed.
+template<typename T>
+void unsafeCompressedRowsGemm(size_type columns, T alpha, const std::vector<std::size_t>& offsets,
+                              const std::vector<size_type>& indices, const std::vector<T>& values, const T* b,
+                              size_type bRowStride, size_type bColumnStride, T beta, const MatrixView<T> c,
+                              const dansandu::math::thread_pool::Executor& executor)
+{
+    const auto multiplyAdds = static_cast<long long>(offsets.back()) * columns;
+    const auto threads = multiplyAdds < sparseParallelThreshold ? 1 : executor.threadCount();
+    const auto boundaries = balanceCompressedRanges(offsets, 4 * threads);
+    const auto computeRange = [&](int range)
+    {
+        const auto firstRow = boundaries[range];
+        const auto lastRow = boundaries[range + 1];
+        scaleSparseOutput(firstRow, lastRow, columns, beta, c);
+        for (auto i = firstRow; i < lastRow; ++i)
+        {
+            const auto row = c.data() + i * c.rowStride();
+            for (auto position = offsets[i]; position < offsets[i + 1]; ++position)
+            {
+                sparseAxpy(columns, alpha * values[position], b + indices[position] * bRowStride, bColumnStride, row,
+                           c.columnStride());
+            }
+        }
+    };
+    if (threads == 1)
+    {
+        for (auto range = 0; range + 1 < static_cast<int>(boundaries.size()); ++range)
+        {
+            computeRange(range);
+        }
+    }
+    else
+    {
+        executor.parallelFor(static_cast<int>(boundaries.size()) - 1, computeRange);
+    }
+}
+
+// Computes C = alpha * A * B + beta * C where the stored elements of A are compressed along the rows of B, so each
+// stored element scatters into a different row of C. Threads own ranges of rows of C, balanced by the number of stored
+// elements that land in them, and find where their range starts in every compressed row of B by binary search since
+// the indices are sorted. The writes of the threads are disjoint, so no synchronization or private copies are needed.
+template<typename T>
+void unsafeCompressedColumnsGemm(size_type rows, size_type columns, T alpha, const std::vector<std::size_t>& offsets,
+                                 const std::vector<size_type>& indices, const std::vector<T>& values, const T* b,
+                                 size_type bRowStride, size_type bColumnStride, T beta, const MatrixView<T> c,
+                                 const dansandu::math::thread_pool::Executor& executor)
+{
+    const auto depth = static_cast<size_type>(offsets.size()) - 1;
+    const auto scatter = [&](size_type firstRow, size_type lastRow)
+    {
+        scaleSparseOutput(firstRow, lastRow, columns, beta, c);
+        for (auto k = 0; k < depth; ++k)
+        {
+            const auto row = b + k * bRowStride;
+            const auto begin = indices.cbegin() + offsets[k];
+            const auto end = indices.cbegin() + offsets[k + 1];
+            for (auto index = std::lower_bound(begin, end, firstRow); index != end && *index < lastRow; ++index)
+            {
+                sparseAxpy(columns, alpha * values[index - indices.cbegin()], row, bColumnStride,
+                           c.data() + *index * c.rowStride(), c.columnStride());
+            }
+        }
+    };
+
+    const auto multiplyAdds = static_cast<long long>(offsets.back()) * columns;
+    const auto threads = multiplyAdds < sparseParallelThreshold ? 1 : executor.threadCount();
+    if (threads == 1)
+    {
+        scatter(0, rows);
+        return;
+    }
+
+    auto rowOffsets = std::vector<std::size_t>(rows + 1, 0);
+    for (const auto index : indices)
+    {
+        ++rowOffsets[index + 1];
+    }
+    std::partial_sum(rowOffsets.cbegin(), rowOffsets.cend(), rowOffsets.begin());
+    const auto boundaries = balanceCompressedRanges(rowOffsets, threads);
+    executor.parallelFor(static_cast<int>(boundaries.size()) - 1,
+                         [&](int range) { scatter(boundaries[range], boundaries[range + 1]); });
+}
+
+// Computes c = alpha * op(a) * op(b) + beta * c for a sparse a and a dense b using the threads of the executor, in the
+// same way as the dense gemm. Transposing a is free since it only swaps the meaning of the compressed arrays. When beta
+// is zero the previous contents of c are ignored. The output must not overlap b.
+template<typename T, Layout L, size_type M, size_type N, DataStorageStrategy S>
+void gemm(std::common_type_t<T> alpha, const SparseMatrix<T, L>& a, Transposition transA,
+          const MatrixImplementation<T, M, N, S>& b, Transposition transB, std::common_type_t<T> beta,
+          const MatrixView<std::common_type_t<T>> c,
+          const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    const auto transposeA = transA == Transposition::transposed;
+    const auto transposeB = transB == Transposition::transposed;
+    const auto rows = transposeA ? a.columnCount() : a.rowCount();
+    const auto depth = transposeA ? a.rowCount() : a.columnCount();
+    const auto bRows = transposeB ? b.columnCount() : b.rowCount();
+    const auto columns = transposeB ? b.rowCount() : b.columnCount();
+    if (depth != bRows || c.rowCount() != rows || c.columnCount() != columns)
+    {
+        THROW(std::logic_error, "cannot multiply a ", rows, "x", depth, " sparse matrix with ", bRows, "x", columns,
+              " into a ", c.rowCount(), "x", c.columnCount(), " matrix -- matrix dimensions do not match");
+    }
+
+    const auto bRowStride = transposeB ? b.columnStride() : b.rowStride();
+    const auto bColumnStride = transposeB ? b.rowStride() : b.columnStride();
+    if ((L == Layout::rowMajor) != transposeA)
+    {
+        unsafeCompressedRowsGemm(columns, alpha, a.offsets(), a.indices(), a.values(), b.data(), bRowStride,
+                                 bColumnStride, beta, c, executor);
+    }
+    else
+    {
+        unsafeCompressedColumnsGemm(rows, columns, alpha, a.offsets(), a.indices(), a.values(), b.data(), bRowStride,
+                                    bColumnStride, beta, c, executor);
+    }
+}
+
+// Overwrites the output with the product of the sparse a and the dense b, which is a vector for the sparse matrix
+// vector product, using the threads of the executor. The output must not overlap b.
+template<typename T, Layout L, size_type M, size_type N, DataStorageStrategy S>
+void multiply(const SparseMatrix<T, L>& a, const MatrixImplementation<T, M, N, S>& b,
+              const MatrixView<std::common_type_t<T>> output,
+              const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    gemm(dansandu::math::common::multiplicativeIdentity<T>, a, Transposition::none, b, Transposition::none,
+         dansandu::math::common::additiveIdentity<T>, output, executor);
+}
+
+template<typename T, Layout L, size_type M, size_type N, DataStorageStrategy S>
+Matrix<T> operator*(const SparseMatrix<T, L>& a, const MatrixImplementation<T, M, N, S>& b)
+{
+    if (a.columnCount() != b.rowCount())
+    {
+        THROW(std::logic_error, "cannot multiply a ", a.rowCount(), "x", a.columnCount(), " sparse matrix with ",
+              b.rowCount(), "x", b.columnCount(), " -- matrix dimensions do not match");
+    }
+    auto result = Matrix<T>{a.rowCount(), b.columnCount(), uninitialized};
+    multiply(a, b, result);
+    return result;
+}
+
+}
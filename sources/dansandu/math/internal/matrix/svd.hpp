@@ -0,0 +1,353 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/matrix.hpp"
+#include "dansandu/math/internal/matrix/qr.hpp"
+#include "dansandu/math/internal/matrix/slicer.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dansandu::math::matrix
+{
+
+// The pairs of a Jacobi round are rotated on several threads once a round touches at least this many elements.
+constexpr auto svdParallelThreshold = 64 * 1024;
+
+// The Jacobi iteration gives up if the columns are not orthogonal after this many sweeps.
+constexpr auto svdMaximumSweeps = 60;
+
+enum class SvdMode
+{
+    full,
+    thin,
+    valuesOnly
+};
+
+// A = U * diag(values) * V' with the singular values in descending order as a column vector. For an m x n matrix
+// with k = min(m, n), U is m x m and V is n x n in full mode, U is m x k and V is n x k in thin mode, and both are
+// empty when only the values are computed.
+template<typename T>
+struct SingularValueDecomposition
+{
+    Matrix<T> u;
+    Matrix<T> values;
+    Matrix<T> v;
+};
+
+template<typename T>
+using SvdColumnMajorMatrix = Matrix<T, dynamic, dynamic, Layout::columnMajor>;
+
+// Rotates the columns of g until they are mutually orthogonal with the one-sided Jacobi method and applies the same
+// rotations to the columns of vectors when it is not empty. Both are expected in column-major layout so the rotations
+// and dot products run over contiguous elements. Pairs are visited in round-robin order, where every round is a set of
+// disjoint pairs, so the rotations of a round are independent and run on the executor threads.
+template<typename T>
+void orthogonalizeColumns(const MatrixView<T> g, const MatrixView<T> vectors,
+                          const dansandu::math::thread_pool::Executor& executor)
+{
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    const auto n = g.columnCount();
+    const auto rows = g.rowCount();
+    const auto tolerance = std::numeric_limits<T>::epsilon() * static_cast<T>(std::max(n, 1));
+    const auto players = n + n % 2;
+    const auto pairs = players / 2;
+    const auto rounds = std::max(players - 1, 0);
+    if (n < 2)
+    {
+        return;
+    }
+
+    const auto rotateColumns = [](const MatrixView<T> matrix, size_type p, size_type q, T c, T s)
+    {
+        const auto stride = matrix.rowStride();
+        const auto first = matrix.data() + p * matrix.columnStride();
+        const auto second = matrix.data() + q * matrix.columnStride();
+        for (auto i = 0; i < matrix.rowCount(); ++i)
+        {
+            const auto saved = first[i * stride];
+            first[i * stride] = c * saved - s * second[i * stride];
+            second[i * stride] = s * saved + c * second[i * stride];
+        }
+    };
+
+    auto schedule = std::vector<int>(players);
+    std::iota(schedule.begin(), schedule.end(), 0);
+    auto rotated = std::vector<char>(pairs);
+    const auto work = static_cast<long long>(pairs) * (rows + vectors.rowCount());
+    const auto parallel = work >= svdParallelThreshold && executor.threadCount() > 1;
+    for (auto sweep = 0;; ++sweep)
+    {
+        if (sweep == svdMaximumSweeps)
+        {
+            THROW(std::runtime_error, "the singular values of a matrix with ", n, " columns did not converge after ",
+                  svdMaximumSweeps, " sweeps");
+        }
+
+        auto anyRotated = false;
+        for (auto round = 0; round < rounds; ++round)
+        {
+            const auto rotatePair = [&](int pair)
+            {
+                rotated[pair] = 0;
+                const auto p = std::min(schedule[pair], schedule[players - 1 - pair]);
+                const auto q = std::max(schedule[pair], schedule[players - 1 - pair]);
+                if (q >= n)
+                {
+                    return;
+                }
+
+                const auto stride = g.rowStride();
+                const auto first = g.data() + p * g.columnStride();
+                const auto second = g.data() + q * g.columnStride();
+                auto alpha = zero;
+                auto beta = zero;
+                auto gamma = zero;
+                for (auto i = 0; i < rows; ++i)
+                {
+                    const auto x = first[i * stride];
+                    const auto y = second[i * stride];
+                    alpha += x * x;
+                    beta += y * y;
+                    gamma += x * y;
+                }
+                if (gamma == zero || std::abs(gamma) <= tolerance * std::sqrt(alpha * beta))
+                {
+                    return;
+                }
+
+                const auto zeta = (beta - alpha) / ((one + one) * gamma);
+                const auto t = std::copysign(one, zeta) / (std::abs(zeta) + std::sqrt(one + zeta * zeta));
+                const auto c = one / std::sqrt(one + t * t);
+                const auto s = c * t;
+                rotateColumns(g, p, q, c, s);
+                if (vectors.columnCount() > 0)
+                {
+                    rotateColumns(vectors, p, q, c, s);
+                }
+                rotated[pair] = 1;
+            };
+
+            if (parallel)
+            {
+                executor.parallelFor(pairs, rotatePair);
+            }
+            else
+            {
+                for (auto pair = 0; pair < pairs; ++pair)
+                {
+                    rotatePair(pair);
+                }
+            }
+            anyRotated = anyRotated || std::find(rotated.cbegin(), rotated.cend(), 1) != rotated.cend();
+
+            std::rotate(schedule.begin() + 1, schedule.end() - 1, schedule.end());
+        }
+
+        if (!anyRotated)
+        {
+            return;
+        }
+    }
+}
+
+// Replaces the zero columns of the orthonormal set with unit vectors orthogonalized against all the other columns.
+// Each one starts from the unit vector e_i farthest from the span of the accepted columns, whose squared distance is
+// 1 minus the sum of their squared i-th elements. The largest distance is at least the square root of the fraction of
+// free directions, so a null vector spread over every coordinate, e.g. ones / sqrt(n), is recovered as well.
+template<typename T>
+void completeOrthonormalColumns(const MatrixView<T> u, const std::vector<bool>& missing)
+{
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    const auto n = u.rowCount();
+    const auto accepted = [&missing](size_type other, size_type column)
+    { return other != column && (!missing[other] || other < column); };
+    for (auto column = 0; column < u.columnCount(); ++column)
+    {
+        if (!missing[column])
+        {
+            continue;
+        }
+
+        auto candidate = 0;
+        auto largest = -one;
+        for (auto i = 0; i < n; ++i)
+        {
+            auto residual = one;
+            for (auto other = 0; other < u.columnCount(); ++other)
+            {
+                if (accepted(other, column))
+                {
+                    residual -= u.unsafeSubscript(i, other) * u.unsafeSubscript(i, other);
+                }
+            }
+            if (residual > largest)
+            {
+                largest = residual;
+                candidate = i;
+            }
+        }
+
+        for (auto i = 0; i < n; ++i)
+        {
+            u.unsafeSubscript(i, column) = i == candidate ? one : zero;
+        }
+        for (auto pass = 0; pass < 2; ++pass)
+        {
+            for (auto other = 0; other < u.columnCount(); ++other)
+            {
+                if (!accepted(other, column))
+                {
+                    continue;
+                }
+                auto dot = zero;
+                for (auto i = 0; i < n; ++i)
+                {
+                    dot += u.unsafeSubscript(i, other) * u.unsafeSubscript(i, column);
+                }
+                for (auto i = 0; i < n; ++i)
+                {
+                    u.unsafeSubscript(i, column) -= dot * u.unsafeSubscript(i, other);
+                }
+            }
+        }
+        auto norm = zero;
+        for (auto i = 0; i < n; ++i)
+        {
+            norm += u.unsafeSubscript(i, column) * u.unsafeSubscript(i, column);
+        }
+        norm = std::sqrt(norm);
+        if (!(norm > std::sqrt(std::numeric_limits<T>::epsilon())))
+        {
+            THROW(std::runtime_error, "cannot complete column ", column, " of the ", n, "x", u.columnCount(),
+                  " orthonormal set -- the other columns already span every direction");
+        }
+        for (auto i = 0; i < n; ++i)
+        {
+            u.unsafeSubscript(i, column) /= norm;
+        }
+    }
+}
+
+// Computes the decomposition of a matrix with at least as many rows as columns. A is first reduced to its square
+// triangular factor with blocked QR, which is where a tall-skinny input spends its time on gemm, and the singular
+// values and right vectors of R are found by one-sided Jacobi on the columns of R. U is then Q times the left vectors
+// of R, applied with the same block reflectors.
+template<typename T>
+SingularValueDecomposition<T> singularValueDecomposeTall(const ConstantMatrixView<T> a, SvdMode mode,
+                                                         const dansandu::math::thread_pool::Executor& executor)
+{
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    const auto m = a.rowCount();
+    const auto n = a.columnCount();
+    const auto qr = qrDecompose(a, Pivoting::none, executor);
+    auto g = SvdColumnMajorMatrix<T>{n, n, zero};
+    for (auto j = 0; j < n; ++j)
+    {
+        for (auto i = 0; i <= j; ++i)
+        {
+            g.unsafeSubscript(i, j) = qr.factors.unsafeSubscript(i, j);
+        }
+    }
+    auto vectors = SvdColumnMajorMatrix<T>{};
+    if (mode != SvdMode::valuesOnly)
+    {
+        vectors = SvdColumnMajorMatrix<T>{n, n, zero};
+        for (auto i = 0; i < n; ++i)
+        {
+            vectors.unsafeSubscript(i, i) = dansandu::math::common::multiplicativeIdentity<T>;
+        }
+    }
+    orthogonalizeColumns<T>(g, vectors, executor);
+
+    auto norms = std::vector<T>(n);
+    for (auto j = 0; j < n; ++j)
+    {
+        auto sum = zero;
+        for (auto i = 0; i < n; ++i)
+        {
+            sum += g.unsafeSubscript(i, j) * g.unsafeSubscript(i, j);
+        }
+        norms[j] = std::sqrt(sum);
+    }
+    auto order = std::vector<int>(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int left, int right) { return norms[left] > norms[right]; });
+
+    auto result = SingularValueDecomposition<T>{};
+    result.values = Matrix<T>{n, 1, uninitialized};
+    for (auto j = 0; j < n; ++j)
+    {
+        result.values.unsafeSubscript(j, 0) = norms[order[j]];
+    }
+    if (mode == SvdMode::valuesOnly)
+    {
+        return result;
+    }
+
+    const auto threshold = n > 0 ? norms[order[0]] * std::numeric_limits<T>::epsilon() * static_cast<T>(m) : zero;
+    const auto columns = mode == SvdMode::full ? m : n;
+    result.u = Matrix<T>{m, columns, zero};
+    result.v = Matrix<T>{n, n, uninitialized};
+    auto missing = std::vector<bool>(n, false);
+    for (auto j = 0; j < n; ++j)
+    {
+        const auto source = order[j];
+        missing[j] = !(norms[source] > threshold);
+        for (auto i = 0; i < n; ++i)
+        {
+            result.u.unsafeSubscript(i, j) = missing[j] ? zero : g.unsafeSubscript(i, source) / norms[source];
+            result.v.unsafeSubscript(i, j) = vectors.unsafeSubscript(i, source);
+        }
+    }
+    completeOrthonormalColumns<T>(unsafeSlice(result.u, 0, 0, n, n), missing);
+    for (auto j = n; j < columns; ++j)
+    {
+        result.u.unsafeSubscript(j, j) = dansandu::math::common::multiplicativeIdentity<T>;
+    }
+    applyQ(qr, Transposition::none, result.u, executor);
+    return result;
+}
+
+// Returns the singular value decomposition of any m x n matrix in full, thin or values-only mode. Wide matrices are
+// decomposed through their transpose.
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+SingularValueDecomposition<T> singularValueDecompose(const MatrixImplementation<T, M, N, S>& a,
+                                                     SvdMode mode = SvdMode::thin,
+                                                     const dansandu::math::thread_pool::Executor& executor =
+                                                         dansandu::math::thread_pool::Executor{})
+{
+    static_assert(std::is_floating_point_v<T>, "singular value decomposition requires floating point matrices");
+
+    if (a.rowCount() >= a.columnCount())
+    {
+        return singularValueDecomposeTall<T>(a, mode, executor);
+    }
+
+    auto result = singularValueDecomposeTall<T>(
+        ConstantMatrixView<T>{a.columnCount(), a.rowCount(), a.columnStride(), a.rowStride(), a.data()}, mode,
+        executor);
+    std::swap(result.u, result.v);
+    return result;
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+Matrix<T> singularValues(const MatrixImplementation<T, M, N, S>& a,
+                         const dansandu::math::thread_pool::Executor& executor =
+                             dansandu::math::thread_pool::Executor{})
+{
+    return singularValueDecompose(a, SvdMode::valuesOnly, executor).values;
+}
+
+}
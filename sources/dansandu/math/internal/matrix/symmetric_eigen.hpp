@@ -0,0 +1,327 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/matrix.hpp"
+#include "dansandu/math/internal/matrix/qr.hpp"
+#include "dansandu/math/internal/matrix/slicer.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dansandu::math::matrix
+{
+
+// Row passes over the trailing matrix and rotation sweeps over the eigenvectors are split into ranges of at least this
+// many elements to run on several threads.
+constexpr auto eigenParallelThreshold = 64 * 1024;
+
+// The implicit QL iteration gives up if an eigenvalue takes more than this many sweeps to converge.
+constexpr auto eigenMaximumSweeps = 30;
+
+// Eigenvalues in ascending order as a column vector and the matching orthonormal eigenvectors as the columns of
+// vectors.
+template<typename T>
+struct SymmetricEigenDecomposition
+{
+    Matrix<T> values;
+    Matrix<T> vectors;
+};
+
+// Runs body over [0, count) split into ranges with at least eigenParallelThreshold / work elements each.
+template<typename Body>
+void eigenParallelRanges(size_type count, long long work, const dansandu::math::thread_pool::Executor& executor,
+                         Body&& body)
+{
+    const auto ranges = static_cast<int>(std::min<long long>(
+        {static_cast<long long>(executor.threadCount()), std::max(work / eigenParallelThreshold, 1LL),
+         std::max<long long>(count, 1LL)}));
+    if (ranges == 1)
+    {
+        body(0, count);
+    }
+    else
+    {
+        executor.parallelFor(ranges,
+                             [&](int range)
+                             {
+                                 body(static_cast<size_type>(static_cast<long long>(count) * range / ranges),
+                                      static_cast<size_type>(static_cast<long long>(count) * (range + 1) / ranges));
+                             });
+    }
+}
+
+// Reduces the symmetric matrix to tridiagonal form Q' * A * Q = T with one Householder reflector per column, where
+// reflector k is stored below the subdiagonal of column k the same way QR stores reflector k - 1 of the matrix without
+// its first row. The matrix is kept fully symmetric so that the matrix-vector product and the rank-2 update of each
+// step read whole rows, which are split across the executor threads.
+template<typename T>
+void tridiagonalize(const MatrixView<T> a, std::vector<T>& diagonal, std::vector<T>& subdiagonal, std::vector<T>& tau,
+                    const dansandu::math::thread_pool::Executor& executor)
+{
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    const auto n = a.rowCount();
+    const auto reflectors = unsafeSlice(a, 1, 0, n - 1, n - 1);
+    auto p = std::vector<T>(n);
+    for (auto k = 0; k < n - 1; ++k)
+    {
+        tau[k] = generateReflector(reflectors, k);
+        subdiagonal[k] = a.unsafeSubscript(k + 1, k);
+        if (tau[k] != zero)
+        {
+            const auto first = k + 1;
+            const auto length = n - first;
+            const auto getV = [&](size_type i) { return i == first ? one : a.unsafeSubscript(i, k); };
+
+            eigenParallelRanges(length, static_cast<long long>(length) * length, executor,
+                                [&](size_type begin, size_type end)
+                                {
+                                    for (auto i = first + begin; i < first + end; ++i)
+                                    {
+                                        auto sum = a.unsafeSubscript(i, first);
+                                        for (auto j = first + 1; j < n; ++j)
+                                        {
+                                            sum += a.unsafeSubscript(i, j) * a.unsafeSubscript(j, k);
+                                        }
+                                        p[i] = tau[k] * sum;
+                                    }
+                                });
+
+            auto projection = zero;
+            for (auto i = first; i < n; ++i)
+            {
+                projection += p[i] * getV(i);
+            }
+            const auto alpha = -tau[k] * projection / (one + one);
+            for (auto i = first; i < n; ++i)
+            {
+                p[i] += alpha * getV(i);
+            }
+
+            eigenParallelRanges(length, static_cast<long long>(length) * length, executor,
+                                [&](size_type begin, size_type end)
+                                {
+                                    for (auto i = first + begin; i < first + end; ++i)
+                                    {
+                                        const auto vi = getV(i);
+                                        const auto wi = p[i];
+                                        a.unsafeSubscript(i, first) -= vi * p[first] + wi;
+                                        for (auto j = first + 1; j < n; ++j)
+                                        {
+                                            a.unsafeSubscript(i, j) -= vi * p[j] + wi * a.unsafeSubscript(j, k);
+                                        }
+                                    }
+                                });
+        }
+        diagonal[k] = a.unsafeSubscript(k, k);
+    }
+    diagonal[n - 1] = a.unsafeSubscript(n - 1, n - 1);
+}
+
+// Finds the eigenvalues of the symmetric tridiagonal matrix in place with the implicit QL algorithm and Wilkinson
+// shifts, where subdiagonal[i] couples rows i and i + 1. When rows is not empty, every sweep of plane rotations is
+// also applied to its rows, so that row j ends up holding eigenvector j; each sweep is recorded first and then played
+// back over column ranges on the executor threads.
+template<typename T>
+void solveTridiagonalEigenproblem(std::vector<T>& diagonal, std::vector<T>& subdiagonal, const MatrixView<T> rows,
+                                  const dansandu::math::thread_pool::Executor& executor)
+{
+    const auto zero = dansandu::math::common::additiveIdentity<T>;
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    const auto n = static_cast<size_type>(diagonal.size());
+    const auto epsilon = std::numeric_limits<T>::epsilon();
+    auto rotations = std::vector<std::pair<T, T>>{};
+    for (auto l = 0; l < n; ++l)
+    {
+        auto sweeps = 0;
+        auto m = l;
+        do
+        {
+            for (m = l; m < n - 1; ++m)
+            {
+                if (std::abs(subdiagonal[m]) <= epsilon * (std::abs(diagonal[m]) + std::abs(diagonal[m + 1])))
+                {
+                    break;
+                }
+            }
+            if (m == l)
+            {
+                break;
+            }
+            if (++sweeps > eigenMaximumSweeps)
+            {
+                THROW(std::runtime_error, "eigenvalue ", l, " of a ", n, "x", n,
+                      " symmetric matrix did not converge after ", eigenMaximumSweeps, " sweeps");
+            }
+
+            auto g = (diagonal[l + 1] - diagonal[l]) / ((one + one) * subdiagonal[l]);
+            auto r = std::hypot(g, one);
+            g = diagonal[m] - diagonal[l] + subdiagonal[l] / (g + std::copysign(r, g));
+            auto s = one;
+            auto c = one;
+            auto p = zero;
+            auto i = m - 1;
+            rotations.clear();
+            for (; i >= l; --i)
+            {
+                const auto f = s * subdiagonal[i];
+                const auto b = c * subdiagonal[i];
+                r = std::hypot(f, g);
+                subdiagonal[i + 1] = r;
+                if (r == zero)
+                {
+                    diagonal[i + 1] -= p;
+                    subdiagonal[m] = zero;
+                    break;
+                }
+                s = f / r;
+                c = g / r;
+                g = diagonal[i + 1] - p;
+                r = (diagonal[i] - g) * s + (one + one) * c * b;
+                p = s * r;
+                diagonal[i + 1] = g + p;
+                g = c * r - b;
+                rotations.push_back({c, s});
+            }
+
+            if (rows.rowCount() > 0 && !rotations.empty())
+            {
+                const auto columns = rows.columnCount();
+                eigenParallelRanges(columns, static_cast<long long>(columns) * static_cast<long long>(rotations.size()),
+                                    executor,
+                                    [&](size_type begin, size_type end)
+                                    {
+                                        auto row = m - 1;
+                                        for (const auto& [cosine, sine] : rotations)
+                                        {
+                                            for (auto j = begin; j < end; ++j)
+                                            {
+                                                auto& upper = rows.unsafeSubscript(row, j);
+                                                auto& lower = rows.unsafeSubscript(row + 1, j);
+                                                const auto saved = lower;
+                                                lower = sine * upper + cosine * saved;
+                                                upper = cosine * upper - sine * saved;
+                                            }
+                                            --row;
+                                        }
+                                    });
+            }
+
+            if (r == zero && i >= l)
+            {
+                continue;
+            }
+            diagonal[l] -= p;
+            subdiagonal[l] = g;
+            subdiagonal[m] = zero;
+        } while (m != l);
+    }
+}
+
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+Matrix<T> getSymmetricCopy(const MatrixImplementation<T, M, N, S>& a)
+{
+    static_assert(std::is_floating_point_v<T>, "symmetric eigensolvers require floating point matrices");
+
+    if (a.rowCount() != a.columnCount())
+    {
+        THROW(std::logic_error, "cannot find the eigenvalues of a ", a.rowCount(), "x", a.columnCount(),
+              " matrix -- the matrix must be square");
+    }
+
+    auto copy = Matrix<T>{a};
+    for (auto i = 0; i < copy.rowCount(); ++i)
+    {
+        for (auto j = i + 1; j < copy.columnCount(); ++j)
+        {
+            copy.unsafeSubscript(i, j) = copy.unsafeSubscript(j, i);
+        }
+    }
+    return copy;
+}
+
+// Returns the eigenvalues of the symmetric matrix in ascending order as a column vector. Only the lower triangle is
+// read. The eigenvectors are never formed, so after the tridiagonal reduction the rest of the work is quadratic.
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+Matrix<T> symmetricEigenvalues(const MatrixImplementation<T, M, N, S>& a,
+                               const dansandu::math::thread_pool::Executor& executor =
+                                   dansandu::math::thread_pool::Executor{})
+{
+    auto copy = getSymmetricCopy(a);
+    const auto n = copy.rowCount();
+    auto diagonal = std::vector<T>(n);
+    auto subdiagonal = std::vector<T>(n);
+    auto tau = std::vector<T>(std::max(n - 1, 0));
+    if (n > 0)
+    {
+        tridiagonalize<T>(copy, diagonal, subdiagonal, tau, executor);
+    }
+    solveTridiagonalEigenproblem<T>(diagonal, subdiagonal, MatrixView<T>{0, 0, 0, 0, nullptr}, executor);
+    std::sort(diagonal.begin(), diagonal.end());
+
+    auto values = Matrix<T>{n, 1, uninitialized};
+    std::copy(diagonal.cbegin(), diagonal.cend(), values.begin());
+    return values;
+}
+
+// Returns the eigenvalues of the symmetric matrix in ascending order together with its orthonormal eigenvectors. Only
+// the lower triangle is read. The eigenvectors of the tridiagonal matrix are multiplied by Q with blocked Householder
+// updates, so the back-transformation runs on gemm and all the executor threads.
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+SymmetricEigenDecomposition<T> symmetricEigenDecompose(const MatrixImplementation<T, M, N, S>& a,
+                                                       const dansandu::math::thread_pool::Executor& executor =
+                                                           dansandu::math::thread_pool::Executor{})
+{
+    auto copy = getSymmetricCopy(a);
+    const auto n = copy.rowCount();
+    auto diagonal = std::vector<T>(n);
+    auto subdiagonal = std::vector<T>(n);
+    auto tau = std::vector<T>(std::max(n - 1, 0));
+    if (n > 0)
+    {
+        tridiagonalize<T>(copy, diagonal, subdiagonal, tau, executor);
+    }
+
+    auto tridiagonalVectors = identity<T>(n);
+    solveTridiagonalEigenproblem<T>(diagonal, subdiagonal, tridiagonalVectors, executor);
+
+    auto order = std::vector<int>(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int left, int right) { return diagonal[left] < diagonal[right]; });
+
+    auto values = Matrix<T>{n, 1, uninitialized};
+    auto vectors = Matrix<T>{n, n, uninitialized};
+    for (auto j = 0; j < n; ++j)
+    {
+        values.unsafeSubscript(j, 0) = diagonal[order[j]];
+        for (auto i = 0; i < n; ++i)
+        {
+            vectors.unsafeSubscript(i, j) = tridiagonalVectors.unsafeSubscript(order[j], i);
+        }
+    }
+
+    if (n > 1)
+    {
+        const auto reflectors = unsafeSlice(copy, 1, 0, n - 1, n - 1);
+        const auto count = n - 1;
+        const auto blocks = (count + qrBlock - 1) / qrBlock;
+        for (auto block = blocks - 1; block >= 0; --block)
+        {
+            const auto k = block * qrBlock;
+            const auto width = std::min(qrBlock, count - k);
+            applyBlockReflector<T>(reflectors, tau, k, width, Transposition::none,
+                                   unsafeSlice(vectors, 1 + k, 0, count - k, n), executor);
+        }
+    }
+    return {std::move(values), std::move(vectors)};
+}
+
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/kernels.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace dansandu::math::matrix
+{
+
+// Transposes go through square blocks of this size so that the rows read from the source and the rows written to the
+// destination both stay in the L1 cache instead of striding through a new page for every element.
+constexpr auto transposeBlockSize = 32;
+
+// Writes the transpose of the rows x columns matrix A into the row-major C with the given row stride. The micro tiles
+// of a row-major A are exchanged inside the registers and the remainders are moved one element at a time.
+template<typename T>
+void unsafeTranspose(size_type rows, size_type columns, const T* a, size_type aRowStride, size_type aColumnStride,
+                     T* c, size_type cRowStride)
+{
+    if (aRowStride == 1 && aColumnStride != 1)
+    {
+        // A is itself a transposed view, so the rows of C are the contiguous columns of A.
+        for (auto j = 0; j < columns; ++j)
+        {
+            std::copy(a + j * aColumnStride, a + j * aColumnStride + rows, c + j * cRowStride);
+        }
+        return;
+    }
+
+    const auto& kernels = getKernels<T>();
+    const auto micro = kernels.transposeSize;
+    for (auto blockRow = 0; blockRow < rows; blockRow += transposeBlockSize)
+    {
+        const auto blockRowEnd = std::min(rows, blockRow + transposeBlockSize);
+        for (auto blockColumn = 0; blockColumn < columns; blockColumn += transposeBlockSize)
+        {
+            const auto blockColumnEnd = std::min(columns, blockColumn + transposeBlockSize);
+            auto i = blockRow;
+            if (aColumnStride == 1)
+            {
+                for (; i + micro <= blockRowEnd; i += micro)
+                {
+                    auto j = blockColumn;
+                    for (; j + micro <= blockColumnEnd; j += micro)
+                    {
+                        kernels.transposeMicroKernel(a + i * aRowStride + j, aRowStride, c + j * cRowStride + i,
+                                                     cRowStride);
+                    }
+                    for (; j < blockColumnEnd; ++j)
+                    {
+                        for (auto k = i; k < i + micro; ++k)
+                        {
+                            c[j * cRowStride + k] = a[k * aRowStride + j];
+                        }
+                    }
+                }
+            }
+            for (; i < blockRowEnd; ++i)
+            {
+                for (auto j = blockColumn; j < blockColumnEnd; ++j)
+                {
+                    c[j * cRowStride + i] = a[i * aRowStride + j * aColumnStride];
+                }
+            }
+        }
+    }
+}
+
+// Transposes the n x n matrix A in place by exchanging the blocks above the diagonal with the ones below it.
+template<typename T>
+void unsafeTransposeSquareInPlace(size_type n, T* a, size_type rowStride, size_type columnStride)
+{
+    if (rowStride == 1)
+    {
+        // Transposing the column-major matrix is the same exchange as transposing its row-major transpose.
+        std::swap(rowStride, columnStride);
+    }
+
+    const auto& kernels = getKernels<T>();
+    const auto micro = kernels.transposeSize;
+    const auto tiled = columnStride == 1 ? n - n % micro : 0;
+    if (tiled > 0)
+    {
+        auto buffer = std::vector<T>(micro * micro);
+        for (auto blockRow = 0; blockRow < tiled; blockRow += transposeBlockSize)
+        {
+            const auto blockRowEnd = std::min(tiled, blockRow + transposeBlockSize);
+            for (auto blockColumn = blockRow; blockColumn < tiled; blockColumn += transposeBlockSize)
+            {
+                const auto blockColumnEnd = std::min(tiled, blockColumn + transposeBlockSize);
+                for (auto i = blockRow; i < blockRowEnd; i += micro)
+                {
+                    for (auto j = std::max(i, blockColumn); j < blockColumnEnd; j += micro)
+                    {
+                        const auto upper = a + i * rowStride + j;
+                        const auto lower = a + j * rowStride + i;
+                        kernels.transposeMicroKernel(upper, rowStride, buffer.data(), micro);
+                        if (i != j)
+                        {
+                            kernels.transposeMicroKernel(lower, rowStride, upper, rowStride);
+                        }
+                        for (auto k = 0; k < micro; ++k)
+                        {
+                            std::copy(buffer.begin() + k * micro, buffer.begin() + (k + 1) * micro,
+                                      lower + k * rowStride);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // The pairs of elements left out of the micro tiles are exchanged one by one.
+    for (auto blockRow = 0; blockRow < n; blockRow += transposeBlockSize)
+    {
+        const auto blockRowEnd = std::min(n, blockRow + transposeBlockSize);
+        for (auto blockColumn = std::max(blockRow, tiled - tiled % transposeBlockSize); blockColumn < n;
+             blockColumn += transposeBlockSize)
+        {
+            const auto blockColumnEnd = std::min(n, blockColumn + transposeBlockSize);
+            for (auto i = blockRow; i < blockRowEnd; ++i)
+            {
+                for (auto j = std::max({i + 1, blockColumn, tiled}); j < blockColumnEnd; ++j)
+                {
+                    std::swap(a[i * rowStride + j * columnStride], a[j * rowStride + i * columnStride]);
+                }
+            }
+        }
+    }
+}
+
+// Transposes the contiguous row-major rows x columns matrix A in place by following the cycles of the permutation
+// that sends the element at index k to k * rows modulo rows * columns - 1. Only a bit per element is kept aside to
+// mark the visited positions instead of a second copy of the matrix.
+template<typename T>
+void unsafeTransposeInPlace(size_type rows, size_type columns, T* a)
+{
+    const auto last = static_cast<long long>(rows) * columns - 1;
+    if (rows <= 1 || columns <= 1)
+    {
+        return;
+    }
+
+    auto visited = std::vector<bool>(last);
+    for (auto start = 1LL; start < last; ++start)
+    {
+        if (visited[start])
+        {
+            continue;
+        }
+        auto value = std::move(a[start]);
+        auto index = start;
+        do
+        {
+            index = index * rows % last;
+            std::swap(a[index], value);
+            visited[index] = true;
+        } while (index != start);
+    }
+}
+
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "dansandu/ballotin/exception.hpp"
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+#include "dansandu/math/internal/matrix/matrix.hpp"
+#include "dansandu/math/internal/matrix/slicer.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace dansandu::math::matrix
+{
+
+// Diagonal blocks of this size are solved by substitution and the rest of the solve is left to gemm.
+constexpr auto trsmBlock = 64;
+
+// Right-hand sides are split into column ranges of at least this width to substitute them on several threads.
+constexpr auto trsmParallelColumns = 64;
+
+// Solves the triangular system a * x = b by substitution and overwrites b with x, where a is small enough to be a
+// diagonal block. The columns of b are independent, so ranges of them are solved on separate threads.
+template<typename T>
+void unsafeTriangularSubstitution(Triangle triangle, Diagonal diagonal, const ConstantMatrixView<T> a,
+                                  const MatrixView<T> b, const dansandu::math::thread_pool::Executor& executor)
+{
+    const auto n = a.rowCount();
+    const auto columns = b.columnCount();
+    const auto solveColumns = [&](size_type firstColumn, size_type lastColumn)
+    {
+        const auto width = lastColumn - firstColumn;
+        for (auto step = 0; step < n; ++step)
+        {
+            const auto i = triangle == Triangle::lower ? step : n - 1 - step;
+            const auto row = b.data() + i * b.rowStride() + firstColumn * b.columnStride();
+            const auto begin = triangle == Triangle::lower ? 0 : i + 1;
+            const auto end = triangle == Triangle::lower ? i : n;
+            for (auto p = begin; p < end; ++p)
+            {
+                const auto factor = a.unsafeSubscript(i, p);
+                const auto solved = b.data() + p * b.rowStride() + firstColumn * b.columnStride();
+                for (auto j = 0; j < width; ++j)
+                {
+                    row[j * b.columnStride()] -= factor * solved[j * b.columnStride()];
+                }
+            }
+            if (diagonal == Diagonal::nonUnit)
+            {
+                const auto pivot = a.unsafeSubscript(i, i);
+                for (auto j = 0; j < width; ++j)
+                {
+                    row[j * b.columnStride()] /= pivot;
+                }
+            }
+        }
+    };
+
+    const auto ranges = std::min(executor.threadCount(), std::max(columns / trsmParallelColumns, 1));
+    if (ranges == 1)
+    {
+        solveColumns(0, columns);
+    }
+    else
+    {
+        executor.parallelFor(ranges,
+                             [&](int range)
+                             {
+                                 solveColumns(static_cast<size_type>(static_cast<long long>(columns) * range / ranges),
+                                              static_cast<size_type>(static_cast<long long>(columns) * (range + 1) /
+                                                                     ranges));
+                             });
+    }
+}
+
+// Solves a * x = b for a triangular a and overwrites b with x. The diagonal blocks of a are solved by substitution and
+// each solved block row of x is eliminated from the rows still to be solved with gemm, so most of the work runs on the
+// packed kernels and all the executor threads.
+template<typename T>
+void unsafeTrsm(Triangle triangle, Diagonal diagonal, const ConstantMatrixView<T> a, const MatrixView<T> b,
+                const dansandu::math::thread_pool::Executor& executor)
+{
+    const auto n = a.rowCount();
+    const auto columns = b.columnCount();
+    const auto one = dansandu::math::common::multiplicativeIdentity<T>;
+    for (auto step = 0; step < n; step += trsmBlock)
+    {
+        const auto blockRows = std::min(trsmBlock, n - step);
+        const auto k = triangle == Triangle::lower ? step : n - step - blockRows;
+        const auto solved = unsafeSlice(b, k, 0, blockRows, columns);
+        unsafeTriangularSubstitution(triangle, diagonal, unsafeSlice(a, k, k, blockRows, blockRows), solved, executor);
+
+        const auto remainingBegin = triangle == Triangle::lower ? k + blockRows : 0;
+        const auto remainingRows = triangle == Triangle::lower ? n - k - blockRows : k;
+        if (remainingRows > 0)
+        {
+            gemm(-one, unsafeSlice(a, remainingBegin, k, remainingRows, blockRows), Transposition::none, solved,
+                 Transposition::none, one, unsafeSlice(b, remainingBegin, 0, remainingRows, columns), executor);
+        }
+    }
+}
+
+// Solves op(a) * x = alpha * b when side is left or x * op(a) = alpha * b when side is right, where a is lower or upper
+// triangular, and overwrites b with x. Only the selected triangle of a is read, and its diagonal is not read at all
+// for Diagonal::unit. Transposed operands are solved in place through their strides.
+template<typename T, size_type M, size_type N, DataStorageStrategy S>
+void trsm(Side side, Triangle triangle, Transposition transA, Diagonal diagonal, std::common_type_t<T> alpha,
+          const MatrixImplementation<T, M, N, S>& a, const MatrixView<std::common_type_t<T>> b,
+          const dansandu::math::thread_pool::Executor& executor = dansandu::math::thread_pool::Executor{})
+{
+    static_assert(std::is_floating_point_v<T>, "triangular solves require floating point matrices");
+
+    const auto n = a.rowCount();
+    const auto bDimension = side == Side::left ? b.rowCount() : b.columnCount();
+    if (a.columnCount() != n || bDimension != n)
+    {
+        THROW(std::logic_error, "cannot solve a ", a.rowCount(), "x", a.columnCount(), " triangular system for a ",
+              b.rowCount(), "x", b.columnCount(), " right-hand side -- the system must be square and match the ",
+              side == Side::left ? "rows" : "columns", " of the right-hand side");
+    }
+
+    if (alpha == dansandu::math::common::additiveIdentity<T>)
+    {
+        std::fill(b.begin(), b.end(), dansandu::math::common::additiveIdentity<T>);
+        return;
+    }
+    if (alpha != dansandu::math::common::multiplicativeIdentity<T>)
+    {
+        std::transform(b.begin(), b.end(), b.begin(), dansandu::math::common::MultiplyBy<T>{alpha});
+    }
+
+    // x * op(a) = b is solved as op(a)' * x' = b', and every transposition swaps the strides and the triangle.
+    const auto transposeA = (transA == Transposition::transposed) != (side == Side::right);
+    const auto solvedTriangle = transposeA == (triangle == Triangle::lower) ? Triangle::upper : Triangle::lower;
+    const auto operand = transposeA ? ConstantMatrixView<T>{n, n, a.columnStride(), a.rowStride(), a.data()}
+                                    : ConstantMatrixView<T>{n, n, a.rowStride(), a.columnStride(), a.data()};
+    const auto rightHandSide = side == Side::left
+                                   ? b
+                                   : MatrixView<T>{b.columnCount(), b.rowCount(), b.columnStride(), b.rowStride(),
+                                                   b.data()};
+    unsafeTrsm(solvedTriangle, diagonal, operand, rightHandSide, executor);
+}
+
+}
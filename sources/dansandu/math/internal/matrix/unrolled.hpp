@@ -0,0 +1,175 @@
+#pragma once
+
+#include "dansandu/math/common.hpp"
+#include "dansandu/math/internal/matrix/common.hpp"
+
+#include <cstddef>
+#include <utility>
+
+namespace dansandu::math::matrix
+{
+
+// Matrices with static dimensions and at most this many elements are handled by fully unrolled code.
+constexpr auto unrolledElementLimit = 16;
+
+constexpr auto isUnrolled(size_type m, size_type n)
+{
+    return m != dynamic && n != dynamic && m * n <= unrolledElementLimit;
+}
+
+template<typename T, std::size_t... K>
+constexpr T unrolledDotProduct(const T* a, size_type aStride, const T* b, size_type bStride, std::index_sequence<K...>)
+{
+    return (dansandu::math::common::additiveIdentity<T> + ... + (a[K * aStride] * b[K * bStride]));
+}
+
+template<size_type N, size_type P, typename T, std::size_t... I>
+constexpr void unrolledMultiply(const T* a, size_type aRowStride, size_type aColumnStride, const T* b,
+                                size_type bRowStride, size_type bColumnStride, T* c, std::index_sequence<I...>)
+{
+    ((c[I] = unrolledDotProduct(a + I / P * aRowStride, aColumnStride, b + I % P * bColumnStride, bRowStride,
+                                std::make_index_sequence<N>{})),
+     ...);
+}
+
+// Computes the M x P product of A and B into the contiguous C.
+template<size_type M, size_type N, size_type P, typename T>
+constexpr void unrolledMultiply(const T* a, size_type aRowStride, size_type aColumnStride, const T* b,
+                                size_type bRowStride, size_type bColumnStride, T* c)
+{
+    unrolledMultiply<N, P>(a, aRowStride, aColumnStride, b, bRowStride, bColumnStride, c,
+                           std::make_index_sequence<M * P>{});
+}
+
+template<size_type M, size_type N, typename T, std::size_t... I>
+constexpr void unrolledTranspose(const T* a, size_type aRowStride, size_type aColumnStride, T* c,
+                                 std::index_sequence<I...>)
+{
+    ((c[I] = a[I % M * aRowStride + I / M * aColumnStride]), ...);
+}
+
+// Writes the transpose of the M x N matrix A into the contiguous N x M matrix C.
+template<size_type M, size_type N, typename T>
+constexpr void unrolledTranspose(const T* a, size_type aRowStride, size_type aColumnStride, T* c)
+{
+    unrolledTranspose<M, N>(a, aRowStride, aColumnStride, c, std::make_index_sequence<M * N>{});
+}
+
+template<size_type N, typename T>
+constexpr T unrolledDeterminant(const T* a, size_type rowStride, size_type columnStride)
+{
+    static_assert(N >= 0 && N <= 4, "unrolled determinants are only available up to 4x4 matrices");
+
+    const auto e = [a, rowStride, columnStride](size_type i, size_type j)
+    { return a[i * rowStride + j * columnStride]; };
+
+    if constexpr (N == 0)
+    {
+        return dansandu::math::common::multiplicativeIdentity<T>;
+    }
+    else if constexpr (N == 1)
+    {
+        return e(0, 0);
+    }
+    else if constexpr (N == 2)
+    {
+        return e(0, 0) * e(1, 1) - e(0, 1) * e(1, 0);
+    }
+    else if constexpr (N == 3)
+    {
+        return e(0, 0) * (e(1, 1) * e(2, 2) - e(1, 2) * e(2, 1)) -
+               e(0, 1) * (e(1, 0) * e(2, 2) - e(1, 2) * e(2, 0)) + e(0, 2) * (e(1, 0) * e(2, 1) - e(1, 1) * e(2, 0));
+    }
+    else
+    {
+        const auto s0 = e(0, 0) * e(1, 1) - e(1, 0) * e(0, 1);
+        const auto s1 = e(0, 0) * e(1, 2) - e(1, 0) * e(0, 2);
+        const auto s2 = e(0, 0) * e(1, 3) - e(1, 0) * e(0, 3);
+        const auto s3 = e(0, 1) * e(1, 2) - e(1, 1) * e(0, 2);
+        const auto s4 = e(0, 1) * e(1, 3) - e(1, 1) * e(0, 3);
+        const auto s5 = e(0, 2) * e(1, 3) - e(1, 2) * e(0, 3);
+        const auto c0 = e(2, 0) * e(3, 1) - e(3, 0) * e(2, 1);
+        const auto c1 = e(2, 0) * e(3, 2) - e(3, 0) * e(2, 2);
+        const auto c2 = e(2, 0) * e(3, 3) - e(3, 0) * e(2, 3);
+        const auto c3 = e(2, 1) * e(3, 2) - e(3, 1) * e(2, 2);
+        const auto c4 = e(2, 1) * e(3, 3) - e(3, 1) * e(2, 3);
+        const auto c5 = e(2, 2) * e(3, 3) - e(3, 2) * e(2, 3);
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+}
+
+// Writes the inverse of the N x N matrix A into the contiguous C through its adjugate and returns the determinant. C is
+// left untouched when the determinant is zero.
+template<size_type N, typename T>
+constexpr T unrolledInverse(const T* a, size_type rowStride, size_type columnStride, T* c)
+{
+    static_assert(N >= 0 && N <= 4, "unrolled inverses are only available up to 4x4 matrices");
+
+    const auto e = [a, rowStride, columnStride](size_type i, size_type j)
+    { return a[i * rowStride + j * columnStride]; };
+
+    const auto determinant = unrolledDeterminant<N>(a, rowStride, columnStride);
+    if (determinant == dansandu::math::common::additiveIdentity<T>)
+    {
+        return determinant;
+    }
+    const auto d = dansandu::math::common::multiplicativeIdentity<T> / determinant;
+
+    if constexpr (N == 1)
+    {
+        c[0] = d;
+    }
+    else if constexpr (N == 2)
+    {
+        c[0] = e(1, 1) * d;
+        c[1] = -e(0, 1) * d;
+        c[2] = -e(1, 0) * d;
+        c[3] = e(0, 0) * d;
+    }
+    else if constexpr (N == 3)
+    {
+        c[0] = (e(1, 1) * e(2, 2) - e(1, 2) * e(2, 1)) * d;
+        c[1] = (e(0, 2) * e(2, 1) - e(0, 1) * e(2, 2)) * d;
+        c[2] = (e(0, 1) * e(1, 2) - e(0, 2) * e(1, 1)) * d;
+        c[3] = (e(1, 2) * e(2, 0) - e(1, 0) * e(2, 2)) * d;
+        c[4] = (e(0, 0) * e(2, 2) - e(0, 2) * e(2, 0)) * d;
+        c[5] = (e(0, 2) * e(1, 0) - e(0, 0) * e(1, 2)) * d;
+        c[6] = (e(1, 0) * e(2, 1) - e(1, 1) * e(2, 0)) * d;
+        c[7] = (e(0, 1) * e(2, 0) - e(0, 0) * e(2, 1)) * d;
+        c[8] = (e(0, 0) * e(1, 1) - e(0, 1) * e(1, 0)) * d;
+    }
+    else if constexpr (N == 4)
+    {
+        const auto s0 = e(0, 0) * e(1, 1) - e(1, 0) * e(0, 1);
+        const auto s1 = e(0, 0) * e(1, 2) - e(1, 0) * e(0, 2);
+        const auto s2 = e(0, 0) * e(1, 3) - e(1, 0) * e(0, 3);
+        const auto s3 = e(0, 1) * e(1, 2) - e(1, 1) * e(0, 2);
+        const auto s4 = e(0, 1) * e(1, 3) - e(1, 1) * e(0, 3);
+        const auto s5 = e(0, 2) * e(1, 3) - e(1, 2) * e(0, 3);
+        const auto c0 = e(2, 0) * e(3, 1) - e(3, 0) * e(2, 1);
+        const auto c1 = e(2, 0) * e(3, 2) - e(3, 0) * e(2, 2);
+        const auto c2 = e(2, 0) * e(3, 3) - e(3, 0) * e(2, 3);
+        const auto c3 = e(2, 1) * e(3, 2) - e(3, 1) * e(2, 2);
+        const auto c4 = e(2, 1) * e(3, 3) - e(3, 1) * e(2, 3);
+        const auto c5 = e(2, 2) * e(3, 3) - e(3, 2) * e(2, 3);
+        c[0] = (e(1, 1) * c5 - e(1, 2) * c4 + e(1, 3) * c3) * d;
+        c[1] = (-e(0, 1) * c5 + e(0, 2) * c4 - e(0, 3) * c3) * d;
+        c[2] = (e(3, 1) * s5 - e(3, 2) * s4 + e(3, 3) * s3) * d;
+        c[3] = (-e(2, 1) * s5 + e(2, 2) * s4 - e(2, 3) * s3) * d;
+        c[4] = (-e(1, 0) * c5 + e(1, 2) * c2 - e(1, 3) * c1) * d;
+        c[5] = (e(0, 0) * c5 - e(0, 2) * c2 + e(0, 3) * c1) * d;
+        c[6] = (-e(3, 0) * s5 + e(3, 2) * s2 - e(3, 3) * s1) * d;
+        c[7] = (e(2, 0) * s5 - e(2, 2) * s2 + e(2, 3) * s1) * d;
+        c[8] = (e(1, 0) * c4 - e(1, 1) * c2 + e(1, 3) * c0) * d;
+        c[9] = (-e(0, 0) * c4 + e(0, 1) * c2 - e(0, 3) * c0) * d;
+        c[10] = (e(3, 0) * s4 - e(3, 1) * s2 + e(3, 3) * s0) * d;
+        c[11] = (-e(2, 0) * s4 + e(2, 1) * s2 - e(2, 3) * s0) * d;
+        c[12] = (-e(1, 0) * c3 + e(1, 1) * c1 - e(1, 2) * c0) * d;
+        c[13] = (e(0, 0) * c3 - e(0, 1) * c1 + e(0, 2) * c0) * d;
+        c[14] = (-e(3, 0) * s3 + e(3, 1) * s1 - e(3, 2) * s0) * d;
+        c[15] = (e(2, 0) * s3 - e(2, 1) * s1 + e(2, 2) * s0) * d;
+    }
+    return determinant;
+}
+
+}
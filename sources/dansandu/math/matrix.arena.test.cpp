@@ -0,0 +1,115 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <cstdint>
+
+using dansandu::math::matrix::Arena;
+using dansandu::math::matrix::ArenaScope;
+using dansandu::math::matrix::getCurrentArena;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::transposed;
+
+TEST_CASE("matrix.arena")
+{
+    SECTION("scopes")
+    {
+        auto outer = Arena{};
+        auto inner = Arena{};
+
+        REQUIRE(getCurrentArena() == nullptr);
+
+        {
+            const auto outerScope = ArenaScope{outer};
+
+            REQUIRE(getCurrentArena() == &outer);
+
+            {
+                const auto innerScope = ArenaScope{inner};
+
+                REQUIRE(getCurrentArena() == &inner);
+            }
+
+            REQUIRE(getCurrentArena() == &outer);
+        }
+
+        REQUIRE(getCurrentArena() == nullptr);
+    }
+
+    SECTION("temporaries")
+    {
+        auto arena = Arena{};
+        const auto a = Matrix<float>{8, 8, 1.0f};
+        auto result = Matrix<float>{};
+
+        {
+            const auto scope = ArenaScope{arena};
+
+            const auto sum = Matrix<float>{a + a};
+
+            REQUIRE(arena.used() == 64 * sizeof(float));
+
+            REQUIRE(reinterpret_cast<std::uintptr_t>(sum.data()) % 64 == 0);
+
+            const auto product = sum * transposed(a);
+
+            REQUIRE(close(product, Matrix<float>{8, 8, 16.0f}, 1.0e-6f));
+
+            result = product;
+        }
+
+        REQUIRE(close(result, Matrix<float>{8, 8, 16.0f}, 1.0e-6f));
+
+        arena.reset();
+
+        REQUIRE(arena.used() == 0);
+
+        REQUIRE(close(result, Matrix<float>{8, 8, 16.0f}, 1.0e-6f));
+    }
+
+    SECTION("last allocation is rolled back")
+    {
+        auto arena = Arena{};
+        const auto scope = ArenaScope{arena};
+
+        const auto kept = Matrix<double>{8, 8};
+        const auto used = arena.used();
+
+        for (auto i = 0; i < 100; ++i)
+        {
+            const auto temporary = Matrix<double>{8, 8, static_cast<double>(i)};
+        }
+
+        REQUIRE(arena.used() == used);
+    }
+
+    SECTION("growth")
+    {
+        auto arena = Arena{1024};
+
+        {
+            const auto scope = ArenaScope{arena};
+            const auto first = Matrix<float>{16, 16};
+            const auto second = Matrix<float>{32, 32};
+
+            REQUIRE(first(15, 15) == 0.0f);
+
+            REQUIRE(second(31, 31) == 0.0f);
+
+            REQUIRE(arena.used() >= (16 * 16 + 32 * 32) * sizeof(float));
+        }
+
+        const auto capacity = arena.capacity();
+
+        REQUIRE(capacity > 1024);
+
+        arena.reset();
+
+        REQUIRE(arena.capacity() == capacity);
+
+        const auto pointer = arena.allocate(capacity, 64);
+
+        REQUIRE(reinterpret_cast<std::uintptr_t>(pointer) % 64 == 0);
+
+        REQUIRE(arena.capacity() == capacity);
+    }
+}
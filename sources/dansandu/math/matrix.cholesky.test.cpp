@@ -0,0 +1,86 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/math/matrix.test_helpers.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <stdexcept>
+
+using dansandu::math::matrix::choleskyDecompose;
+using dansandu::math::matrix::choleskyDecomposeInPlace;
+using dansandu::math::matrix::choleskySolveInPlace;
+using dansandu::math::matrix::close;
+using dansandu::math::matrix::identity;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::MatrixView;
+using dansandu::math::matrix::solve;
+using dansandu::math::matrix::testing::getRandomMatrix;
+using dansandu::math::matrix::transposedView;
+using dansandu::math::thread_pool::Executor;
+using dansandu::math::thread_pool::ThreadPool;
+
+template<typename T>
+static Matrix<T> getRandomPositiveDefiniteMatrix(int n, unsigned seed)
+{
+    const auto factor = getRandomMatrix<T>(n, n, seed);
+    return factor * Matrix<T>{transposedView(factor)} + identity<T>(n) * static_cast<T>(n);
+}
+
+TEST_CASE("matrix.cholesky")
+{
+    SECTION("small system")
+    {
+        const auto a = Matrix<double>{{{4.0, 12.0, -16.0}, {12.0, 37.0, -43.0}, {-16.0, -43.0, 98.0}}};
+        const auto cholesky = choleskyDecompose(a);
+
+        REQUIRE(close(cholesky.lower, Matrix<double>{{{2.0, 0.0, 0.0}, {6.0, 1.0, 0.0}, {-8.0, 5.0, 3.0}}}, 1.0e-12));
+
+        REQUIRE(close(solve(cholesky, Matrix<double>{{0.0, 6.0, 39.0}}), Matrix<double>{{1.0, 1.0, 1.0}}, 1.0e-12));
+    }
+
+    SECTION("invalid matrices")
+    {
+        REQUIRE_THROWS_AS(choleskyDecompose(Matrix<double>{{{1.0, 2.0}, {2.0, 1.0}}}), std::logic_error);
+
+        REQUIRE_THROWS_AS(choleskyDecompose(Matrix<double>{{{0.0, 0.0}, {0.0, 1.0}}}), std::logic_error);
+
+        REQUIRE_THROWS_AS(choleskyDecompose(Matrix<double>{2, 3, 1.0}), std::logic_error);
+    }
+
+    SECTION("blocked factorization")
+    {
+        auto pool = ThreadPool{4};
+        const auto executor = Executor{pool, 4};
+        const auto n = 200;
+        const auto a = getRandomPositiveDefiniteMatrix<double>(n, 3);
+        const auto b = Matrix<double>{n, 300, 1.0};
+        const auto cholesky = choleskyDecompose(a, executor);
+
+        REQUIRE(close(cholesky.lower * Matrix<double>{transposedView(cholesky.lower)}, a, 1.0e-9));
+
+        REQUIRE(cholesky.lower(0, n - 1) == 0.0);
+
+        REQUIRE(close(a * solve(cholesky, b, executor), b, 1.0e-9));
+    }
+
+    SECTION("in place")
+    {
+        const auto n = 130;
+        const auto a = getRandomPositiveDefiniteMatrix<float>(n, 17);
+        auto factor = a;
+        for (auto i = 0; i < n; ++i)
+        {
+            for (auto j = i + 1; j < n; ++j)
+            {
+                factor(i, j) = -1.0f;
+            }
+        }
+        choleskyDecomposeInPlace(MatrixView<float>{factor});
+
+        REQUIRE(close(factor * Matrix<float>{transposedView(factor)}, a, 1.0e-2f));
+
+        auto x = Matrix<float>{n, 5, 1.0f};
+        choleskySolveInPlace(factor, x);
+
+        REQUIRE(close(a * x, Matrix<float>{n, 5, 1.0f}, 1.0e-4f));
+    }
+}
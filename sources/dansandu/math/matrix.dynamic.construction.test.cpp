@@ -1,13 +1,20 @@
 #include "dansandu/math/matrix.hpp"
 #include "catchorg/catch/catch.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
 #include <vector>
 
+using dansandu::math::matrix::AlignedVector;
 using dansandu::math::matrix::ConstantMatrixView;
 using dansandu::math::matrix::dynamic;
 using dansandu::math::matrix::Matrix;
 using dansandu::math::matrix::MatrixView;
+using dansandu::math::matrix::Padding;
 using dansandu::math::matrix::Slicer;
+using dansandu::math::matrix::transposeInPlace;
+using dansandu::math::matrix::uninitialized;
 
 TEST_CASE("matrix.dynamic.construction")
 {
@@ -25,6 +32,25 @@ TEST_CASE("matrix.dynamic.construction")
         REQUIRE(actual == expected);
     }
 
+    SECTION("uninitialized")
+    {
+        auto matrix = Matrix<double>{3, 4, uninitialized};
+
+        REQUIRE(matrix.rowCount() == 3);
+
+        REQUIRE(matrix.columnCount() == 4);
+
+        std::fill(matrix.begin(), matrix.end(), 2.0);
+
+        REQUIRE(close(matrix, Matrix<double>{3, 4, 2.0}, 1.0e-12));
+
+        REQUIRE(Matrix<int, 2, 2>{2, 2, uninitialized}.rowCount() == 2);
+
+        REQUIRE_THROWS_AS((Matrix<int, 2, dynamic>{3, 2, uninitialized}), std::out_of_range);
+
+        REQUIRE_THROWS_AS((Matrix<int>{-1, 2, uninitialized}), std::out_of_range);
+    }
+
     SECTION("array")
     {
         SECTION("vector")
@@ -268,4 +294,59 @@ TEST_CASE("matrix.dynamic.construction")
             REQUIRE(std::vector<int>{original.cbegin(), original.cend()} == expectedOriginal);
         }
     }
+
+    SECTION("aligned storage")
+    {
+        const auto matrix = Matrix<float>{3, 5};
+
+        REQUIRE(reinterpret_cast<std::uintptr_t>(matrix.data()) % 64 == 0);
+
+        auto buffer = AlignedVector<int>{1, 2, 3, 4, 5, 6};
+        const auto storage = buffer.data();
+        const auto adopted = Matrix<int>{2, 3, std::move(buffer)};
+
+        REQUIRE(adopted == Matrix<int>{{{1, 2, 3}, {4, 5, 6}}});
+
+        REQUIRE(adopted.data() == storage);
+    }
+
+    SECTION("padded rows")
+    {
+        auto matrix = Matrix<float>{3, 5, Padding::cacheLine, 1.0f};
+
+        REQUIRE(matrix.rowStride() == 16);
+
+        REQUIRE(reinterpret_cast<std::uintptr_t>(matrix.data() + matrix.rowStride()) % 64 == 0);
+
+        REQUIRE(Matrix<float>{2, 1024, Padding::cacheLine}.rowStride() == 1040);
+
+        REQUIRE(Matrix<double>{2, 0, Padding::cacheLine}.rowStride() == 0);
+
+        matrix(2, 4) = 7.0f;
+
+        auto expected = Matrix<float>{3, 5, 1.0f};
+        expected(2, 4) = 7.0f;
+
+        REQUIRE(close(matrix, expected, 1.0e-6f));
+
+        REQUIRE(std::distance(matrix.cbegin(), matrix.cend()) == 15);
+
+        matrix += expected;
+
+        REQUIRE(close(ConstantMatrixView<float>{Slicer<1, 3, 2, 2>::slice(matrix)},
+                      Matrix<float>{{{2.0f, 2.0f}, {2.0f, 14.0f}}}, 1.0e-6f));
+
+        REQUIRE(close(matrix * Matrix<float>{5, 1, 1.0f}, Matrix<float>{{10.0f, 10.0f, 22.0f}}, 1.0e-6f));
+
+        REQUIRE_THROWS_AS(matrix.reshape(5, 3), std::out_of_range);
+
+        REQUIRE_THROWS_AS(transposeInPlace(matrix), std::logic_error);
+
+        auto square = Matrix<int>{3, 3, Padding::cacheLine};
+        square(0, 2) = 1;
+
+        transposeInPlace(square);
+
+        REQUIRE(square == Matrix<int>{{{0, 0, 0}, {0, 0, 0}, {1, 0, 0}}});
+    }
 }
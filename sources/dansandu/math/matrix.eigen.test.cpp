@@ -0,0 +1,103 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/math/matrix.test_helpers.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <stdexcept>
+
+using dansandu::math::matrix::close;
+using dansandu::math::matrix::identity;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::symmetricEigenDecompose;
+using dansandu::math::matrix::symmetricEigenvalues;
+using dansandu::math::matrix::testing::getDiagonalMatrix;
+using dansandu::math::matrix::testing::getRandomMatrix;
+using dansandu::math::matrix::transposedView;
+using dansandu::math::thread_pool::Executor;
+using dansandu::math::thread_pool::ThreadPool;
+
+static Matrix<double> getRandomSymmetricMatrix(int n, unsigned seed)
+{
+    auto matrix = getRandomMatrix(n, n, seed);
+    for (auto i = 0; i < n; ++i)
+    {
+        for (auto j = 0; j < i; ++j)
+        {
+            matrix(j, i) = matrix(i, j);
+        }
+    }
+    return matrix;
+}
+
+TEST_CASE("matrix.eigen")
+{
+    SECTION("small matrix")
+    {
+        const auto a = Matrix<double>{{{2.0, 1.0, 0.0}, {1.0, 2.0, 1.0}, {0.0, 1.0, 2.0}}};
+        const auto expected = Matrix<double>{{2.0 - std::sqrt(2.0), 2.0, 2.0 + std::sqrt(2.0)}};
+
+        REQUIRE(close(symmetricEigenvalues(a), expected, 1.0e-12));
+
+        const auto eigen = symmetricEigenDecompose(a);
+
+        REQUIRE(close(eigen.values, expected, 1.0e-12));
+
+        REQUIRE(close(a * eigen.vectors, eigen.vectors * getDiagonalMatrix(eigen.values), 1.0e-12));
+
+        REQUIRE(close(symmetricEigenvalues(Matrix<double>{{{3.0, 0.0}, {0.0, -1.0}}}), Matrix<double>{{-1.0, 3.0}},
+                      1.0e-12));
+
+        REQUIRE(close(symmetricEigenvalues(Matrix<double>{1, 1, 5.0}), Matrix<double>{1, 1, 5.0}, 1.0e-12));
+
+        REQUIRE(symmetricEigenvalues(Matrix<double>{}).rowCount() == 0);
+    }
+
+    SECTION("lower triangle only")
+    {
+        const auto a = getRandomSymmetricMatrix(20, 3);
+        auto lower = a;
+        for (auto i = 0; i < 20; ++i)
+        {
+            for (auto j = i + 1; j < 20; ++j)
+            {
+                lower(i, j) = 7.0;
+            }
+        }
+
+        REQUIRE(close(symmetricEigenvalues(lower), symmetricEigenvalues(a), 1.0e-12));
+
+        REQUIRE_THROWS_AS(symmetricEigenvalues(Matrix<double>{2, 3, 1.0}), std::logic_error);
+    }
+
+    SECTION("large matrix")
+    {
+        auto pool = ThreadPool{4};
+        const auto executor = Executor{pool, 4};
+        const auto n = 150;
+        const auto a = getRandomSymmetricMatrix(n, 7);
+        const auto eigen = symmetricEigenDecompose(a, executor);
+        const auto& vectors = eigen.vectors;
+
+        REQUIRE(close(Matrix<double>{transposedView(vectors)} * vectors, identity<double>(n), 1.0e-10));
+
+        REQUIRE(close(a * vectors, vectors * getDiagonalMatrix(eigen.values), 1.0e-10));
+
+        REQUIRE(close(symmetricEigenvalues(a, executor), eigen.values, 1.0e-10));
+
+        for (auto i = 1; i < n; ++i)
+        {
+            REQUIRE(eigen.values(i - 1, 0) <= eigen.values(i, 0));
+        }
+
+        auto repeated = Matrix<double>{identity<double>(n) * 2.0};
+        repeated(0, 0) = 5.0;
+        const auto degenerate = symmetricEigenDecompose(repeated, executor);
+
+        REQUIRE(degenerate.values(n - 1, 0) == Approx(5.0));
+
+        REQUIRE(degenerate.values(0, 0) == Approx(2.0));
+
+        REQUIRE(close(repeated * degenerate.vectors,
+                      degenerate.vectors * getDiagonalMatrix(degenerate.values), 1.0e-12));
+    }
+}
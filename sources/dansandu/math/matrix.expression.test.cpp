@@ -0,0 +1,153 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <stdexcept>
+
+using dansandu::math::common::Power;
+using dansandu::math::matrix::ConstantMatrixView;
+using dansandu::math::matrix::dynamic;
+using dansandu::math::matrix::elementwise;
+using dansandu::math::matrix::evaluate;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::MatrixView;
+using dansandu::math::matrix::Slicer;
+using dansandu::math::matrix::transposedView;
+
+TEST_CASE("matrix.expression")
+{
+    SECTION("fused evaluation")
+    {
+        const auto a = Matrix<int>{{{1, 2, 3}, {4, 5, 6}}};
+        const auto b = Matrix<int>{{{6, 5, 4}, {3, 2, 1}}};
+        const auto c = Matrix<int>{{{1, 1, 1}, {2, 2, 2}}};
+
+        const auto result = Matrix<int>{2 * a + b * 3 - c / 1 - -a};
+
+        REQUIRE(result == Matrix<int>{{{20, 20, 20}, {19, 19, 19}}});
+    }
+
+    SECTION("static dimensions")
+    {
+        const auto a = Matrix<int, 2, 2>{{{1, 2}, {3, 4}}};
+        const auto b = Matrix<int, dynamic, dynamic>{{{4, 3}, {2, 1}}};
+
+        const auto result = evaluate(a + b);
+
+        REQUIRE(decltype(result)::staticRowCount == 2);
+
+        REQUIRE(decltype(result)::staticColumnCount == 2);
+
+        REQUIRE(result == Matrix<int>{{{5, 5}, {5, 5}}});
+    }
+
+    SECTION("dimension mismatch")
+    {
+        const auto a = Matrix<int>{{{1, 2, 3}, {4, 5, 6}}};
+        const auto b = Matrix<int>{{{1, 2}, {3, 4}}};
+
+        REQUIRE_THROWS_AS(a + b, std::logic_error);
+
+        REQUIRE_THROWS_AS(a - b * 2, std::logic_error);
+
+        auto target = Matrix<int>{3, 3};
+        const auto view = MatrixView<int>{Slicer<0, 0, 2, 2>::slice(target)};
+
+        REQUIRE_THROWS_AS(view.deepCopy(a + a), std::logic_error);
+    }
+
+    SECTION("assignment")
+    {
+        auto a = Matrix<int>{{{1, 2}, {3, 4}}};
+        const auto b = Matrix<int>{{{1, 1}, {1, 1}}};
+        const auto storage = a.data();
+
+        a = a + b;
+
+        REQUIRE(a == Matrix<int>{{{2, 3}, {4, 5}}});
+
+        REQUIRE(a.data() == storage);
+
+        a += b * 2;
+
+        REQUIRE(a == Matrix<int>{{{4, 5}, {6, 7}}});
+
+        a -= -b;
+
+        REQUIRE(a == Matrix<int>{{{5, 6}, {7, 8}}});
+
+        a = Matrix<int>{{1, 2, 3}} * 2;
+
+        REQUIRE(a == Matrix<int>{{2, 4, 6}});
+    }
+
+    SECTION("views")
+    {
+        auto matrix = Matrix<int>{{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}};
+        const auto top = ConstantMatrixView<int>{Slicer<0, 0, 2, 2>::slice(matrix)};
+        const auto bottom = ConstantMatrixView<int>{Slicer<1, 1, 2, 2>::slice(matrix)};
+
+        const auto sum = top + bottom;
+
+        REQUIRE(sum == Matrix<int>{{{6, 8}, {12, 14}}});
+
+        auto target = Matrix<int>{3, 3};
+        const auto view = MatrixView<int>{Slicer<1, 1, 2, 2>::slice(target)};
+
+        view.deepCopy(top - bottom);
+
+        view += top;
+
+        REQUIRE(target == Matrix<int>{{{0, 0, 0}, {0, -3, -2}, {0, 0, 1}}});
+    }
+
+    SECTION("aliased operands")
+    {
+        auto a = Matrix<int>{{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}};
+        const auto b = Matrix<int>{{{1, 1, 1}, {1, 1, 1}, {1, 1, 1}}};
+
+        a = transposedView(a) + b;
+
+        REQUIRE(a == Matrix<int>{{{2, 5, 8}, {3, 6, 9}, {4, 7, 10}}});
+
+        auto d = Matrix<double>{{{1.0, 2.0}, {3.0, 4.0}}};
+
+        d = transposedView(d) * 2.0;
+
+        REQUIRE(close(d, Matrix<double>{{{2.0, 6.0}, {4.0, 8.0}}}, 1.0e-12));
+
+        d += transposedView(d) * 0.5;
+
+        REQUIRE(close(d, Matrix<double>{{{3.0, 8.0}, {7.0, 12.0}}}, 1.0e-12));
+
+        d -= transposedView(d);
+
+        REQUIRE(close(d, Matrix<double>{{{0.0, 1.0}, {-1.0, 0.0}}}, 1.0e-12));
+    }
+
+    SECTION("temporaries are owned")
+    {
+        const auto expression = Matrix<int>{{1, 2, 3}} + Matrix<int>{{3, 2, 1}};
+
+        REQUIRE(expression == Matrix<int>{{4, 4, 4}});
+    }
+
+    SECTION("elementwise function")
+    {
+        const auto bases = Matrix<double>{{1.0, 2.0, 3.0}};
+        const auto exponents = Matrix<double>{{2.0, 3.0, 0.5}};
+
+        const auto result = evaluate(elementwise(Power{}, bases, exponents) * 2.0);
+
+        REQUIRE(close(result, Matrix<double>{{2.0, 16.0, 2.0 * std::sqrt(3.0)}}, 1.0e-12));
+    }
+
+    SECTION("products of expressions")
+    {
+        const auto a = Matrix<int>{{{1, 2}, {3, 4}}};
+        const auto b = Matrix<int>{{{1, 0}, {0, 1}}};
+
+        REQUIRE((a + b) * (a - b) == Matrix<int>{{{6, 10}, {15, 21}}});
+
+        REQUIRE(dotProduct(Matrix<int>{{1, 2}} + Matrix<int>{{1, 1}}, Matrix<int>{{3, 4}}) == 18);
+    }
+}
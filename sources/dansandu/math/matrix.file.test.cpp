@@ -0,0 +1,195 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+using dansandu::math::matrix::close;
+using dansandu::math::matrix::ElementType;
+using dansandu::math::matrix::Layout;
+using dansandu::math::matrix::mapMatrixFile;
+using dansandu::math::matrix::MapMode;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::MatrixFileHeader;
+using dansandu::math::matrix::MatrixFileReader;
+using dansandu::math::matrix::MatrixFileWriter;
+using dansandu::math::matrix::readMatrixFile;
+using dansandu::math::matrix::readMatrixFileHeader;
+using dansandu::math::matrix::Slicer;
+using dansandu::math::matrix::transposedView;
+using dansandu::math::matrix::writeMatrixFile;
+using dansandu::math::matrix::writeMatrixFileHeader;
+
+TEST_CASE("matrix.file")
+{
+    const auto path = (std::filesystem::temp_directory_path() / "dansandu_math_matrix_file.test.bin").string();
+    const auto matrix = Matrix<double>{{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, {7.0, 8.0, 9.0}, {10.0, 11.0, 12.0}}};
+
+    SECTION("round trip")
+    {
+        writeMatrixFile(path, matrix);
+
+        const auto header = readMatrixFileHeader(path);
+
+        REQUIRE(header.elementType == ElementType::float64);
+
+        REQUIRE(header.rows == 4);
+
+        REQUIRE(header.columns == 3);
+
+        REQUIRE(header.layout == Layout::rowMajor);
+
+        REQUIRE(header.payloadOffset == MatrixFileHeader::size);
+
+        REQUIRE(std::filesystem::file_size(path) == MatrixFileHeader::size + 12 * sizeof(double));
+
+        REQUIRE(close(readMatrixFile<double>(path), matrix, 1.0e-12));
+
+        writeMatrixFile(path, Matrix<int>{{{1, 2}, {3, 4}}});
+
+        REQUIRE(readMatrixFile<int>(path) == Matrix<int>{{{1, 2}, {3, 4}}});
+
+        writeMatrixFile(path, Matrix<float>{0, 5});
+
+        REQUIRE(readMatrixFile<float>(path).columnCount() == 5);
+    }
+
+    SECTION("strided sources")
+    {
+        writeMatrixFile(path, transposedView(matrix));
+
+        REQUIRE(close(readMatrixFile<double>(path), transposedView(matrix), 1.0e-12));
+
+        writeMatrixFile(path, Slicer<1, 1, 2, 2>::slice(matrix));
+
+        REQUIRE(close(readMatrixFile<double>(path), Matrix<double>{{{5.0, 6.0}, {8.0, 9.0}}}, 1.0e-12));
+    }
+
+    SECTION("mapping")
+    {
+        writeMatrixFile(path, matrix);
+
+        {
+            auto mapped = mapMatrixFile<double>(path, MapMode::readWrite);
+
+            REQUIRE(reinterpret_cast<std::uintptr_t>(mapped.constantView().data()) % 64 == 0);
+
+            REQUIRE(close(mapped.constantView(), matrix, 1.0e-12));
+
+            mapped.view()(3, 2) = 100.0;
+        }
+
+        REQUIRE(readMatrixFile<double>(path)(3, 2) == 100.0);
+    }
+
+    SECTION("column-major")
+    {
+        writeMatrixFile(path, matrix, Layout::columnMajor);
+
+        REQUIRE(readMatrixFileHeader(path).layout == Layout::columnMajor);
+
+        const auto mapped = mapMatrixFile<double>(path);
+
+        REQUIRE(mapped.layout() == Layout::columnMajor);
+
+        REQUIRE(mapped.constantView()(0, 1) == 2.0);
+
+        REQUIRE(mapped.constantView().data()[1] == 4.0);
+
+        REQUIRE(close(readMatrixFile<double>(path), matrix, 1.0e-12));
+
+        REQUIRE_THROWS_AS(MatrixFileReader<double>{path}, std::logic_error);
+    }
+
+    SECTION("streaming")
+    {
+        {
+            auto writer = MatrixFileWriter<double>{path, 3};
+            writer.write(Slicer<0, 0, 3, 3>::slice(matrix));
+            writer.write(Slicer<3, 0, 1, 3>::slice(matrix));
+            REQUIRE_THROWS_AS(writer.write(Matrix<double>{1, 2}), std::logic_error);
+        }
+
+        auto reader = MatrixFileReader<double>{path};
+        auto chunk = Matrix<double>{};
+
+        REQUIRE(reader.remainingRows() == 4);
+
+        REQUIRE(reader.read(chunk, 2) == 2);
+
+        const auto storage = chunk.data();
+
+        REQUIRE(close(chunk, Matrix<double>{{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}}}, 1.0e-12));
+
+        REQUIRE(reader.read(chunk, 2) == 2);
+
+        REQUIRE(chunk.data() == storage);
+
+        REQUIRE(close(chunk, Matrix<double>{{{7.0, 8.0, 9.0}, {10.0, 11.0, 12.0}}}, 1.0e-12));
+
+        REQUIRE(reader.read(chunk, 2) == 0);
+
+        REQUIRE_THROWS_AS(reader.read(chunk, 0), std::invalid_argument);
+    }
+
+    SECTION("more elements than size_type can count")
+    {
+        // Only the header is written, the payload is a hole in a sparse file that reads back as zeros.
+        const auto rows = 65536;
+        const auto columns = 32769;
+        {
+            auto file = std::ofstream{path, std::ios::binary};
+            const auto header = MatrixFileHeader{ElementType::float32, rows, columns, Layout::rowMajor,
+                                                 MatrixFileHeader::size};
+            writeMatrixFileHeader(file, header);
+        }
+        std::filesystem::resize_file(path, MatrixFileHeader::size + std::uintmax_t{rows} * columns * sizeof(float));
+
+        REQUIRE(readMatrixFileHeader(path).rows == rows);
+
+        auto reader = MatrixFileReader<float>{path};
+        auto chunk = Matrix<float>{};
+
+        REQUIRE(reader.read(chunk, 2) == 2);
+
+        REQUIRE(close(chunk, Matrix<float>{2, columns, 0.0f}, 1.0e-6f));
+
+        REQUIRE_THROWS_AS(MatrixFileReader<float>{path}.read(chunk, rows), std::out_of_range);
+
+        REQUIRE_THROWS_AS(readMatrixFile<float>(path), std::out_of_range);
+
+        const auto mapped = mapMatrixFile<float>(path);
+
+        REQUIRE(mapped.constantRowsView(rows - 1, 1)(0, columns - 1) == 0.0f);
+    }
+
+    SECTION("invalid files")
+    {
+        writeMatrixFile(path, matrix);
+
+        REQUIRE_THROWS_AS(readMatrixFile<float>(path), std::invalid_argument);
+
+        REQUIRE_THROWS_AS(mapMatrixFile<int>(path), std::invalid_argument);
+
+        std::filesystem::resize_file(path, MatrixFileHeader::size + 5 * sizeof(double));
+
+        auto reader = MatrixFileReader<double>{path};
+        auto chunk = Matrix<double>{};
+
+        REQUIRE_THROWS_AS(reader.read(chunk, 4), std::runtime_error);
+
+        {
+            auto file = std::ofstream{path, std::ios::binary};
+            file << "not a matrix file at all, just some text that is longer than the header of a real matrix file";
+        }
+
+        REQUIRE_THROWS_AS(readMatrixFileHeader(path), std::runtime_error);
+
+        REQUIRE_THROWS_AS(readMatrixFileHeader(path + ".missing"), std::runtime_error);
+    }
+
+    std::remove(path.c_str());
+}
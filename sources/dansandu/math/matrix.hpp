@@ -1,4 +1,15 @@
 #pragma once
 
+#include "dansandu/math/internal/matrix/cholesky.hpp"
+#include "dansandu/math/internal/matrix/lu.hpp"
+#include "dansandu/math/internal/matrix/mapped_matrix.hpp"
 #include "dansandu/math/internal/matrix/matrix.hpp"
+#include "dansandu/math/internal/matrix/matrix_file.hpp"
+#include "dansandu/math/internal/matrix/matrix_text.hpp"
+#include "dansandu/math/internal/matrix/qr.hpp"
+#include "dansandu/math/internal/matrix/randomized_svd.hpp"
 #include "dansandu/math/internal/matrix/slicer.hpp"
+#include "dansandu/math/internal/matrix/sparse_matrix.hpp"
+#include "dansandu/math/internal/matrix/svd.hpp"
+#include "dansandu/math/internal/matrix/symmetric_eigen.hpp"
+#include "dansandu/math/internal/matrix/trsm.hpp"
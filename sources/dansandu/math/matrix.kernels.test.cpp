@@ -0,0 +1,110 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <vector>
+
+using Catch::Detail::Approx;
+using dansandu::math::matrix::getKernels;
+using dansandu::math::matrix::getSupportedInstructionSet;
+using dansandu::math::matrix::InstructionSet;
+
+template<typename T>
+static std::vector<T> generate(int length, int seed)
+{
+    auto result = std::vector<T>(length);
+    for (auto i = 0; i < length; ++i)
+    {
+        result[i] = static_cast<T>((i * 37 + seed * 11) % 23 - 11) / static_cast<T>(4);
+    }
+    return result;
+}
+
+template<typename T>
+static void testKernels(const InstructionSet instructionSet)
+{
+    const auto kernels = getKernels<T>(instructionSet);
+    const auto scalar = getKernels<T>(InstructionSet::scalar);
+
+    REQUIRE(kernels != nullptr);
+
+    REQUIRE(kernels->instructionSet == instructionSet);
+
+    for (const auto length : {0, 1, 3, 8, 15, 16, 33, 64, 101})
+    {
+        const auto a = generate<T>(length, 1);
+        const auto b = generate<T>(length, 2);
+
+        REQUIRE(kernels->dot(length, a.data(), b.data()) == Approx(scalar->dot(length, a.data(), b.data())));
+
+        REQUIRE(kernels->squaredDistance(length, a.data(), b.data()) ==
+                Approx(scalar->squaredDistance(length, a.data(), b.data())));
+
+        auto expected = b;
+        auto actual = b;
+        scalar->axpy(length, static_cast<T>(-1.5), a.data(), expected.data());
+        kernels->axpy(length, static_cast<T>(-1.5), a.data(), actual.data());
+
+        REQUIRE(expected == actual);
+    }
+
+    const auto depth = 19;
+    const auto packedA = generate<T>(depth * kernels->microRows, 3);
+    const auto packedB = generate<T>(depth * kernels->microColumns, 4);
+    const auto rowStride = kernels->microColumns + 5;
+    auto actual = generate<T>(kernels->microRows * rowStride, 5);
+    auto expected = actual;
+
+    kernels->gemmMicroKernel(depth, packedA.data(), packedB.data(), actual.data(), rowStride);
+
+    for (auto i = 0; i < kernels->microRows; ++i)
+    {
+        for (auto j = 0; j < kernels->microColumns; ++j)
+        {
+            auto sum = static_cast<T>(0);
+            for (auto p = 0; p < depth; ++p)
+            {
+                sum += packedA[p * kernels->microRows + i] * packedB[p * kernels->microColumns + j];
+            }
+            expected[i * rowStride + j] += sum;
+        }
+    }
+
+    for (auto i = 0; i < static_cast<int>(actual.size()); ++i)
+    {
+        REQUIRE(actual[i] == Approx(expected[i]));
+    }
+
+    const auto size = kernels->transposeSize;
+    const auto tile = generate<T>(size * (size + 3), 6);
+    auto transpose = std::vector<T>(size * (size + 1));
+
+    kernels->transposeMicroKernel(tile.data(), size + 3, transpose.data(), size + 1);
+
+    for (auto i = 0; i < size; ++i)
+    {
+        for (auto j = 0; j < size; ++j)
+        {
+            REQUIRE(transpose[j * (size + 1) + i] == tile[i * (size + 3) + j]);
+        }
+    }
+}
+
+TEST_CASE("matrix.kernels")
+{
+    const auto supported = getSupportedInstructionSet();
+
+    REQUIRE(&getKernels<float>() == getKernels<float>(supported));
+
+    REQUIRE(&getKernels<double>() == getKernels<double>(supported));
+
+    for (const auto instructionSet :
+         {InstructionSet::scalar, InstructionSet::sse, InstructionSet::avx2, InstructionSet::avx512})
+    {
+        if (getKernels<float>(instructionSet) != nullptr)
+        {
+            testKernels<float>(instructionSet);
+
+            testKernels<double>(instructionSet);
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using dansandu::math::matrix::ConstantMatrixView;
+using dansandu::math::matrix::dynamic;
+using dansandu::math::matrix::gemm;
+using dansandu::math::matrix::Layout;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::MatrixView;
+using dansandu::math::matrix::Slicer;
+using dansandu::math::matrix::Transposition;
+using dansandu::math::matrix::transposed;
+using dansandu::math::matrix::transposedView;
+using dansandu::math::matrix::transposeInPlace;
+
+template<typename T, dansandu::math::matrix::size_type M = dynamic, dansandu::math::matrix::size_type N = dynamic>
+using ColumnMajorMatrix = Matrix<T, M, N, Layout::columnMajor>;
+
+TEST_CASE("matrix.layout")
+{
+    SECTION("column-major storage")
+    {
+        const auto matrix = ColumnMajorMatrix<int>{{{1, 2, 3}, {4, 5, 6}}};
+
+        REQUIRE(matrix.rowCount() == 2);
+
+        REQUIRE(matrix.columnCount() == 3);
+
+        REQUIRE(std::vector<int>(matrix.data(), matrix.data() + 6) == std::vector<int>{1, 4, 2, 5, 3, 6});
+
+        REQUIRE(matrix == Matrix<int>{{{1, 2, 3}, {4, 5, 6}}});
+
+        REQUIRE(matrix(1, 2) == 6);
+
+        REQUIRE(ColumnMajorMatrix<int>{{1, 2, 3}} == Matrix<int>{{1, 2, 3}});
+
+        REQUIRE(ColumnMajorMatrix<int, 2, 2>{} == Matrix<int>{2, 2});
+
+        REQUIRE_THROWS_AS((ColumnMajorMatrix<int, 2, 2>{3, 2}), std::out_of_range);
+    }
+
+    SECTION("adopting column-major buffers")
+    {
+        const auto matrix = ColumnMajorMatrix<double>{2, 3, std::vector<double>{1.0, 4.0, 2.0, 5.0, 3.0, 6.0}};
+
+        REQUIRE(close(matrix, Matrix<double>{{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}}}, 1.0e-12));
+
+        auto buffer = std::vector<int>{1, 4, 2, 5, 3, 6};
+        const auto view = MatrixView<int>{2, 3, Layout::columnMajor, buffer.data()};
+
+        REQUIRE(view == Matrix<int>{{{1, 2, 3}, {4, 5, 6}}});
+
+        view(0, 1) = 7;
+
+        REQUIRE(buffer[2] == 7);
+
+        const auto rowMajor = ConstantMatrixView<int>{3, 2, Layout::rowMajor, buffer.data()};
+
+        REQUIRE(rowMajor == Matrix<int>{{{1, 4}, {7, 5}, {3, 6}}});
+    }
+
+    SECTION("conversions")
+    {
+        auto columnMajor = ColumnMajorMatrix<int>{{{1, 2}, {3, 4}, {5, 6}}};
+
+        const auto rowMajor = Matrix<int>{columnMajor};
+
+        REQUIRE(rowMajor == columnMajor);
+
+        REQUIRE(ColumnMajorMatrix<int>{rowMajor} == rowMajor);
+
+        const auto view = MatrixView<int>{columnMajor};
+
+        REQUIRE(view.data() == columnMajor.data());
+
+        REQUIRE(view.rowStride() == 1);
+
+        REQUIRE(Slicer<1, 0, 2, 2>::slice(columnMajor) == Matrix<int>{{{3, 4}, {5, 6}}});
+
+        const auto transpose = transposedView(columnMajor);
+
+        REQUIRE(transpose.columnStride() == 1);
+
+        REQUIRE(transpose == transposed(rowMajor));
+    }
+
+    SECTION("arithmetic")
+    {
+        auto a = ColumnMajorMatrix<int>{{{1, 2, 3}, {4, 5, 6}}};
+        const auto b = ColumnMajorMatrix<int>{{{1, 1, 1}, {2, 2, 2}}};
+        const auto c = Matrix<int>{{{0, 1, 0}, {1, 0, 1}}};
+
+        REQUIRE(a + b == Matrix<int>{{{2, 3, 4}, {6, 7, 8}}});
+
+        REQUIRE(ColumnMajorMatrix<int>{a * 2 - c} == Matrix<int>{{{2, 3, 6}, {7, 10, 11}}});
+
+        a += b;
+
+        REQUIRE(a == Matrix<int>{{{2, 3, 4}, {6, 7, 8}}});
+
+        a -= c;
+
+        REQUIRE(a == Matrix<int>{{{2, 2, 4}, {5, 7, 7}}});
+
+        a = a + a;
+
+        REQUIRE(a == Matrix<int>{{{4, 4, 8}, {10, 14, 14}}});
+
+        REQUIRE(a * transposed(b) == Matrix<int>{{{16, 32}, {38, 76}}});
+    }
+
+    SECTION("products")
+    {
+        const auto a = ColumnMajorMatrix<double>{{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}}};
+        const auto b = Matrix<double>{{{1.0, 0.0}, {0.0, 1.0}, {1.0, 1.0}}};
+        auto c = ColumnMajorMatrix<double>{2, 2};
+
+        REQUIRE(close(a * b, Matrix<double>{{{4.0, 5.0}, {10.0, 11.0}}}, 1.0e-12));
+
+        gemm(1.0, a, Transposition::none, b, Transposition::none, 0.0, MatrixView<double>{c});
+
+        REQUIRE(close(c, Matrix<double>{{{4.0, 5.0}, {10.0, 11.0}}}, 1.0e-12));
+
+        REQUIRE(c.data()[1] == 10.0);
+    }
+
+    SECTION("in place transposition")
+    {
+        auto square = ColumnMajorMatrix<int>{{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}};
+
+        transposeInPlace(square);
+
+        REQUIRE(square == Matrix<int>{{{1, 4, 7}, {2, 5, 8}, {3, 6, 9}}});
+
+        auto rectangle = ColumnMajorMatrix<int>{{{1, 2, 3}, {4, 5, 6}}};
+
+        transposeInPlace(rectangle);
+
+        REQUIRE(rectangle == Matrix<int>{{{1, 4}, {2, 5}, {3, 6}}});
+    }
+}
@@ -0,0 +1,152 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/math/matrix.test_helpers.hpp"
+#include "dansandu/math/permutation.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using dansandu::math::matrix::close;
+using dansandu::math::matrix::determinant;
+using dansandu::math::matrix::Diagonal;
+using dansandu::math::matrix::identity;
+using dansandu::math::matrix::inverse;
+using dansandu::math::matrix::luDecompose;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::Side;
+using dansandu::math::matrix::sliceRow;
+using dansandu::math::matrix::solve;
+using dansandu::math::matrix::testing::getRandomMatrix;
+using dansandu::math::matrix::Transposition;
+using dansandu::math::matrix::transposedView;
+using dansandu::math::matrix::Triangle;
+using dansandu::math::matrix::trsm;
+using dansandu::math::permutation::getInvertedPermutation;
+using dansandu::math::thread_pool::Executor;
+using dansandu::math::thread_pool::ThreadPool;
+
+template<typename M>
+static Matrix<double> getTriangle(const M& matrix, Triangle triangle, Diagonal diagonal)
+{
+    auto result = Matrix<double>{matrix};
+    for (auto i = 0; i < result.rowCount(); ++i)
+    {
+        for (auto j = 0; j < result.columnCount(); ++j)
+        {
+            if ((triangle == Triangle::lower && j > i) || (triangle == Triangle::upper && j < i))
+            {
+                result(i, j) = 0.0;
+            }
+            else if (i == j && diagonal == Diagonal::unit)
+            {
+                result(i, j) = 1.0;
+            }
+        }
+    }
+    return result;
+}
+
+TEST_CASE("matrix.lu")
+{
+    SECTION("small system")
+    {
+        const auto a = Matrix<double>{{{0.0, 2.0, 1.0}, {1.0, 1.0, 0.0}, {3.0, 0.0, 1.0}}};
+        const auto lu = luDecompose(a);
+
+        REQUIRE(lu.permutation == std::vector<int>{2, 0, 1});
+
+        const auto l = getTriangle(lu.factors, Triangle::lower, Diagonal::unit);
+        const auto u = getTriangle(lu.factors, Triangle::upper, Diagonal::nonUnit);
+        const auto product = l * u;
+        const auto inverted = getInvertedPermutation(lu.permutation);
+        for (auto row = 0; row < a.rowCount(); ++row)
+        {
+            REQUIRE(close(sliceRow(product, inverted[row]), sliceRow(a, row), 1.0e-12));
+        }
+
+        REQUIRE(determinant(a) == Approx(-5.0));
+
+        REQUIRE(close(solve(a, Matrix<double>{{3.0, 2.0, 4.0}}), Matrix<double>{{1.0, 1.0, 1.0}}, 1.0e-12));
+
+        REQUIRE(close(inverse(a) * a, identity<double>(3), 1.0e-12));
+    }
+
+    SECTION("singular system")
+    {
+        const auto a = Matrix<double>{{{1.0, 2.0}, {2.0, 4.0}}};
+
+        REQUIRE(determinant(Matrix<double>{a}) == 0.0);
+
+        REQUIRE_THROWS_AS(solve(a, Matrix<double>{{1.0, 1.0}}), std::logic_error);
+
+        REQUIRE_THROWS_AS(luDecompose(Matrix<double>{2, 3, 1.0}), std::logic_error);
+    }
+
+    SECTION("blocked factorization")
+    {
+        auto pool = ThreadPool{4};
+        const auto executor = Executor{pool, 4};
+        const auto n = 200;
+        const auto a = getRandomMatrix(n, n, 5);
+        const auto b = getRandomMatrix(n, 7, 9);
+        const auto lu = luDecompose(a, executor);
+
+        const auto product = getTriangle(lu.factors, Triangle::lower, Diagonal::unit) *
+                             getTriangle(lu.factors, Triangle::upper, Diagonal::nonUnit);
+        auto permuted = Matrix<double>{n, n, 0.0};
+        for (auto row = 0; row < n; ++row)
+        {
+            sliceRow(permuted, row).deepCopy(sliceRow(a, lu.permutation[row]));
+        }
+
+        REQUIRE(close(product, permuted, 1.0e-10));
+
+        const auto x = solve(lu, b, executor);
+
+        REQUIRE(close(a * x, b, 1.0e-9));
+
+        REQUIRE(close(inverse(a, executor) * a, identity<double>(n), 1.0e-9));
+
+        REQUIRE(determinant(a, executor) == Approx(determinant(lu)));
+
+        REQUIRE(determinant(Matrix<double>{transposedView(a)}) == Approx(determinant(lu)));
+    }
+
+    SECTION("triangular solves")
+    {
+        const auto n = 150;
+        const auto a = Matrix<double>{getRandomMatrix(n, n, 21) * 0.02 + identity<double>(n) * 2.0};
+        const auto b = getRandomMatrix(n, 40, 23);
+        for (const auto side : {Side::left, Side::right})
+        {
+            for (const auto triangle : {Triangle::lower, Triangle::upper})
+            {
+                for (const auto transposition : {Transposition::none, Transposition::transposed})
+                {
+                    for (const auto diagonal : {Diagonal::nonUnit, Diagonal::unit})
+                    {
+                        auto operand = getTriangle(a, triangle, diagonal);
+                        if (transposition == Transposition::transposed)
+                        {
+                            operand = Matrix<double>{transposedView(operand)};
+                        }
+                        auto x = side == Side::left ? Matrix<double>{b} : Matrix<double>{transposedView(b)};
+                        trsm(side, triangle, transposition, diagonal, 2.0, a, x);
+
+                        const auto result = side == Side::left ? operand * x : x * operand;
+                        const auto expected = side == Side::left ? Matrix<double>{b * 2.0}
+                                                                 : Matrix<double>{transposedView(b)} * 2.0;
+
+                        REQUIRE(close(result, expected, 1.0e-9));
+                    }
+                }
+            }
+        }
+
+        auto wrong = Matrix<double>{n + 1, 2, 0.0};
+
+        REQUIRE_THROWS_AS(trsm(Side::left, Triangle::lower, Transposition::none, Diagonal::nonUnit, 1.0, a, wrong),
+                          std::logic_error);
+    }
+}
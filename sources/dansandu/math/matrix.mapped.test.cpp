@@ -0,0 +1,159 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/math/clustering.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+using dansandu::math::clustering::kMeans;
+using dansandu::math::matrix::AccessPattern;
+using dansandu::math::matrix::close;
+using dansandu::math::matrix::Layout;
+using dansandu::math::matrix::MappedMatrix;
+using dansandu::math::matrix::MapMode;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::Slicer;
+
+TEST_CASE("matrix.mapped")
+{
+    const auto path = (std::filesystem::temp_directory_path() / "dansandu_math_matrix_mapped.test.bin").string();
+
+    SECTION("write and read back")
+    {
+        {
+            auto mapped = MappedMatrix<float>::create(path, 3, 4);
+
+            REQUIRE(close(mapped.constantView(), Matrix<float>{3, 4}, 1.0e-6f));
+
+            mapped.view().deepCopy(Matrix<float>{{{1.0f, 2.0f, 3.0f, 4.0f},
+                                                  {5.0f, 6.0f, 7.0f, 8.0f},
+                                                  {9.0f, 10.0f, 11.0f, 12.0f}}});
+
+            mapped.flush();
+        }
+
+        REQUIRE(std::filesystem::file_size(path) == 12 * sizeof(float));
+
+        const auto mapped = MappedMatrix<float>{path, 3, 4};
+
+        mapped.advise(AccessPattern::sequential);
+
+        REQUIRE(close(mapped.constantView(),
+                      Matrix<float>{{{1.0f, 2.0f, 3.0f, 4.0f}, {5.0f, 6.0f, 7.0f, 8.0f}, {9.0f, 10.0f, 11.0f, 12.0f}}},
+                      1.0e-6f));
+
+        REQUIRE(close(Slicer<1, 1, 2, 2>::slice(mapped.constantView()), Matrix<float>{{{6.0f, 7.0f}, {10.0f, 11.0f}}},
+                      1.0e-6f));
+
+        REQUIRE(close(mapped.constantView() * Matrix<float>{4, 1, 1.0f}, Matrix<float>{{10.0f, 26.0f, 42.0f}},
+                      1.0e-6f));
+
+        auto readOnly = MappedMatrix<float>{path, 3, 4};
+
+        REQUIRE_THROWS_AS(readOnly.view(), std::logic_error);
+
+        auto readWrite = MappedMatrix<float>{path, 3, 4, MapMode::readWrite};
+
+        readWrite.view()(0, 0) = 100.0f;
+
+        REQUIRE(mapped.constantView()(0, 0) == 100.0f);
+    }
+
+    SECTION("offset")
+    {
+        {
+            auto file = std::ofstream{path, std::ios::binary};
+            const auto header = 12345678LL;
+            const float elements[] = {1.0f, 2.0f, 3.0f, 4.0f};
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(elements), sizeof(elements));
+        }
+
+        const auto mapped = MappedMatrix<float>{path, 2, 2, MapMode::readOnly, sizeof(long long)};
+
+        REQUIRE(close(mapped.constantView(), Matrix<float>{{{1.0f, 2.0f}, {3.0f, 4.0f}}}, 1.0e-6f));
+
+        mapped.adviseRows(AccessPattern::willNeed, 1, 1);
+
+        REQUIRE_THROWS_AS(mapped.adviseRows(AccessPattern::willNeed, 1, 2), std::out_of_range);
+
+        REQUIRE_THROWS_AS((MappedMatrix<float>{path, 3, 2, MapMode::readOnly, sizeof(long long)}), std::out_of_range);
+
+        REQUIRE_THROWS_AS((MappedMatrix<float>{path, 1, 1, MapMode::readOnly, 2}), std::invalid_argument);
+    }
+
+    SECTION("row blocks")
+    {
+        {
+            auto mapped = MappedMatrix<float>::create(path, 4, 2);
+            mapped.rowsView(2, 2).deepCopy(Matrix<float>{{{1.0f, 2.0f}, {3.0f, 4.0f}}});
+        }
+
+        const auto mapped = MappedMatrix<float>{path, 4, 2};
+
+        REQUIRE(close(mapped.constantRowsView(1, 2), Matrix<float>{{{0.0f, 0.0f}, {1.0f, 2.0f}}}, 1.0e-6f));
+
+        REQUIRE(mapped.constantRowsView(4, 0).rowCount() == 0);
+
+        REQUIRE_THROWS_AS(mapped.constantRowsView(3, 2), std::out_of_range);
+
+        REQUIRE_THROWS_AS((MappedMatrix<float>{path, 2, 4, MapMode::readOnly, 0, false, Layout::columnMajor}
+                               .constantRowsView(0, 1)),
+                          std::logic_error);
+    }
+
+    SECTION("more elements than size_type can count")
+    {
+        // The file is sparse, so only the pages that are touched take space.
+        const auto rows = 65536;
+        const auto columns = 32769;
+        {
+            auto mapped = MappedMatrix<float>::create(path, rows, columns);
+
+            REQUIRE_THROWS_AS(mapped.constantView(), std::out_of_range);
+
+            REQUIRE_THROWS_AS(mapped.view(), std::out_of_range);
+
+            mapped.rowsView(rows - 1, 1)(0, columns - 1) = 7.0f;
+        }
+
+        const auto mapped = MappedMatrix<float>{path, rows, columns};
+        const auto last = mapped.constantRowsView(rows - 2, 2);
+
+        REQUIRE(last(1, columns - 1) == 7.0f);
+
+        REQUIRE(last(0, columns - 1) == 0.0f);
+
+        REQUIRE_THROWS_AS((MappedMatrix<float>{path, columns, rows, MapMode::readOnly, 0, false, Layout::columnMajor}),
+                          std::out_of_range);
+    }
+
+    SECTION("k-means")
+    {
+        {
+            auto mapped = MappedMatrix<float>::create(path, 6, 2);
+            mapped.view().deepCopy(Matrix<float>{
+                {{-5.0f, -5.0f}, {5.0f, 5.0f}, {-6.0f, -5.0f}, {6.0f, 5.0f}, {-5.0f, -6.0f}, {5.0f, 6.0f}}});
+        }
+
+        const auto mapped = MappedMatrix<float>{path, 6, 2};
+        auto centroids = Matrix<float>{{{-1.0f, -1.0f}, {1.0f, 1.0f}}};
+
+        const auto labels = kMeans(mapped.constantView(), centroids, 3);
+
+        REQUIRE(labels == std::vector<int>{0, 1, 0, 1, 0, 1});
+
+        REQUIRE(close(centroids, Matrix<float>{{{-16.0f / 3.0f, -16.0f / 3.0f}, {16.0f / 3.0f, 16.0f / 3.0f}}},
+                      1.0e-5f));
+    }
+
+    SECTION("missing file")
+    {
+        REQUIRE_THROWS_AS((MappedMatrix<double>{path + ".missing", 1, 1}), std::runtime_error);
+    }
+
+    std::remove(path.c_str());
+}
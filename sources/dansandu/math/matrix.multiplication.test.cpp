@@ -0,0 +1,239 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+using dansandu::math::matrix::close;
+using dansandu::math::matrix::ConstantMatrixView;
+using dansandu::math::matrix::gemm;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::multiply;
+using dansandu::math::matrix::Slicer;
+using dansandu::math::matrix::Transposition;
+using dansandu::math::matrix::transposed;
+using dansandu::math::thread_pool::Executor;
+using dansandu::math::thread_pool::ThreadPool;
+
+template<typename T>
+static Matrix<T> generate(int rows, int columns, int seed)
+{
+    auto result = Matrix<T>{rows, columns};
+    for (auto i = 0; i < rows; ++i)
+    {
+        for (auto j = 0; j < columns; ++j)
+        {
+            result(i, j) = static_cast<T>((i * 31 + j * 17 + seed * 7) % 11 - 5);
+        }
+    }
+    return result;
+}
+
+template<typename A, typename B>
+static auto naiveProduct(const A& a, const B& b)
+{
+    using T = typename A::value_type;
+    auto result = Matrix<T>{a.rowCount(), b.columnCount()};
+    for (auto i = 0; i < a.rowCount(); ++i)
+    {
+        for (auto j = 0; j < b.columnCount(); ++j)
+        {
+            for (auto p = 0; p < a.columnCount(); ++p)
+            {
+                result(i, j) += a(i, p) * b(p, j);
+            }
+        }
+    }
+    return result;
+}
+
+TEST_CASE("matrix.multiplication")
+{
+    SECTION("blocked integers")
+    {
+        for (const auto& [rows, depth, columns] : {std::make_tuple(1, 1, 1), std::make_tuple(5, 7, 3),
+                                                   std::make_tuple(17, 33, 9), std::make_tuple(130, 300, 270)})
+        {
+            const auto a = generate<int>(rows, depth, 1);
+            const auto b = generate<int>(depth, columns, 2);
+
+            REQUIRE(a * b == naiveProduct(a, b));
+        }
+    }
+
+    SECTION("blocked floating point")
+    {
+        const auto a = generate<double>(67, 260, 3);
+        const auto b = generate<double>(260, 45, 4);
+
+        REQUIRE(close(a * b, naiveProduct(a, b), 1.0e-9));
+    }
+
+    SECTION("strided views")
+    {
+        const auto a = generate<int>(40, 50, 5);
+        const auto b = generate<int>(60, 30, 6);
+
+        const auto left = Slicer<3, 7, 20, 35>::slice(a);
+        const auto right = Slicer<10, 2, 35, 25>::slice(b);
+
+        REQUIRE(left * right == naiveProduct(left, right));
+    }
+
+    SECTION("static with dynamic")
+    {
+        const auto a = Matrix<int, 2, 3>{{{1, 2, 3}, {4, 5, 6}}};
+        const auto b = generate<int>(3, 20, 7);
+
+        REQUIRE(a * b == naiveProduct(a, b));
+    }
+
+    SECTION("parallel results do not depend on the thread count")
+    {
+        auto threadPool = ThreadPool{4};
+        auto a = Matrix<float>{300, 270};
+        auto b = Matrix<float>{270, 310};
+        for (auto i = 0; i < static_cast<int>(a.rowCount() * a.columnCount()); ++i)
+        {
+            a.data()[i] = static_cast<float>(i % 97) / 7.0f - 6.5f;
+        }
+        for (auto i = 0; i < static_cast<int>(b.rowCount() * b.columnCount()); ++i)
+        {
+            b.data()[i] = static_cast<float>(i % 89) / 13.0f - 3.0f;
+        }
+
+        auto expected = Matrix<float>{a.rowCount(), b.columnCount()};
+        multiply(a, b, expected, Executor{threadPool, 1});
+
+        for (const auto threads : {2, 3, 4})
+        {
+            auto actual = Matrix<float>{a.rowCount(), b.columnCount(), 1.0f};
+            multiply(a, b, actual, Executor{threadPool, threads});
+
+            REQUIRE(std::equal(expected.cbegin(), expected.cend(), actual.cbegin()));
+        }
+
+        REQUIRE(std::equal(expected.cbegin(), expected.cend(), (a * b).cbegin()));
+    }
+
+    SECTION("multiply into slice")
+    {
+        const auto a = generate<int>(20, 30, 8);
+        const auto b = generate<int>(30, 25, 9);
+        auto output = Matrix<int>{24, 30};
+
+        multiply(a, b, Slicer<2, 3, 20, 25>::slice(output), Executor::sequential());
+
+        REQUIRE(Slicer<2, 3, 20, 25>::slice(output) == naiveProduct(a, b));
+
+        REQUIRE_THROWS_AS(multiply(a, b, output), std::logic_error);
+    }
+
+    SECTION("gemm with transposed operands")
+    {
+        const auto a = generate<int>(40, 70, 10);
+        const auto b = generate<int>(70, 60, 11);
+        const auto initial = generate<int>(40, 60, 12);
+        const auto expected = Matrix<int>{naiveProduct(a, b) * 3 - initial * 2};
+
+        for (const auto transA : {Transposition::none, Transposition::transposed})
+        {
+            for (const auto transB : {Transposition::none, Transposition::transposed})
+            {
+                const auto storedA = transA == Transposition::transposed ? transposed(a) : a;
+                const auto storedB = transB == Transposition::transposed ? transposed(b) : b;
+                auto c = initial;
+
+                gemm(3, storedA, transA, storedB, transB, -2, c);
+
+                REQUIRE(c == expected);
+            }
+        }
+    }
+
+    SECTION("gemm into slice")
+    {
+        const auto a = generate<double>(50, 30, 13);
+        const auto b = generate<double>(50, 40, 14);
+        auto output = Matrix<double>{60, 60, 1.0};
+        const auto slice = Slicer<5, 10, 30, 40>::slice(output);
+
+        gemm(0.5, a, Transposition::transposed, b, Transposition::none, 1.0, slice);
+
+        REQUIRE(close(slice, naiveProduct(transposed(a), b) * 0.5 + Matrix<double>{30, 40, 1.0}, 1.0e-9));
+
+        REQUIRE(output(0, 0) == 1.0);
+
+        REQUIRE_THROWS_AS(gemm(1.0, a, Transposition::none, b, Transposition::none, 0.0, slice), std::logic_error);
+    }
+
+    SECTION("matrix with vector")
+    {
+        auto threadPool = ThreadPool{4};
+        for (const auto& [rows, depth] : {std::make_tuple(7, 5), std::make_tuple(70, 90), std::make_tuple(700, 600)})
+        {
+            const auto a = generate<int>(rows, depth, 15);
+            const auto x = generate<int>(depth, 1, 16);
+            const auto v = generate<int>(1, rows, 17);
+            const auto expectedColumn = naiveProduct(a, x);
+            const auto expectedRow = naiveProduct(v, a);
+
+            REQUIRE(a * x == expectedColumn);
+
+            REQUIRE(v * a == expectedRow);
+
+            auto column = Matrix<int>{rows, 1};
+            auto row = Matrix<int>{1, depth};
+            for (const auto threads : {1, 4})
+            {
+                gemm(1, transposed(a), Transposition::transposed, x, Transposition::none, 0, column,
+                     Executor{threadPool, threads});
+
+                REQUIRE(column == expectedColumn);
+
+                gemm(1, v, Transposition::none, transposed(a), Transposition::transposed, 0, row,
+                     Executor{threadPool, threads});
+
+                REQUIRE(row == expectedRow);
+            }
+        }
+    }
+
+    SECTION("matrix with strided vector")
+    {
+        const auto a = generate<float>(40, 30, 18);
+        const auto b = generate<float>(30, 30, 19);
+        const auto x = ConstantMatrixView<float>{Slicer<0, 4, 30, 1>::slice(b)};
+        auto output = Matrix<float>{40, 3};
+        const auto y = Slicer<0, 1, 40, 1>::slice(output);
+
+        gemm(2.0f, a, Transposition::none, x, Transposition::none, 0.0f, y);
+
+        REQUIRE(close(y, naiveProduct(a, x) * 2.0f, 1.0e-3f));
+
+        REQUIRE(close(transposed(x) * transposed(a), transposed(naiveProduct(a, x)), 1.0e-3f));
+    }
+
+    SECTION("gemm overwrites the output when beta is zero")
+    {
+        const auto nan = std::numeric_limits<double>::quiet_NaN();
+        for (const auto& [rows, depth, columns] : {std::make_tuple(3, 4, 5), std::make_tuple(60, 50, 1),
+                                                   std::make_tuple(1, 50, 60), std::make_tuple(90, 80, 70)})
+        {
+            const auto a = generate<double>(rows, depth, 20);
+            const auto b = generate<double>(depth, columns, 21);
+            auto c = Matrix<double>{rows, columns, nan};
+
+            gemm(2.0, a, Transposition::none, b, Transposition::none, 0.0, c);
+
+            REQUIRE(close(c, naiveProduct(a, b) * 2.0, 1.0e-9));
+
+            gemm(0.0, a, Transposition::none, b, Transposition::none, -1.0, c);
+
+            REQUIRE(close(c, naiveProduct(a, b) * -2.0, 1.0e-9));
+        }
+    }
+}
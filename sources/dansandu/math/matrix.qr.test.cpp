@@ -0,0 +1,153 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/math/matrix.test_helpers.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using dansandu::math::matrix::applyQ;
+using dansandu::math::matrix::close;
+using dansandu::math::matrix::getQ;
+using dansandu::math::matrix::getR;
+using dansandu::math::matrix::leastSquares;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::Pivoting;
+using dansandu::math::matrix::qrDecompose;
+using dansandu::math::matrix::sliceColumn;
+using dansandu::math::matrix::testing::getRandomMatrix;
+using dansandu::math::matrix::testing::isOrthonormal;
+using dansandu::math::matrix::Transposition;
+using dansandu::math::thread_pool::Executor;
+using dansandu::math::thread_pool::ThreadPool;
+
+static double getNorm(const Matrix<double>& matrix)
+{
+    return std::sqrt(std::inner_product(matrix.cbegin(), matrix.cend(), matrix.cbegin(), 0.0));
+}
+
+template<typename Q, typename R>
+static Matrix<double> getPermutedProduct(const Q& q, const R& r, const std::vector<int>& permutation)
+{
+    const auto product = q * r;
+    auto result = Matrix<double>{product.rowCount(), product.columnCount(), 0.0};
+    for (auto column = 0; column < product.columnCount(); ++column)
+    {
+        sliceColumn(result, permutation[column]).deepCopy(sliceColumn(product, column));
+    }
+    return result;
+}
+
+TEST_CASE("matrix.qr")
+{
+    SECTION("small matrix")
+    {
+        const auto a = Matrix<double>{{{12.0, -51.0, 4.0}, {6.0, 167.0, -68.0}, {-4.0, 24.0, -41.0}}};
+        const auto qr = qrDecompose(a);
+        const auto q = getQ(qr);
+        const auto r = getR(qr);
+
+        REQUIRE(close(q * r, a, 1.0e-10));
+
+        REQUIRE(isOrthonormal(q, 1.0e-12));
+
+        REQUIRE(std::abs(r(0, 0)) == Approx(14.0));
+
+        REQUIRE(std::abs(r(1, 1)) == Approx(175.0));
+
+        REQUIRE(std::abs(r(2, 2)) == Approx(35.0));
+
+        REQUIRE(r(2, 0) == 0.0);
+    }
+
+    SECTION("blocked factorization")
+    {
+        auto pool = ThreadPool{4};
+        const auto executor = Executor{pool, 4};
+        const auto a = getRandomMatrix(300, 90, 3);
+        const auto qr = qrDecompose(a, Pivoting::none, executor);
+        const auto q = getQ(qr, executor);
+
+        REQUIRE(q.rowCount() == 300);
+
+        REQUIRE(q.columnCount() == 90);
+
+        REQUIRE(close(q * getR(qr), a, 1.0e-10));
+
+        REQUIRE(isOrthonormal(q, 1.0e-12));
+
+        auto b = getRandomMatrix(300, 4, 5);
+        const auto original = b;
+        applyQ(qr, Transposition::transposed, b, executor);
+        applyQ(qr, Transposition::none, b, executor);
+
+        REQUIRE(close(b, original, 1.0e-12));
+
+        const auto wide = getRandomMatrix(70, 150, 7);
+        const auto wideQr = qrDecompose(wide, Pivoting::none, executor);
+
+        REQUIRE(close(getQ(wideQr) * getR(wideQr), wide, 1.0e-10));
+    }
+
+    SECTION("column pivoting")
+    {
+        auto a = getRandomMatrix(120, 60, 11);
+        for (auto row = 0; row < a.rowCount(); ++row)
+        {
+            a(row, 3) = a(row, 0) + a(row, 1);
+            a(row, 40) = 2.0 * a(row, 2);
+        }
+        const auto qr = qrDecompose(a, Pivoting::column);
+        const auto r = getR(qr);
+
+        REQUIRE(close(getPermutedProduct(getQ(qr), r, qr.permutation), a, 1.0e-10));
+
+        for (auto i = 1; i < r.rowCount(); ++i)
+        {
+            REQUIRE(std::abs(r(i, i)) <= std::abs(r(i - 1, i - 1)) + 1.0e-12);
+        }
+
+        REQUIRE(std::abs(r(57, 57)) > 1.0e-3);
+
+        REQUIRE(std::abs(r(58, 58)) < 1.0e-10);
+    }
+
+    SECTION("least squares")
+    {
+        const auto a = getRandomMatrix(400, 20, 13);
+        const auto expected = getRandomMatrix(20, 3, 17);
+        const auto b = Matrix<double>{a * expected};
+
+        REQUIRE(close(leastSquares(a, b), expected, 1.0e-10));
+
+        REQUIRE(close(leastSquares(a, b, Pivoting::column), expected, 1.0e-10));
+
+        const auto line = Matrix<double>{{{1.0, 0.0}, {1.0, 1.0}, {1.0, 2.0}}};
+
+        REQUIRE(close(leastSquares(line, Matrix<double>{{1.0, 2.0, 2.0}}), Matrix<double>{{7.0 / 6.0, 0.5}}, 1.0e-12));
+
+        auto deficient = a;
+        for (auto row = 0; row < deficient.rowCount(); ++row)
+        {
+            deficient(row, 5) = deficient(row, 4);
+        }
+        const auto x = leastSquares(deficient, b, Pivoting::column);
+        const auto residual = Matrix<double>{deficient * x - b};
+        const auto reference = Matrix<double>{deficient * expected - b};
+
+        REQUIRE(x(4, 0) * x(5, 0) == 0.0);
+
+        REQUIRE(getNorm(residual) <= getNorm(reference) + 1.0e-9);
+
+        REQUIRE_THROWS_AS(leastSquares(Matrix<double>{{{1.0, 2.0}, {2.0, 4.0}}}, Matrix<double>{{1.0, 1.0}}),
+                          std::logic_error);
+
+        REQUIRE_THROWS_AS(leastSquares(getRandomMatrix(2, 3, 1), Matrix<double>{{1.0, 1.0}}), std::logic_error);
+
+        REQUIRE(close(getRandomMatrix(2, 3, 1) * leastSquares(getRandomMatrix(2, 3, 1), Matrix<double>{{1.0, 1.0}},
+                                                              Pivoting::column),
+                      Matrix<double>{{1.0, 1.0}}, 1.0e-12));
+    }
+}
@@ -0,0 +1,168 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/math/matrix.test_helpers.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+
+using dansandu::math::matrix::close;
+using dansandu::math::matrix::CsrMatrix;
+using dansandu::math::matrix::mapMatrixFile;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::randomizedSvd;
+using dansandu::math::matrix::randomizedSvdOfFile;
+using dansandu::math::matrix::RandomizedSvdOptions;
+using dansandu::math::matrix::singularValues;
+using dansandu::math::matrix::testing::getDiagonalMatrix;
+using dansandu::math::matrix::testing::getRandomMatrix;
+using dansandu::math::matrix::testing::isOrthonormal;
+using dansandu::math::matrix::transposedView;
+using dansandu::math::matrix::writeMatrixFile;
+using dansandu::math::thread_pool::Executor;
+using dansandu::math::thread_pool::ThreadPool;
+
+// Builds a matrix with the singular values 2^-i and a little noise on top.
+static Matrix<double> getDecayingMatrix(int rows, int columns, unsigned seed)
+{
+    const auto u = getRandomMatrix(rows, columns, seed);
+    const auto v = getRandomMatrix(columns, columns, seed + 1);
+    auto values = Matrix<double>{columns, 1, 0.0};
+    for (auto j = 0; j < columns; ++j)
+    {
+        values(j, 0) = 100.0 / static_cast<double>(1 << std::min(j, 20));
+    }
+    const auto noise = getRandomMatrix(rows, columns, seed + 2);
+    return Matrix<double>{u * getDiagonalMatrix(values) * Matrix<double>{transposedView(v)} + noise * 1.0e-6};
+}
+
+static Matrix<double> getTopValues(const Matrix<double>& a, int rank)
+{
+    const auto values = singularValues(a);
+    auto top = Matrix<double>{rank, 1, 0.0};
+    for (auto i = 0; i < rank; ++i)
+    {
+        top(i, 0) = values(i, 0);
+    }
+    return top;
+}
+
+static bool isTriplet(const Matrix<double>& a, const Matrix<double>& u, const Matrix<double>& values,
+                      const Matrix<double>& v, double epsilon)
+{
+    return close(a * v, u * getDiagonalMatrix(values), epsilon);
+}
+
+TEST_CASE("matrix.randomized_svd")
+{
+    auto pool = ThreadPool{4};
+    const auto executor = Executor{pool, 4};
+    const auto a = getDecayingMatrix(300, 60, 3);
+    const auto rank = 8;
+    const auto expected = getTopValues(a, rank);
+
+    SECTION("dense matrix")
+    {
+        const auto svd = randomizedSvd(a, rank, RandomizedSvdOptions{}, executor);
+
+        REQUIRE(svd.u.rowCount() == 300);
+
+        REQUIRE(svd.u.columnCount() == rank);
+
+        REQUIRE(svd.v.rowCount() == 60);
+
+        REQUIRE(svd.v.columnCount() == rank);
+
+        REQUIRE(close(svd.values, expected, 1.0e-8));
+
+        REQUIRE(isOrthonormal(svd.u));
+
+        REQUIRE(isOrthonormal(svd.v));
+
+        REQUIRE(isTriplet(a, svd.u, svd.values, svd.v, 1.0e-5));
+
+        const auto wide = randomizedSvd(transposedView(a), rank);
+
+        REQUIRE(close(wide.values, expected, 1.0e-8));
+
+        REQUIRE(wide.u.rowCount() == 60);
+    }
+
+    SECTION("exact low rank")
+    {
+        const auto left = getRandomMatrix(200, 5, 7);
+        const auto right = getRandomMatrix(40, 5, 8);
+        const auto lowRank = Matrix<double>{left * Matrix<double>{transposedView(right)}};
+        auto options = RandomizedSvdOptions{};
+        options.oversampling = 0;
+        options.powerIterations = 0;
+        const auto svd = randomizedSvd(lowRank, 5, options);
+
+        REQUIRE(close(svd.values, getTopValues(lowRank, 5), 1.0e-9));
+
+        REQUIRE(isTriplet(lowRank, svd.u, svd.values, svd.v, 1.0e-9));
+    }
+
+    SECTION("sparse matrix")
+    {
+        auto sparse = Matrix<double>{a};
+        for (auto i = 0; i < sparse.rowCount(); ++i)
+        {
+            for (auto j = 0; j < sparse.columnCount(); ++j)
+            {
+                if ((i + j) % 3 != 0)
+                {
+                    sparse(i, j) = 0.0;
+                }
+            }
+        }
+        const auto svd = randomizedSvd(CsrMatrix<double>{sparse}, rank, RandomizedSvdOptions{}, executor);
+
+        REQUIRE(close(svd.values, getTopValues(sparse, rank), 1.0e-6));
+
+        REQUIRE(isOrthonormal(svd.u));
+    }
+
+    SECTION("mapped and streamed files")
+    {
+        const auto path = (std::filesystem::temp_directory_path() / "dansandu_math_randomized_svd.test.bin").string();
+        writeMatrixFile(path, a);
+        auto options = RandomizedSvdOptions{};
+        options.chunkRows = 64;
+
+        {
+            const auto mapped = mapMatrixFile<double>(path);
+            const auto svd = randomizedSvd(mapped, rank, options, executor);
+
+            REQUIRE(close(svd.values, expected, 1.0e-8));
+        }
+
+        const auto streamed = randomizedSvdOfFile<double>(path, rank, options, executor);
+
+        REQUIRE(close(streamed.values, expected, 1.0e-8));
+
+        REQUIRE(isTriplet(a, streamed.u, streamed.values, streamed.v, 1.0e-5));
+
+        REQUIRE(close(streamed.values, randomizedSvd(a, rank, options).values, 1.0e-10));
+
+        options.chunkRows = 0;
+
+        REQUIRE_THROWS_AS(randomizedSvdOfFile<double>(path, rank, options), std::invalid_argument);
+
+        std::remove(path.c_str());
+    }
+
+    SECTION("invalid arguments")
+    {
+        REQUIRE_THROWS_AS(randomizedSvd(a, 0), std::invalid_argument);
+
+        REQUIRE_THROWS_AS(randomizedSvd(a, 61), std::invalid_argument);
+
+        auto options = RandomizedSvdOptions{};
+        options.powerIterations = -1;
+
+        REQUIRE_THROWS_AS(randomizedSvd(a, 5, options), std::invalid_argument);
+    }
+}
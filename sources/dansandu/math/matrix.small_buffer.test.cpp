@@ -0,0 +1,207 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+using dansandu::math::matrix::AlignedVector;
+using dansandu::math::matrix::Arena;
+using dansandu::math::matrix::ArenaScope;
+using dansandu::math::matrix::DataStorageStrategy;
+using dansandu::math::matrix::dynamic;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::MatrixImplementation;
+using dansandu::math::matrix::size_type;
+using dansandu::math::matrix::smallBufferLength;
+using dansandu::math::matrix::transposeInPlace;
+
+template<typename M>
+static bool isInline(const M& matrix)
+{
+    const auto begin = reinterpret_cast<const char*>(&matrix);
+    const auto data = reinterpret_cast<const char*>(matrix.data());
+    return data >= begin && data < begin + sizeof(matrix);
+}
+
+#if DANSANDU_MATH_SMALL_BUFFER_BYTES > 0
+template<DataStorageStrategy S>
+static double measureNanoseconds(size_type length, int iterations)
+{
+    using Vector = MatrixImplementation<float, dynamic, dynamic, S>;
+
+    const auto a = Vector{length, 1, 1.0f};
+    auto sum = 0.0f;
+    const auto start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < iterations; ++i)
+    {
+        const auto b = Vector{length, 1, static_cast<float>(i)};
+        const auto c = Vector{a + b};
+        sum += dotProduct(c, a);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    REQUIRE(sum != 0.0f);
+    return std::chrono::duration<double, std::nano>{elapsed}.count() / iterations;
+}
+#endif
+
+TEST_CASE("matrix.small_buffer")
+{
+    SECTION("strategy")
+    {
+        constexpr auto bufferLength = static_cast<size_type>(DANSANDU_MATH_SMALL_BUFFER_BYTES / sizeof(float));
+        constexpr auto dynamicStrategy =
+            bufferLength > 0 ? DataStorageStrategy::smallBuffer : DataStorageStrategy::heap;
+        constexpr auto getStaticStrategy = [](size_type elements)
+        {
+            return elements * sizeof(float) > static_cast<std::size_t>(DANSANDU_MATH_STACK_BYTES)
+                       ? DataStorageStrategy::heap
+                       : DataStorageStrategy::stack;
+        };
+
+        REQUIRE(smallBufferLength<float> == bufferLength);
+
+        REQUIRE(Matrix<float>::dataStorageStrategy == dynamicStrategy);
+
+        REQUIRE(Matrix<float, dynamic, 3>::dataStorageStrategy == dynamicStrategy);
+
+        REQUIRE(Matrix<float, 2, 2>::dataStorageStrategy == getStaticStrategy(4));
+
+        REQUIRE(Matrix<float, 3, 3>::dataStorageStrategy == getStaticStrategy(9));
+    }
+
+#if DANSANDU_MATH_SMALL_BUFFER_BYTES > 0
+    SECTION("inline and heap storage")
+    {
+        const auto length = smallBufferLength<float>;
+        const auto small = Matrix<float>{length, 1, 2.0f};
+        const auto large = Matrix<float>{length + 1, 1, 1.0f};
+
+        REQUIRE(isInline(small));
+
+        REQUIRE(!isInline(large));
+
+        REQUIRE(small(length - 1, 0) == 2.0f);
+
+        REQUIRE(large(length, 0) == 1.0f);
+
+        REQUIRE(close(small + small, Matrix<float>{length, 1, 4.0f}, 1.0e-6f));
+
+        REQUIRE(close(large * 2.0f, Matrix<float>{length + 1, 1, 2.0f}, 1.0e-6f));
+    }
+
+    SECTION("copy and move")
+    {
+        const auto small = Matrix<int>{{{1, 2}, {3, 4}}};
+        const auto large = Matrix<int>{smallBufferLength<int> + 1, 1, 7};
+
+        auto copy = small;
+
+        REQUIRE(copy == small);
+
+        REQUIRE(copy.data() != small.data());
+
+        copy = large;
+
+        REQUIRE(copy == large);
+
+        REQUIRE(!isInline(copy));
+
+        copy = small;
+
+        REQUIRE(copy == small);
+
+        REQUIRE(isInline(copy));
+
+        auto moved = Matrix<int>{std::move(copy)};
+
+        REQUIRE(moved == small);
+
+        REQUIRE(isInline(moved));
+
+        REQUIRE(copy.rowCount() == 0);
+
+        auto heap = Matrix<int>{large};
+        const auto storage = heap.data();
+
+        moved = std::move(heap);
+
+        REQUIRE(moved == large);
+
+        REQUIRE(moved.data() == storage);
+
+        REQUIRE(heap.rowCount() == 0);
+
+        auto arena = Arena{};
+        {
+            const auto scope = ArenaScope{arena};
+            const auto stolen = Matrix<int>{std::move(moved)};
+
+            REQUIRE(stolen.data() == storage);
+
+            REQUIRE(arena.used() == 0);
+
+            moved = stolen;
+        }
+
+        moved = Matrix<int>{{5, 6}};
+
+        REQUIRE(moved == Matrix<int>{{5, 6}});
+
+        REQUIRE(isInline(moved));
+    }
+
+    SECTION("adopted buffers stay on the heap")
+    {
+        auto buffer = AlignedVector<double>{1.0, 2.0};
+        const auto storage = buffer.data();
+        const auto matrix = Matrix<double>{1, 2, std::move(buffer)};
+
+        REQUIRE(matrix.data() == storage);
+
+        REQUIRE_THROWS_AS((Matrix<double>{2, 2, AlignedVector<double>{1.0}}), std::out_of_range);
+    }
+
+    SECTION("reshape and transpose in place")
+    {
+        auto matrix = Matrix<int>{{{1, 2, 3}, {4, 5, 6}}};
+
+        transposeInPlace(matrix);
+
+        REQUIRE(matrix == Matrix<int>{{{1, 4}, {2, 5}, {3, 6}}});
+
+        matrix.reshape(1, 6);
+
+        REQUIRE(matrix == Matrix<int>{{{1, 4, 2, 5, 3, 6}}});
+
+        REQUIRE_THROWS_AS(matrix.reshape(4, 2), std::out_of_range);
+    }
+#endif
+}
+
+#if DANSANDU_MATH_SMALL_BUFFER_BYTES > 0
+// Times building and combining short dynamic vectors with the small buffer against plain heap storage at lengths
+// around smallBufferLength, where the small buffer stops paying off. Rebuild with another
+// DANSANDU_MATH_SMALL_BUFFER_BYTES to compare thresholds. Run explicitly with the [benchmark] tag.
+TEST_CASE("matrix.small_buffer.benchmark", "[.][benchmark]")
+{
+    const auto iterations = 1000000;
+    const auto threshold = smallBufferLength<float>;
+    std::cout << "small buffer of " << threshold << " floats\n";
+    std::cout << std::setw(8) << "length" << std::setw(12) << "heap ns" << std::setw(12) << "buffer ns" << "\n";
+    for (const auto length : {1, threshold / 4, threshold / 2, threshold - 1, threshold, threshold + 1, 2 * threshold,
+                              4 * threshold})
+    {
+        if (length <= 0)
+        {
+            continue;
+        }
+        const auto heap = measureNanoseconds<DataStorageStrategy::heap>(length, iterations);
+        const auto smallBuffer = measureNanoseconds<DataStorageStrategy::smallBuffer>(length, iterations);
+        std::cout << std::setw(8) << length << std::fixed << std::setprecision(1) << std::setw(12) << heap
+                  << std::setw(12) << smallBuffer << "\n";
+    }
+}
+#endif
@@ -0,0 +1,180 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using dansandu::math::matrix::Arena;
+using dansandu::math::matrix::ArenaScope;
+using dansandu::math::matrix::close;
+using dansandu::math::matrix::CscMatrix;
+using dansandu::math::matrix::CsrMatrix;
+using dansandu::math::matrix::gemm;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::multiply;
+using dansandu::math::matrix::Transposition;
+using dansandu::math::matrix::transposedView;
+using dansandu::math::thread_pool::Executor;
+using dansandu::math::thread_pool::ThreadPool;
+
+static Matrix<double> getSparseDenseMatrix(int rows, int columns, double density, unsigned seed)
+{
+    auto generator = std::minstd_rand{seed};
+    auto value = std::uniform_real_distribution<double>{-1.0, 1.0};
+    auto keep = std::bernoulli_distribution{density};
+    auto matrix = Matrix<double>{rows, columns, 0.0};
+    for (auto row = 0; row < rows; ++row)
+    {
+        for (auto column = 0; column < columns; ++column)
+        {
+            if (keep(generator))
+            {
+                matrix(row, column) = value(generator);
+            }
+        }
+    }
+    return matrix;
+}
+
+TEST_CASE("matrix.sparse")
+{
+    const auto dense = Matrix<int>{{{0, 2, 0, 0}, {1, 0, 0, 3}, {0, 0, 0, 0}}};
+
+    SECTION("triplets")
+    {
+        const auto csr = CsrMatrix<int>{3, 4, {{1, 3, 1}, {0, 1, 2}, {1, 0, 1}, {1, 3, 2}}};
+
+        REQUIRE(csr.nonZeroCount() == 3);
+
+        REQUIRE(csr.offsets() == std::vector<std::size_t>{0, 1, 3, 3});
+
+        REQUIRE(csr.indices() == std::vector<int>{1, 0, 3});
+
+        REQUIRE(csr.values() == std::vector<int>{2, 1, 3});
+
+        REQUIRE(csr.toDense() == dense);
+
+        REQUIRE(csr(1, 3) == 3);
+
+        REQUIRE(csr(2, 2) == 0);
+
+        REQUIRE_THROWS_AS(csr(3, 0), std::out_of_range);
+
+        const auto csc = CscMatrix<int>{3, 4, {{1, 3, 3}, {0, 1, 2}, {1, 0, 1}}};
+
+        REQUIRE(csc.offsets() == std::vector<std::size_t>{0, 1, 2, 2, 3});
+
+        REQUIRE(csc.indices() == std::vector<int>{1, 0, 1});
+
+        REQUIRE(csc.toDense() == dense);
+
+        REQUIRE_THROWS_AS((CsrMatrix<int>{3, 4, {{3, 0, 1}}}), std::out_of_range);
+    }
+
+    SECTION("conversions")
+    {
+        const auto csr = CsrMatrix<int>{dense};
+        const auto csc = CscMatrix<int>{dense};
+
+        REQUIRE(csr.nonZeroCount() == 3);
+
+        REQUIRE(CscMatrix<int>{csr}.indices() == csc.indices());
+
+        REQUIRE(CsrMatrix<int>{csc}.offsets() == csr.offsets());
+
+        REQUIRE(transposed(csr).toDense() == Matrix<int>{transposedView(dense)});
+
+        REQUIRE(CsrMatrix<int>{transposedView(dense)}.toDense() == Matrix<int>{transposedView(dense)});
+
+        REQUIRE(CsrMatrix<int>{}.toDense().rowCount() == 0);
+    }
+
+    SECTION("compressed arrays")
+    {
+        const auto csr = CsrMatrix<int>{3, 4, {0, 1, 3, 3}, {1, 0, 3}, {2, 1, 3}};
+
+        REQUIRE(csr.toDense() == dense);
+
+        REQUIRE_THROWS_AS((CsrMatrix<int>{3, 4, {0, 1, 3}, {1, 0, 3}, {2, 1, 3}}), std::invalid_argument);
+
+        REQUIRE_THROWS_AS((CsrMatrix<int>{3, 4, {0, 1, 3, 3}, {1, 3, 0}, {2, 1, 3}}), std::invalid_argument);
+
+        REQUIRE_THROWS_AS((CsrMatrix<int>{3, 4, {0, 1, 3, 3}, {1, 0, 4}, {2, 1, 3}}), std::invalid_argument);
+    }
+
+    SECTION("products")
+    {
+        const auto b = Matrix<int>{{{1, 2}, {3, 4}, {5, 6}, {7, 8}}};
+        const auto expected = Matrix<int>{{{6, 8}, {22, 26}, {0, 0}}};
+
+        REQUIRE(CsrMatrix<int>{dense} * b == expected);
+
+        REQUIRE(CscMatrix<int>{dense} * b == expected);
+
+        REQUIRE(CsrMatrix<int>{dense} * Matrix<int>{{1, 1, 1, 1}} == Matrix<int>{{2, 4, 0}});
+
+        auto output = Matrix<int>{3, 2, 1};
+        gemm(2, CsrMatrix<int>{dense}, Transposition::none, b, Transposition::none, 3, output);
+
+        REQUIRE(output == Matrix<int>{{{15, 19}, {47, 55}, {3, 3}}});
+
+        auto transposedOutput = Matrix<int>{2, 3, 0};
+        multiply(CscMatrix<int>{dense}, b, transposedView(transposedOutput));
+
+        REQUIRE(transposedOutput == Matrix<int>{transposedView(expected)});
+
+        auto product = Matrix<int>{4, 2, 0};
+        gemm(1, CsrMatrix<int>{dense}, Transposition::transposed, Matrix<int>{{{1, 0}, {0, 1}, {1, 1}}},
+             Transposition::none, 0, product);
+
+        REQUIRE(product == Matrix<int>{{{0, 1}, {2, 0}, {0, 0}, {0, 3}}});
+
+        REQUIRE_THROWS_AS((CsrMatrix<int>{dense} * Matrix<int>{3, 1, 1}), std::logic_error);
+    }
+
+    SECTION("parallel products")
+    {
+        auto pool = ThreadPool{4};
+        const auto executor = Executor{pool, 4};
+        const auto a = getSparseDenseMatrix(500, 700, 0.05, 7);
+        const auto b = getSparseDenseMatrix(700, 33, 1.0, 11);
+        const auto x = getSparseDenseMatrix(700, 1, 1.0, 13);
+        const auto expected = a * b;
+        const auto expectedVector = a * x;
+
+        auto output = Matrix<double>{500, 33, 0.0};
+        multiply(CsrMatrix<double>{a}, b, output, executor);
+
+        REQUIRE(close(output, expected, 1.0e-9));
+
+        multiply(CscMatrix<double>{a}, b, output, executor);
+
+        REQUIRE(close(output, expected, 1.0e-9));
+
+        auto vector = Matrix<double>{500, 1, 0.0};
+        multiply(CsrMatrix<double>{a}, x, vector, executor);
+
+        REQUIRE(close(vector, expectedVector, 1.0e-9));
+
+        multiply(CscMatrix<double>{a}, x, vector, Executor::sequential());
+
+        REQUIRE(close(vector, expectedVector, 1.0e-9));
+
+        auto transposedProduct = Matrix<double>{700, 33, 0.0};
+        gemm(1.0, CsrMatrix<double>{a}, Transposition::transposed, Matrix<double>{500, 33, 1.0}, Transposition::none,
+             0.0, transposedProduct, executor);
+
+        REQUIRE(close(transposedProduct, Matrix<double>{transposedView(a)} * Matrix<double>{500, 33, 1.0}, 1.0e-9));
+
+        auto arena = Arena{};
+        {
+            const auto scope = ArenaScope{arena};
+            auto accumulated = Matrix<double>{500, 33, 1.0};
+            gemm(2.0, CscMatrix<double>{a}, Transposition::none, b, Transposition::none, 3.0, accumulated, executor);
+
+            REQUIRE(close(accumulated, Matrix<double>{expected * 2.0 + Matrix<double>{500, 33, 3.0}}, 1.0e-9));
+        }
+    }
+}
@@ -0,0 +1,183 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/math/matrix.test_helpers.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <cmath>
+
+using dansandu::math::matrix::close;
+using dansandu::math::matrix::ConstantMatrixView;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::singularValueDecompose;
+using dansandu::math::matrix::singularValues;
+using dansandu::math::matrix::SvdMode;
+using dansandu::math::matrix::symmetricEigenvalues;
+using dansandu::math::matrix::testing::getDiagonalMatrix;
+using dansandu::math::matrix::testing::getRandomMatrix;
+using dansandu::math::matrix::testing::isOrthonormal;
+using dansandu::math::matrix::transposedView;
+using dansandu::math::matrix::unsafeSlice;
+using dansandu::math::thread_pool::Executor;
+using dansandu::math::thread_pool::ThreadPool;
+
+static Matrix<double> getReconstruction(const Matrix<double>& u, const Matrix<double>& values,
+                                        const Matrix<double>& v)
+{
+    const auto rank = values.rowCount();
+    const auto left = Matrix<double>{unsafeSlice(u, 0, 0, u.rowCount(), rank)};
+    const auto right = Matrix<double>{unsafeSlice(v, 0, 0, v.rowCount(), rank)};
+    return left * getDiagonalMatrix(values) * Matrix<double>{transposedView(right)};
+}
+
+TEST_CASE("matrix.svd")
+{
+    SECTION("small matrix")
+    {
+        const auto a = Matrix<double>{{{3.0, 0.0}, {4.0, 5.0}}};
+        const auto svd = singularValueDecompose(a);
+
+        REQUIRE(close(svd.values, Matrix<double>{{std::sqrt(45.0), std::sqrt(5.0)}}, 1.0e-12));
+
+        REQUIRE(close(getReconstruction(svd.u, svd.values, svd.v), a, 1.0e-12));
+
+        REQUIRE(isOrthonormal(svd.u));
+
+        REQUIRE(isOrthonormal(svd.v));
+
+        REQUIRE(close(singularValues(a), svd.values, 1.0e-12));
+    }
+
+    SECTION("tall matrix")
+    {
+        auto pool = ThreadPool{4};
+        const auto executor = Executor{pool, 4};
+        const auto a = getRandomMatrix(500, 70, 3);
+
+        const auto thin = singularValueDecompose(a, SvdMode::thin, executor);
+
+        REQUIRE(thin.u.rowCount() == 500);
+
+        REQUIRE(thin.u.columnCount() == 70);
+
+        REQUIRE(thin.v.rowCount() == 70);
+
+        REQUIRE(thin.v.columnCount() == 70);
+
+        REQUIRE(isOrthonormal(thin.u));
+
+        REQUIRE(isOrthonormal(thin.v));
+
+        REQUIRE(close(getReconstruction(thin.u, thin.values, thin.v), a, 1.0e-10));
+
+        for (auto i = 1; i < thin.values.rowCount(); ++i)
+        {
+            REQUIRE(thin.values(i - 1, 0) >= thin.values(i, 0));
+        }
+
+        auto squaredValues = Matrix<double>{70, 1, 0.0};
+        for (auto i = 0; i < 70; ++i)
+        {
+            squaredValues(69 - i, 0) = thin.values(i, 0) * thin.values(i, 0);
+        }
+
+        REQUIRE(close(symmetricEigenvalues(Matrix<double>{transposedView(a)} * a), squaredValues, 1.0e-9));
+
+        const auto full = singularValueDecompose(a, SvdMode::full, executor);
+
+        REQUIRE(full.u.columnCount() == 500);
+
+        REQUIRE(isOrthonormal(full.u));
+
+        REQUIRE(close(getReconstruction(full.u, full.values, full.v), a, 1.0e-10));
+
+        const auto values = singularValueDecompose(a, SvdMode::valuesOnly, executor);
+
+        REQUIRE(values.u.rowCount() == 0);
+
+        REQUIRE(close(values.values, thin.values, 1.0e-10));
+    }
+
+    SECTION("wide and view inputs")
+    {
+        const auto a = getRandomMatrix(30, 45, 5);
+        const auto view = ConstantMatrixView<double>{a};
+        const auto thin = singularValueDecompose(view);
+
+        REQUIRE(thin.u.rowCount() == 30);
+
+        REQUIRE(thin.u.columnCount() == 30);
+
+        REQUIRE(thin.v.rowCount() == 45);
+
+        REQUIRE(thin.v.columnCount() == 30);
+
+        REQUIRE(close(getReconstruction(thin.u, thin.values, thin.v), a, 1.0e-10));
+
+        const auto full = singularValueDecompose(transposedView(a), SvdMode::full);
+
+        REQUIRE(full.u.rowCount() == 45);
+
+        REQUIRE(full.u.columnCount() == 45);
+
+        REQUIRE(isOrthonormal(full.u));
+
+        REQUIRE(close(full.values, thin.values, 1.0e-10));
+    }
+
+    SECTION("rank deficient matrix")
+    {
+        auto a = getRandomMatrix(40, 10, 7);
+        for (auto row = 0; row < a.rowCount(); ++row)
+        {
+            a(row, 3) = a(row, 1) - a(row, 2);
+            a(row, 9) = 0.0;
+        }
+        const auto svd = singularValueDecompose(a);
+
+        REQUIRE(svd.values(8, 0) < 1.0e-10);
+
+        REQUIRE(svd.values(9, 0) < 1.0e-10);
+
+        REQUIRE(isOrthonormal(svd.u));
+
+        REQUIRE(isOrthonormal(svd.v));
+
+        REQUIRE(close(getReconstruction(svd.u, svd.values, svd.v), a, 1.0e-10));
+
+        REQUIRE(close(singularValues(Matrix<double>{3, 2, 0.0}), Matrix<double>{2, 1, 0.0}, 1.0e-12));
+    }
+
+    SECTION("null direction spread over every coordinate")
+    {
+        // The columns sum to zero, so the missing left vector is ones / sqrt(8) and no unit vector is close to it.
+        auto a = Matrix<double>{8, 8, 0.0};
+        for (auto column = 0; column < a.columnCount(); ++column)
+        {
+            for (auto row = 0; row < column; ++row)
+            {
+                a(row, column) = static_cast<double>((row + column) % 3 + 1);
+                a(column, column) -= a(row, column);
+            }
+        }
+
+        for (const auto mode : {SvdMode::thin, SvdMode::full})
+        {
+            const auto svd = singularValueDecompose(a, mode);
+
+            REQUIRE(svd.values(6, 0) > 1.0e-3);
+
+            REQUIRE(svd.values(7, 0) < 1.0e-10);
+
+            REQUIRE(isOrthonormal(svd.u));
+
+            REQUIRE(isOrthonormal(svd.v));
+
+            REQUIRE(close(getReconstruction(svd.u, svd.values, svd.v), a, 1.0e-10));
+
+            for (auto row = 0; row < a.rowCount(); ++row)
+            {
+                REQUIRE(std::abs(svd.u(row, 7) - svd.u(0, 7)) < 1.0e-10);
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "dansandu/math/matrix.hpp"
+
+#include <random>
+
+// Fixtures shared by the matrix test cases. Only the test sources include this header.
+namespace dansandu::math::matrix::testing
+{
+
+// Returns a matrix with elements drawn uniformly from [-1, 1), the same for the same seed.
+template<typename T = double>
+Matrix<T> getRandomMatrix(int rows, int columns, unsigned seed)
+{
+    auto generator = std::minstd_rand{seed};
+    auto distribution = std::uniform_real_distribution<T>{T{-1}, T{1}};
+    auto matrix = Matrix<T>{rows, columns, T{0}};
+    for (auto& element : matrix)
+    {
+        element = distribution(generator);
+    }
+    return matrix;
+}
+
+// Returns the square matrix with the column vector of values on its diagonal.
+inline Matrix<double> getDiagonalMatrix(const Matrix<double>& values)
+{
+    auto matrix = Matrix<double>{values.rowCount(), values.rowCount(), 0.0};
+    for (auto i = 0; i < values.rowCount(); ++i)
+    {
+        matrix(i, i) = values(i, 0);
+    }
+    return matrix;
+}
+
+inline bool isOrthonormal(const Matrix<double>& matrix, double epsilon = 1.0e-10)
+{
+    return close(Matrix<double>{transposedView(matrix)} * matrix, identity<double>(matrix.columnCount()), epsilon);
+}
+
+}
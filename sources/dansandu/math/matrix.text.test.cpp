@@ -0,0 +1,186 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+#include "dansandu/math/clustering.hpp"
+#include "dansandu/math/thread_pool.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using dansandu::math::clustering::kMeans;
+using dansandu::math::matrix::close;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::parseMatrixText;
+using dansandu::math::matrix::readMatrixText;
+using dansandu::math::matrix::TextFormat;
+using dansandu::math::matrix::textParallelThreshold;
+using dansandu::math::matrix::transposedView;
+using dansandu::math::matrix::writeMatrixText;
+using dansandu::math::thread_pool::Executor;
+using dansandu::math::thread_pool::ThreadPool;
+
+template<typename M>
+static std::string toText(const M& matrix, TextFormat format, const Executor& executor = Executor{})
+{
+    auto stream = std::ostringstream{};
+    writeMatrixText(stream, matrix, format, executor);
+    return stream.str();
+}
+
+static Matrix<double> getLargeMatrix()
+{
+    auto matrix = Matrix<double>{40000, 7, 0.0};
+    for (auto row = 0; row < matrix.rowCount(); ++row)
+    {
+        for (auto column = 0; column < matrix.columnCount(); ++column)
+        {
+            matrix(row, column) = row * 0.125 - column / 3.0;
+        }
+    }
+    return matrix;
+}
+
+TEST_CASE("matrix.text")
+{
+    const auto matrix = Matrix<double>{{{1.0, -2.5, 3.0}, {0.1, 5.0, 1.0e-20}}};
+
+    SECTION("parse")
+    {
+        REQUIRE(close(parseMatrixText<double>("1,-2.5,3\n0.1,5,1e-20\n", TextFormat::csv), matrix, 1.0e-12));
+
+        REQUIRE(close(parseMatrixText<double>("\n1, -2.5 ,+3\r\n\n0.1,5,1e-20", TextFormat::csv), matrix, 1.0e-12));
+
+        REQUIRE(close(parseMatrixText<double>("1\t-2.5\t3\n0.1\t5\t1e-20\n", TextFormat::tsv), matrix, 1.0e-12));
+
+        REQUIRE(close(parseMatrixText<double>("{{1, -2.5, 3},\n {0.1, 5, 1e-20}}", TextFormat::braces), matrix,
+                      1.0e-12));
+
+        REQUIRE(parseMatrixText<int>("{{1, 2}, {3, 4}}", TextFormat::braces) == Matrix<int>{{{1, 2}, {3, 4}}});
+
+        REQUIRE(parseMatrixText<float>("", TextFormat::csv).rowCount() == 0);
+
+        REQUIRE(parseMatrixText<float>("{}", TextFormat::braces).rowCount() == 0);
+    }
+
+    SECTION("invalid text")
+    {
+        REQUIRE_THROWS_AS(parseMatrixText<double>("1,2\n3\n", TextFormat::csv), std::out_of_range);
+
+        REQUIRE_THROWS_AS(parseMatrixText<double>("1,2\n3,4,5\n", TextFormat::csv), std::out_of_range);
+
+        REQUIRE_THROWS_AS(parseMatrixText<double>("1,x\n", TextFormat::csv), std::invalid_argument);
+
+        REQUIRE_THROWS_AS(parseMatrixText<double>("1,,2\n", TextFormat::csv), std::invalid_argument);
+
+        REQUIRE_THROWS_AS(parseMatrixText<double>("{1, 2}", TextFormat::braces), std::invalid_argument);
+
+        REQUIRE_THROWS_AS(parseMatrixText<double>("{{1, 2}", TextFormat::braces), std::invalid_argument);
+    }
+
+    SECTION("write")
+    {
+        REQUIRE(toText(matrix, TextFormat::csv) == "1,-2.5,3\n0.1,5,1e-20\n");
+
+        REQUIRE(toText(matrix, TextFormat::tsv) == "1\t-2.5\t3\n0.1\t5\t1e-20\n");
+
+        auto stream = std::ostringstream{};
+        stream << Matrix<int>{{{1, 2}, {3, 4}}};
+
+        REQUIRE(toText(Matrix<int>{{{1, 2}, {3, 4}}}, TextFormat::braces) == stream.str());
+
+        REQUIRE(toText(Matrix<int>{}, TextFormat::braces) == "{}");
+
+        REQUIRE(toText(transposedView(matrix), TextFormat::csv) == "1,0.1\n-2.5,5\n3,1e-20\n");
+    }
+
+    SECTION("round trip in parallel")
+    {
+        auto pool = ThreadPool{4};
+        const auto executor = Executor{pool, 4};
+        const auto large = getLargeMatrix();
+
+        for (const auto format : {TextFormat::csv, TextFormat::tsv, TextFormat::braces})
+        {
+            const auto text = toText(large, format, executor);
+
+            REQUIRE(text.size() > textParallelThreshold);
+
+            REQUIRE(text == toText(large, format, Executor::sequential()));
+
+            const auto parsed = parseMatrixText<double>(text, format, executor);
+
+            REQUIRE(parsed.rowCount() == large.rowCount());
+
+            REQUIRE(close(parsed, large, 1.0e-12));
+        }
+
+        auto text = toText(large, TextFormat::csv, executor);
+        text[text.find('\n', text.size() / 2) + 1] = 'x';
+
+        REQUIRE_THROWS_AS(parseMatrixText<double>(text, TextFormat::csv, executor), std::invalid_argument);
+    }
+
+    SECTION("files and k-means")
+    {
+        const auto path = (std::filesystem::temp_directory_path() / "dansandu_math_matrix_text.test.csv").string();
+        const auto samples = Matrix<float>{
+            {{-5.0f, -5.0f}, {5.0f, 5.0f}, {-6.0f, -5.0f}, {6.0f, 5.0f}, {-5.0f, -6.0f}, {5.0f, 6.0f}}};
+
+        writeMatrixText(path, samples, TextFormat::csv);
+
+        const auto loaded = readMatrixText<float>(path, TextFormat::csv);
+
+        REQUIRE(close(loaded, samples, 1.0e-6f));
+
+        auto centroids = Matrix<float>{{{-1.0f, -1.0f}, {1.0f, 1.0f}}};
+
+        REQUIRE(kMeans(loaded, centroids, 3) == std::vector<int>{0, 1, 0, 1, 0, 1});
+
+        REQUIRE_THROWS_AS(readMatrixText<float>(path + ".missing", TextFormat::csv), std::runtime_error);
+
+        std::remove(path.c_str());
+    }
+}
+
+// Compares parsing a large csv text with from_chars on all threads against reading it element by element through a
+// stream. Run explicitly with the [benchmark] tag.
+TEST_CASE("matrix.text.benchmark", "[.][benchmark]")
+{
+    auto matrix = Matrix<double>{1000000, 8, 0.0};
+    for (auto row = 0; row < matrix.rowCount(); ++row)
+    {
+        for (auto column = 0; column < matrix.columnCount(); ++column)
+        {
+            matrix(row, column) = row / 7.0 + column;
+        }
+    }
+    const auto text = toText(matrix, TextFormat::csv);
+
+    auto start = std::chrono::steady_clock::now();
+    auto stream = std::istringstream{text};
+    auto streamed = Matrix<double>{matrix.rowCount(), matrix.columnCount(), 0.0};
+    auto separator = ',';
+    for (auto row = 0; row < streamed.rowCount(); ++row)
+    {
+        for (auto column = 0; column < streamed.columnCount(); ++column)
+        {
+            stream >> streamed(row, column);
+            stream.get(separator);
+        }
+    }
+    const auto streamSeconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+
+    start = std::chrono::steady_clock::now();
+    const auto parsed = parseMatrixText<double>(text, TextFormat::csv);
+    const auto parseSeconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+
+    REQUIRE(close(parsed, streamed, 1.0e-9));
+
+    std::cout << text.size() / (1 << 20) << " MiB of csv: stream " << streamSeconds << " s, parseMatrixText "
+              << parseSeconds << " s\n";
+}
@@ -1,8 +1,53 @@
 #include "dansandu/math/matrix.hpp"
 #include "catchorg/catch/catch.hpp"
 
+#include <iterator>
+#include <stdexcept>
+
+using dansandu::math::matrix::ConstantMatrixView;
+using dansandu::math::matrix::dynamic;
+using dansandu::math::matrix::gemm;
 using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::MatrixView;
+using dansandu::math::matrix::Slicer;
+using dansandu::math::matrix::Transposition;
 using dansandu::math::matrix::transposed;
+using dansandu::math::matrix::transposedView;
+using dansandu::math::matrix::transposeInPlace;
+
+template<typename T>
+static Matrix<T> generate(int rows, int columns)
+{
+    auto result = Matrix<T>{rows, columns};
+    for (auto i = 0; i < rows; ++i)
+    {
+        for (auto j = 0; j < columns; ++j)
+        {
+            result(i, j) = static_cast<T>(i * columns + j);
+        }
+    }
+    return result;
+}
+
+template<typename T, typename M>
+static bool isTransposeOf(const M& transpose, const Matrix<T>& matrix)
+{
+    if (transpose.rowCount() != matrix.columnCount() || transpose.columnCount() != matrix.rowCount())
+    {
+        return false;
+    }
+    for (auto i = 0; i < matrix.rowCount(); ++i)
+    {
+        for (auto j = 0; j < matrix.columnCount(); ++j)
+        {
+            if (transpose(j, i) != matrix(i, j))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
 
 TEST_CASE("matrix.transpose")
 {
@@ -38,4 +83,165 @@ TEST_CASE("matrix.transpose")
 
         REQUIRE(actual == expected);
     }
+
+    SECTION("view")
+    {
+        auto matrix = Matrix<int>{{{1, 2, 3}, {4, 5, 6}}};
+
+        const auto view = transposedView(matrix);
+
+        REQUIRE(view == Matrix<int>{{{1, 4}, {2, 5}, {3, 6}}});
+
+        REQUIRE(std::distance(view.cbegin(), view.cend()) == 6);
+
+        REQUIRE(view != Matrix<int>{{{1, 4}, {2, 5}, {3, 7}}});
+
+        REQUIRE(view.data() == matrix.data());
+
+        view(2, 0) = 10;
+
+        REQUIRE(matrix == Matrix<int>{{{1, 2, 10}, {4, 5, 6}}});
+
+        REQUIRE(transposedView(view) == matrix);
+
+        REQUIRE(transposed(view) == matrix);
+
+        const auto& constant = matrix;
+
+        const auto constantView = ConstantMatrixView<int, 3, 2>{transposedView(constant)};
+
+        REQUIRE(constantView == view);
+    }
+
+    SECTION("view slicing")
+    {
+        auto matrix = Matrix<int>{{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}}};
+
+        const auto view = transposedView(matrix);
+
+        REQUIRE(Slicer<1, 1, 2, 2>::slice(view) == Matrix<int>{{{6, 10}, {7, 11}}});
+
+        REQUIRE(sliceRow(view, 3) == Matrix<int>{{{4, 8, 12}}});
+
+        REQUIRE(sliceColumn(view, 0) == Matrix<int>{{1, 2, 3, 4}});
+    }
+
+    SECTION("view arithmetic")
+    {
+        auto matrix = Matrix<int>{{{1, 2}, {3, 4}}};
+        const auto other = Matrix<int>{{{1, 1}, {2, 2}}};
+
+        const auto view = transposedView(matrix);
+
+        REQUIRE(view + other == Matrix<int>{{{2, 4}, {4, 6}}});
+
+        REQUIRE(view * other == Matrix<int>{{{7, 7}, {10, 10}}});
+
+        REQUIRE(other * view == Matrix<int>{{{3, 7}, {6, 14}}});
+
+        view += other;
+
+        REQUIRE(matrix == Matrix<int>{{{2, 4}, {4, 6}}});
+
+        view.deepCopy(other * 2);
+
+        REQUIRE(matrix == Matrix<int>{{{2, 4}, {2, 4}}});
+    }
+
+    SECTION("view as gemm output")
+    {
+        const auto a = Matrix<double>{{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}}};
+        const auto b = Matrix<double>{{{1.0, 0.0}, {0.0, 1.0}, {1.0, 1.0}}};
+        auto c = Matrix<double>{2, 2};
+
+        gemm(1.0, a, Transposition::none, b, Transposition::none, 0.0, transposedView(c));
+
+        REQUIRE(close(c, Matrix<double>{{{4.0, 10.0}, {5.0, 11.0}}}, 1.0e-12));
+
+        gemm(1.0, transposedView(b), Transposition::none, transposedView(a), Transposition::none, 1.0,
+             MatrixView<double>{c});
+
+        REQUIRE(close(c, Matrix<double>{{{8.0, 20.0}, {10.0, 22.0}}}, 1.0e-12));
+    }
+
+    SECTION("tiled")
+    {
+        for (const auto& [rows, columns] : {std::pair{1, 1}, {3, 70}, {8, 8}, {33, 65}, {100, 37}, {128, 128}})
+        {
+            const auto floats = generate<float>(rows, columns);
+            const auto doubles = generate<double>(rows, columns);
+            const auto integers = generate<int>(rows, columns);
+
+            REQUIRE(isTransposeOf(transposed(floats), floats));
+
+            REQUIRE(isTransposeOf(transposed(doubles), doubles));
+
+            REQUIRE(isTransposeOf(transposed(integers), integers));
+
+            REQUIRE(transposed(transposedView(integers)) == integers);
+        }
+
+        const auto matrix = generate<double>(50, 60);
+        const auto slice = ConstantMatrixView<double>{Slicer<3, 5, 40, 41>::slice(matrix)};
+
+        REQUIRE(isTransposeOf(transposed(slice), Matrix<double>{slice}));
+    }
+
+    SECTION("square in place")
+    {
+        for (const auto size : {1, 2, 7, 8, 33, 70})
+        {
+            const auto original = generate<double>(size, size);
+            auto matrix = original;
+
+            transposeInPlace(matrix);
+
+            REQUIRE(isTransposeOf(matrix, original));
+
+            auto integers = generate<int>(size, size);
+
+            transposeInPlace(transposedView(integers));
+
+            REQUIRE(integers == transposed(generate<int>(size, size)));
+        }
+
+        auto matrix = generate<float>(40, 50);
+        const auto original = Matrix<float>{Slicer<2, 3, 35, 35>::slice(matrix)};
+
+        transposeInPlace(Slicer<2, 3, 35, 35>::slice(matrix));
+
+        REQUIRE(isTransposeOf(Matrix<float>{Slicer<2, 3, 35, 35>::slice(matrix)}, original));
+
+        REQUIRE(matrix(0, 0) == 0.0f);
+
+        auto small = Matrix<int, 2, 2>{{{1, 2}, {3, 4}}};
+
+        transposeInPlace(small);
+
+        REQUIRE(small == Matrix<int>{{{1, 3}, {2, 4}}});
+    }
+
+    SECTION("rectangular in place")
+    {
+        for (const auto& [rows, columns] : {std::pair{1, 5}, {2, 3}, {7, 13}, {64, 3}, {37, 100}})
+        {
+            const auto original = generate<int>(rows, columns);
+            auto matrix = original;
+            const auto storage = matrix.data();
+
+            transposeInPlace(matrix);
+
+            REQUIRE(isTransposeOf(matrix, original));
+
+            REQUIRE(matrix.data() == storage);
+        }
+
+        auto matrix = Matrix<int, dynamic, 3>{{{1, 2, 3}, {4, 5, 6}}};
+
+        REQUIRE_THROWS_AS(transposeInPlace(matrix), std::logic_error);
+
+        auto other = generate<int>(3, 4);
+
+        REQUIRE_THROWS_AS(transposeInPlace(Slicer<0, 0>::slice(other, 2, 3)), std::logic_error);
+    }
 }
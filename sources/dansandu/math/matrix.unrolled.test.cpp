@@ -0,0 +1,81 @@
+#include "dansandu/math/matrix.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <stdexcept>
+
+using dansandu::math::matrix::close;
+using dansandu::math::matrix::ConstantMatrixView;
+using dansandu::math::matrix::crossProduct;
+using dansandu::math::matrix::determinant;
+using dansandu::math::matrix::identity;
+using dansandu::math::matrix::inverse;
+using dansandu::math::matrix::Matrix;
+using dansandu::math::matrix::Slicer;
+using dansandu::math::matrix::transposed;
+
+TEST_CASE("matrix.unrolled")
+{
+    SECTION("compile time evaluation")
+    {
+        constexpr auto a = Matrix<double, 2, 2>{{{1.0, 2.0}, {3.0, 4.0}}};
+        constexpr auto product = a * a;
+        constexpr auto transpose = transposed(a);
+        constexpr auto inversion = inverse(a);
+        constexpr auto u = Matrix<int, 3, 1>{{1, 0, 0}};
+        constexpr auto v = Matrix<int, 3, 1>{{0, 1, 0}};
+        constexpr auto w = crossProduct(u, v);
+
+        static_assert(product.unsafeSubscript(0, 0) == 7.0 && product.unsafeSubscript(1, 1) == 22.0);
+
+        static_assert(transpose.unsafeSubscript(0, 1) == 3.0 && transpose.unsafeSubscript(1, 0) == 2.0);
+
+        static_assert(determinant(a) == -2.0);
+
+        static_assert(inversion.unsafeSubscript(0, 0) == -2.0 && inversion.unsafeSubscript(1, 0) == 1.5);
+
+        static_assert(w.unsafeSubscript(0) == 0 && w.unsafeSubscript(1) == 0 && w.unsafeSubscript(2) == 1);
+
+        REQUIRE(close(product, Matrix<double, 2, 2>{{{7.0, 10.0}, {15.0, 22.0}}}, 1.0e-12));
+    }
+
+    SECTION("multiplication")
+    {
+        const auto a = Matrix<int, 3, 4>{{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}}};
+        const auto b = Matrix<int, 4, 2>{{{1, -1}, {2, -2}, {3, -3}, {4, -4}}};
+
+        REQUIRE(a * b == Matrix<int>{{{30, -30}, {70, -70}, {110, -110}}});
+
+        REQUIRE(transposed(a) == Matrix<int>{{{1, 5, 9}, {2, 6, 10}, {3, 7, 11}, {4, 8, 12}}});
+    }
+
+    SECTION("determinant")
+    {
+        REQUIRE(determinant(Matrix<int, 1, 1>{{7}}) == 7);
+
+        REQUIRE(determinant(Matrix<int, 3, 3>{{{2, -3, 1}, {2, 0, -1}, {1, 4, 5}}}) == 49);
+
+        REQUIRE(determinant(Matrix<int, 4, 4>{{{1, 0, 2, -1}, {3, 0, 0, 5}, {2, 1, 4, -3}, {1, 0, 5, 0}}}) == 30);
+
+        const auto matrix = Matrix<int, 4, 4>{{{1, 2, 3, 4}, {2, 4, 6, 8}, {1, 1, 1, -1}, {1, 0, -2, -6}}};
+
+        REQUIRE(determinant(matrix) == 0);
+
+        const auto view = ConstantMatrixView<int, 3, 3>{Slicer<1, 1, 3, 3>::slice(matrix)};
+
+        REQUIRE(determinant(view) == -12);
+    }
+
+    SECTION("inverse")
+    {
+        const auto a = Matrix<double, 3, 3>{{{2.0, -3.0, 1.0}, {2.0, 0.0, -1.0}, {1.0, 4.0, 5.0}}};
+        const auto b =
+            Matrix<float, 4, 4>{{{1.0f, 0.0f, 2.0f, -1.0f}, {3.0f, 0.0f, 0.0f, 5.0f}, {2.0f, 1.0f, 4.0f, -3.0f},
+                                 {1.0f, 0.0f, 5.0f, 0.0f}}};
+
+        REQUIRE(close(a * inverse(a), identity<double, 3>(), 1.0e-12));
+
+        REQUIRE(close(inverse(b) * b, identity<float, 4>(), 1.0e-5f));
+
+        REQUIRE_THROWS_AS(inverse(Matrix<double, 2, 2>{{{1.0, 2.0}, {2.0, 4.0}}}), std::logic_error);
+    }
+}
@@ -0,0 +1,268 @@
+#include "dansandu/math/thread_pool.hpp"
+#include "dansandu/ballotin/environment.hpp"
+#include "dansandu/ballotin/exception.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using dansandu::ballotin::environment::getEnvironmentVariable;
+
+namespace dansandu::math::thread_pool
+{
+
+static thread_local auto insideParallelFor = false;
+
+// Each participant owns a contiguous range of task indices packed as [begin, end) in a single atomic word. The owner
+// takes tasks from the front while thieves take them from the back.
+struct alignas(64) TaskRange
+{
+    static constexpr std::uint64_t pack(std::uint32_t begin, std::uint32_t end)
+    {
+        return static_cast<std::uint64_t>(end) << 32 | begin;
+    }
+
+    int popFront()
+    {
+        auto current = bounds.load(std::memory_order_relaxed);
+        while (true)
+        {
+            const auto begin = static_cast<std::uint32_t>(current);
+            const auto end = static_cast<std::uint32_t>(current >> 32);
+            if (begin >= end)
+            {
+                return -1;
+            }
+            if (bounds.compare_exchange_weak(current, pack(begin + 1, end), std::memory_order_acq_rel))
+            {
+                return static_cast<int>(begin);
+            }
+        }
+    }
+
+    int popBack()
+    {
+        auto current = bounds.load(std::memory_order_relaxed);
+        while (true)
+        {
+            const auto begin = static_cast<std::uint32_t>(current);
+            const auto end = static_cast<std::uint32_t>(current >> 32);
+            if (begin >= end)
+            {
+                return -1;
+            }
+            if (bounds.compare_exchange_weak(current, pack(begin, end - 1), std::memory_order_acq_rel))
+            {
+                return static_cast<int>(end - 1);
+            }
+        }
+    }
+
+    std::atomic<std::uint64_t> bounds;
+};
+
+struct ThreadPool::Job
+{
+    Job(int tasks, int participants, const std::function<void(int)>& function)
+        : task{function}, ranges(participants), failed{false}
+    {
+        for (auto slot = 0; slot < participants; ++slot)
+        {
+            const auto begin = static_cast<std::uint32_t>(static_cast<long long>(tasks) * slot / participants);
+            const auto end = static_cast<std::uint32_t>(static_cast<long long>(tasks) * (slot + 1) / participants);
+            ranges[slot].bounds.store(TaskRange::pack(begin, end), std::memory_order_relaxed);
+        }
+    }
+
+    void run(int slot)
+    {
+        insideParallelFor = true;
+        const auto participants = static_cast<int>(ranges.size());
+        for (auto victim = 0; victim < participants; ++victim)
+        {
+            auto& range = ranges[(slot + victim) % participants];
+            const auto pop = [&range, victim]() { return victim == 0 ? range.popFront() : range.popBack(); };
+            for (auto index = pop(); index >= 0; index = pop())
+            {
+                execute(index);
+            }
+        }
+        insideParallelFor = false;
+    }
+
+    void execute(int index)
+    {
+        if (failed.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        try
+        {
+            task(index);
+        }
+        catch (...)
+        {
+            if (!failed.exchange(true))
+            {
+                exception = std::current_exception();
+            }
+        }
+    }
+
+    const std::function<void(int)>& task;
+    std::vector<TaskRange> ranges;
+    std::atomic<bool> failed;
+    std::exception_ptr exception;
+};
+
+ThreadPool& ThreadPool::globalInstance()
+{
+    static auto threadPool = []()
+    {
+        const auto variable = getEnvironmentVariable("DANSANDU_MATH_THREADS");
+        if (variable.has_value())
+        {
+            auto threads = 0;
+            auto parsed = std::size_t{0};
+            try
+            {
+                threads = std::stoi(variable.value(), &parsed);
+            }
+            catch (const std::exception&)
+            {
+                parsed = 0;
+            }
+            if (parsed == 0 || parsed != variable.value().size() || threads < 1)
+            {
+                THROW(std::invalid_argument, "invalid DANSANDU_MATH_THREADS value '", variable.value(),
+                      "' -- expected a positive thread count");
+            }
+            return std::make_unique<ThreadPool>(threads);
+        }
+        return std::make_unique<ThreadPool>(std::max(static_cast<int>(std::thread::hardware_concurrency()), 1));
+    }();
+    return *threadPool;
+}
+
+ThreadPool::ThreadPool(int threads)
+    : job_{nullptr}, participants_{0}, pendingParticipants_{0}, generation_{0}, stopping_{false}
+{
+    if (threads < 1)
+    {
+        THROW(std::invalid_argument, "invalid thread count ", threads, " -- thread pool must have at least one thread");
+    }
+
+    workers_.reserve(threads - 1);
+    for (auto slot = 1; slot < threads; ++slot)
+    {
+        workers_.emplace_back([this, slot]() { work(slot); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        auto lock = std::lock_guard<std::mutex>{mutex_};
+        stopping_ = true;
+    }
+    wakeUp_.notify_all();
+    for (auto& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::work(int slot)
+{
+    auto seenGeneration = std::uint64_t{0};
+    while (true)
+    {
+        auto lock = std::unique_lock<std::mutex>{mutex_};
+        wakeUp_.wait(lock, [&]() { return stopping_ || generation_ != seenGeneration; });
+        if (stopping_)
+        {
+            return;
+        }
+        seenGeneration = generation_;
+        if (slot >= participants_)
+        {
+            continue;
+        }
+        const auto job = job_;
+        lock.unlock();
+
+        job->run(slot);
+
+        lock.lock();
+        if (--pendingParticipants_ == 0)
+        {
+            finished_.notify_one();
+        }
+    }
+}
+
+void ThreadPool::parallelFor(int tasks, int threads, const std::function<void(int)>& task)
+{
+    const auto participants = std::min({threads, threadCount(), tasks});
+    auto submissionLock = std::unique_lock<std::mutex>{submission_, std::defer_lock};
+    if (participants <= 1 || insideParallelFor || !submissionLock.try_lock())
+    {
+        for (auto index = 0; index < tasks; ++index)
+        {
+            task(index);
+        }
+        return;
+    }
+
+    auto job = Job{tasks, participants, task};
+    {
+        auto lock = std::lock_guard<std::mutex>{mutex_};
+        job_ = &job;
+        participants_ = participants;
+        pendingParticipants_ = participants - 1;
+        ++generation_;
+    }
+    wakeUp_.notify_all();
+
+    job.run(0);
+
+    {
+        auto lock = std::unique_lock<std::mutex>{mutex_};
+        finished_.wait(lock, [this]() { return pendingParticipants_ == 0; });
+        job_ = nullptr;
+        participants_ = 0;
+    }
+
+    if (job.exception)
+    {
+        std::rethrow_exception(job.exception);
+    }
+}
+
+Executor::Executor() : Executor{ThreadPool::globalInstance(), ThreadPool::globalInstance().threadCount()}
+{
+}
+
+Executor::Executor(int threads) : Executor{ThreadPool::globalInstance(), threads}
+{
+}
+
+Executor::Executor(ThreadPool& threadPool, int threads) : threadPool_{&threadPool}, threads_{threads}
+{
+    if (threads < 1)
+    {
+        THROW(std::invalid_argument, "invalid thread count ", threads, " -- executor must use at least one thread");
+    }
+}
+
+void Executor::parallelFor(int tasks, const std::function<void(int)>& task) const
+{
+    threadPool_->parallelFor(tasks, threads_, task);
+}
+
+}
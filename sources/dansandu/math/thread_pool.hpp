@@ -0,0 +1,83 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dansandu::math::thread_pool
+{
+
+class PRALINE_EXPORT ThreadPool
+{
+public:
+    // The global pool is sized by the DANSANDU_MATH_THREADS environment variable and defaults to the number of
+    // hardware threads. The variable must be a positive integer with nothing after it, otherwise this throws.
+    static ThreadPool& globalInstance();
+
+    explicit ThreadPool(int threads);
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool();
+
+    int threadCount() const
+    {
+        return static_cast<int>(workers_.size()) + 1;
+    }
+
+    // Runs task(index) for every index in [0, tasks) on at most the given number of threads, the calling thread
+    // included, and returns once all tasks are done. Idle threads steal tasks from busy ones. Calls made from inside
+    // a task, or while the pool is busy with another caller, run on the calling thread.
+    void parallelFor(int tasks, int threads, const std::function<void(int)>& task);
+
+private:
+    struct Job;
+
+    void work(int slot);
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::condition_variable finished_;
+    std::mutex submission_;
+    Job* job_;
+    int participants_;
+    int pendingParticipants_;
+    std::uint64_t generation_;
+    bool stopping_;
+};
+
+class PRALINE_EXPORT Executor
+{
+public:
+    // Uses all the threads of the global pool.
+    Executor();
+
+    // Uses at most the given number of threads of the global pool.
+    explicit Executor(int threads);
+
+    Executor(ThreadPool& threadPool, int threads);
+
+    static Executor sequential()
+    {
+        return Executor{1};
+    }
+
+    int threadCount() const
+    {
+        return threads_;
+    }
+
+    void parallelFor(int tasks, const std::function<void(int)>& task) const;
+
+private:
+    ThreadPool* threadPool_;
+    int threads_;
+};
+
+}
@@ -0,0 +1,63 @@
+#include "dansandu/math/thread_pool.hpp"
+#include "catchorg/catch/catch.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using dansandu::math::thread_pool::Executor;
+using dansandu::math::thread_pool::ThreadPool;
+
+TEST_CASE("thread_pool")
+{
+    auto threadPool = ThreadPool{4};
+
+    REQUIRE(threadPool.threadCount() == 4);
+
+    SECTION("every task runs exactly once")
+    {
+        for (const auto threads : {1, 2, 4, 8})
+        {
+            auto counts = std::vector<std::atomic<int>>(1000);
+            threadPool.parallelFor(static_cast<int>(counts.size()), threads, [&](int index) { ++counts[index]; });
+
+            for (const auto& count : counts)
+            {
+                REQUIRE(count.load() == 1);
+            }
+        }
+    }
+
+    SECTION("nested calls run on the calling thread")
+    {
+        auto sum = std::atomic<int>{0};
+        threadPool.parallelFor(8, 4, [&](int) { threadPool.parallelFor(10, 4, [&](int index) { sum += index; }); });
+
+        REQUIRE(sum.load() == 8 * 45);
+    }
+
+    SECTION("exceptions are rethrown on the calling thread")
+    {
+        REQUIRE_THROWS_AS(threadPool.parallelFor(100, 4,
+                                                 [](int index)
+                                                 {
+                                                     if (index == 42)
+                                                     {
+                                                         throw std::runtime_error{"task failed"};
+                                                     }
+                                                 }),
+                          std::runtime_error);
+    }
+
+    SECTION("executor")
+    {
+        auto count = std::atomic<int>{0};
+        Executor{threadPool, 3}.parallelFor(50, [&](int) { ++count; });
+
+        REQUIRE(count.load() == 50);
+
+        REQUIRE(Executor::sequential().threadCount() == 1);
+
+        REQUIRE_THROWS_AS(Executor{0}, std::invalid_argument);
+    }
+}